@@ -0,0 +1,198 @@
+//编译速度基准：生成不同形状、不同规模的 SysY 程序，分别用 -koopa 和 -riscv 编译
+//报告每秒处理的源码行数和编译器进程的峰值内存，规模翻倍时耗时增长明显超过两倍的就是超线性的地方
+//用法：bench <compiler> <工作目录> [规模倍数]
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+using namespace std;
+
+//深层嵌套的 if/while，每层声明一个新的局部变量
+static string GenNest(int n){
+    ostringstream os;
+    os << "int main() {\n    int x0 = 0;\n";
+    for(int i = 1; i <= n; i++){
+        string ind(4 * i, ' ');
+        if(i % 2){
+            os << ind << "if (x" << i - 1 << " < " << i + 1 << ") {\n";
+        }else{
+            os << ind << "while (x" << i - 1 << " < " << i + 1 << ") {\n";
+        }
+        os << ind << "    int x" << i << " = x" << i - 1 << " + 1;\n";
+    }
+    for(int i = n; i >= 1; i--){
+        string ind(4 * i, ' ');
+        if(i % 2 == 0) os << ind << "    x" << i - 1 << " = x" << i - 1 << " + " << n << ";\n";
+        os << ind << "}\n";
+    }
+    os << "    return x0;\n}\n";
+    return os.str();
+}
+
+//大量小函数，每个调用前一个
+static string GenFuncs(int n){
+    ostringstream os;
+    os << "int f0(int a, int b) {\n    return a + b;\n}\n";
+    for(int i = 1; i < n; i++){
+        os << "int f" << i << "(int a, int b) {\n";
+        os << "    int t = a * " << i % 7 + 1 << " - b;\n";
+        os << "    if (t > " << i << ") return f" << i - 1 << "(b, t % 100);\n";
+        os << "    return t + f" << i - 1 << "(a, b) / 3;\n}\n";
+    }
+    os << "int main() {\n    return f" << n - 1 << "(1, 2) % 256;\n}\n";
+    return os.str();
+}
+
+//很多带初始化列表的大全局数组
+static string GenGlobals(int n){
+    ostringstream os;
+    for(int i = 0; i < n; i++){
+        os << "int g" << i << "[4096] = {";
+        for(int j = 0; j < 64; j++){
+            os << (j ? ", " : "") << (i * 64 + j) % 1000;
+        }
+        os << "};\n";
+    }
+    os << "int main() {\n    int s = 0;\n";
+    for(int i = 0; i < n; i++){
+        os << "    s = s + g" << i << "[" << i % 64 << "] + g" << i << "[4095];\n";
+    }
+    os << "    return s % 256;\n}\n";
+    return os.str();
+}
+
+//很长的表达式链
+static string GenExpr(int n){
+    ostringstream os;
+    os << "int main() {\n    int a = getint(), b = getint(), c = 3;\n    int r = a";
+    const char *ops[] = {" + ", " - ", " * ", " / ", " % "};
+    for(int i = 1; i < n; i++){
+        os << ops[i % 5];
+        if(i % 5 >= 3){
+            os << (i % 13 + 1);
+        }else{
+            os << "(" << (i % 3 == 0 ? "a" : i % 3 == 1 ? "b" : "c") << " * " << i % 17 << ")";
+        }
+        if(i % 8 == 0) os << "\n        ";
+    }
+    os << ";\n    return r % 256;\n}\n";
+    return os.str();
+}
+
+//一个函数里大量局部变量
+static string GenLocals(int n){
+    ostringstream os;
+    os << "int main() {\n    int v0 = getint();\n";
+    for(int i = 1; i < n; i++){
+        os << "    int v" << i << " = v" << i - 1 << " * 3 + " << i % 11;
+        if(i >= 3) os << " - v" << i / 3;
+        os << ";\n";
+    }
+    os << "    int s = 0;\n";
+    for(int i = 0; i < n; i += 7){
+        os << "    s = s + v" << i << ";\n";
+    }
+    os << "    return s % 256;\n}\n";
+    return os.str();
+}
+
+struct RunResult {
+    bool ok;
+    double wall_ms;
+    long peak_kb;
+};
+
+//子进程里运行编译器，标准输出丢掉；用 wait4 拿到子进程自己的峰值 RSS
+static RunResult RunCompiler(const string &compiler, const string &mode, const string &src, const string &out){
+    struct timeval begin, end;
+    gettimeofday(&begin, nullptr);
+    pid_t pid = fork();
+    if(pid == 0){
+        int devnull = open("/dev/null", O_WRONLY);
+        dup2(devnull, 1);
+        dup2(devnull, 2);
+        execl(compiler.c_str(), compiler.c_str(), mode.c_str(), src.c_str(), "-o", out.c_str(), (char *)nullptr);
+        _exit(127);
+    }
+    int status = 0;
+    struct rusage usage;
+    if(pid < 0 || wait4(pid, &status, 0, &usage) < 0){
+        return {false, 0, 0};
+    }
+    gettimeofday(&end, nullptr);
+    double ms = (end.tv_sec - begin.tv_sec) * 1000.0 + (end.tv_usec - begin.tv_usec) / 1000.0;
+    return {WIFEXITED(status) && WEXITSTATUS(status) == 0, ms, usage.ru_maxrss};
+}
+
+static int CountLines(const string &text){
+    int lines = 0;
+    for(char c : text){
+        if(c == '\n') lines++;
+    }
+    return lines;
+}
+
+int main(int argc, char *argv[]){
+    if(argc < 3){
+        cerr << "用法：" << argv[0] << " <compiler> <工作目录> [规模倍数]" << endl;
+        return 1;
+    }
+    string compiler = argv[1];
+    string dir = argv[2];
+    int scale = argc > 3 ? atoi(argv[3]) : 1;
+    if(scale < 1){
+        cerr << "错误：规模倍数必须是正整数" << endl;
+        return 1;
+    }
+
+    struct Generator {
+        const char *name;
+        function<string(int)> gen;
+        int base;   //最小规模，之后依次翻倍
+    };
+    vector<Generator> gens = {
+        {"nest", GenNest, 100},
+        {"funcs", GenFuncs, 500},
+        {"globals", GenGlobals, 50},
+        {"expr", GenExpr, 1000},
+        {"locals", GenLocals, 1000},
+    };
+    const int kSteps = 3;
+
+    printf("%-8s %8s %-6s %8s %10s %12s %10s %7s\n", "case", "size", "mode", "lines", "time(ms)", "lines/s", "peak(KB)", "growth");
+    bool all_ok = true;
+    for(const auto &g : gens){
+        for(const char *mode : {"-koopa", "-riscv"}){
+            double last_ms = 0;
+            for(int step = 0; step < kSteps; step++){
+                int size = g.base * scale << step;
+                string text = g.gen(size);
+                string src = dir + "/" + g.name + "_" + to_string(size) + ".c";
+                ofstream(src) << text;
+                string out = src + (mode[1] == 'k' ? ".koopa" : ".s");
+                RunResult res = RunCompiler(compiler, mode, src, out);
+                int lines = CountLines(text);
+                if(!res.ok){
+                    printf("%-8s %8d %-6s %8d %10s\n", g.name, size, mode + 1, lines, "FAILED");
+                    all_ok = false;
+                    break;
+                }
+                //规模翻倍后耗时的倍数，线性时约为 2
+                string growth = step == 0 || last_ms <= 0 ? "-" : to_string(res.wall_ms / last_ms).substr(0, 4);
+                printf("%-8s %8d %-6s %8d %10.1f %12.0f %10ld %7s\n", g.name, size, mode + 1, lines,
+                       res.wall_ms, lines / (res.wall_ms / 1000.0), res.peak_kb, growth.c_str());
+                last_ms = res.wall_ms;
+            }
+        }
+    }
+    return all_ok ? 0 : 1;
+}
@@ -0,0 +1,14 @@
+int g[10] = {5, 4, 3};
+const int c[5] = {1, 2, 3, 4, 5};
+int z[20];
+int main() {
+    int a[10];
+    int i = 0;
+    while (i < 10) { a[i] = i * i; i = i + 1; }
+    int s = 0;
+    i = 0;
+    while (i < 10) { s = s + a[i] * g[i % 3] + c[i % 5] + z[i]; z[i] = s; i = i + 1; }
+    putint(s); putch(10);
+    putint(z[9]); putch(10);
+    return s % 256;
+}
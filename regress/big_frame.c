@@ -0,0 +1,9 @@
+int big[3000];
+int sum(int n) { int loc[1500]; int i = 0; while (i < n) { loc[i] = big[i] + i; i = i + 1; } int s = 0; i = 0; while (i < n) { s = s + loc[i]; i = i + 1; } return s; }
+int main() {
+    int a[1200];
+    int i = 0;
+    while (i < 1200) { a[i] = i; big[i * 2] = i; i = i + 1; }
+    putint(sum(1500) + a[1199] + big[2998]); putch(10);
+    return 0;
+}
@@ -0,0 +1,14 @@
+int g = 0;
+int f(int x) { g = g + 1; return x; }
+int main() {
+    int i = 0, c = 0;
+    while (i < 20 && (f(i) < 15 || !f(0))) {
+        if (!(i % 2) || f(i) > 7 && f(1)) c = c + i;
+        if (-i) c = c + 1;
+        if (!!(i - 3)) ; else c = c + 100;
+        i = i + 1;
+    }
+    if (f(0) && f(1)) c = c + 1000;
+    putint(c); putch(10); putint(g); putch(10);
+    return c % 256;
+}
@@ -0,0 +1,13 @@
+const int N = 10, M = N * 2 + 1;
+int h[M];
+int main() {
+    const int L = 3;
+    int x = 1 + 2 * 3 - 4 / 2 + 5 % 3;
+    int y = (x + L) * (M - N);
+    h[L] = y;
+    if (1) x = x + 1;
+    if (0) x = x + 100;
+    while (0) { x = 0; }
+    putint(x); putch(32); putint(y); putch(32); putint(h[3] + h[4]); putch(10);
+    return x;
+}
@@ -0,0 +1,21 @@
+int g = 5;
+int main() {
+    int a = 3 * 4 + 0;
+    int b = a * 1 - 0;
+    int x = getint();
+    int y = x - x + x * 0 + (x == x) + (x != x);
+    int s = 0;
+    if (a == 12) s = s + 1; else s = s + 100;
+    if (b > 100) { s = s + 1000; putint(s); }
+    int i = 0; int k = 1;
+    while (i < 10) {
+        if (k == 1) s = s + i; else s = s - i;
+        k = 1;
+        i = i + 1;
+    }
+    while (0) { s = 99; }
+    if (1 && x) s = s + 7;
+    if (0 || x > 2) s = s + 11;
+    putint(s + y + g / 1 + (x % 1)); putch(10);
+    return s;
+}
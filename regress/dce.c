@@ -0,0 +1,16 @@
+int g;
+int f(int x) { g = g + x; return x * 2; }
+int main() {
+    int unused[100];
+    int i = 0;
+    while (i < 100) { unused[i] = i * i; i = i + 1; }
+    int a = 5;
+    a * 3 + 7;
+    f(3);
+    int b = f(4) + 1;
+    int w[10];
+    w[2] = 7;
+    i = 0; int s = 0;
+    while (i < 10) { int t = i * 100; s = s + i; i = i + 1; if (s > 20) { return s + g + w[2]; } }
+    return 0;
+}
@@ -0,0 +1,40 @@
+int g[10];
+int f(int p0, int p1, int p2, int p3, int p4, int p5, int p6, int p7, int p8, int p9) {
+    g[0] = g[3] + 1;
+    g[1] = g[4] + 2;
+    g[2] = g[5] + 3;
+    g[3] = g[6] + 4;
+    g[4] = g[7] + 5;
+    g[5] = g[8] + 6;
+    g[6] = g[9] + 7;
+    g[7] = g[0] + 8;
+    g[8] = g[1] + 9;
+    g[9] = g[2] + 10;
+    g[0] = g[3] + 11;
+    g[1] = g[4] + 12;
+    g[2] = g[5] + 13;
+    g[3] = g[6] + 14;
+    g[4] = g[7] + 15;
+    g[5] = g[8] + 16;
+    g[6] = g[9] + 17;
+    g[7] = g[0] + 18;
+    g[8] = g[1] + 19;
+    g[9] = g[2] + 20;
+    g[0] = g[3] + 21;
+    g[1] = g[4] + 22;
+    g[2] = g[5] + 23;
+    g[3] = g[6] + 24;
+    g[4] = g[7] + 25;
+    g[5] = g[8] + 26;
+    g[6] = g[9] + 27;
+    g[7] = g[0] + 28;
+    g[8] = g[1] + 29;
+    g[9] = g[2] + 30;
+    return g[0] + g[5] + p8 * 1000 + p0;
+}
+int main() {
+    int i = 0;
+    while (i < 10) { g[i] = i * 7; i = i + 1; }
+    putint(f(1, 2, 3, 4, 5, 6, 7, 8, 9, 123456)); putch(10);
+    return 0;
+}
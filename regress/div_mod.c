@@ -0,0 +1,9 @@
+int main() {
+    int a = -17; int b = 5;
+    putint(a / b); putch(32); putint(a % b); putch(32);
+    putint(17 / -5); putch(32); putint(17 % -5); putch(32);
+    putint(-a * -b); putch(32); putint(a - -b); putch(32);
+    putint(!a); putch(32); putint(!0); putch(32); putint(-(-a)); putch(10);
+    putint(a < b); putint(a > b); putint(a <= -17); putint(a >= -16); putint(a == -17); putint(a != -17); putch(10);
+    return 0;
+}
@@ -0,0 +1,2 @@
+int fib(int n) { if (n < 2) return n; return fib(n - 1) + fib(n - 2); }
+int main() { putint(fib(20)); putch(10); return fib(10); }
@@ -0,0 +1,26 @@
+int g = 5;
+int arr[10];
+void bump() { g = g + 1; arr[3] = arr[3] + g; }
+int f(int x, int y) { return (x + y) * (x + y) + (y + x) * 2 - x * y + y * x; }
+int main() {
+    int a[10];
+    int i = 0;
+    while (i < 10) { a[i] = i * i; arr[i] = 10 - i; i = i + 1; }
+    int s = 0;
+    i = 0;
+    while (i < 10) {
+        s = s + a[i] + a[i] * a[i];
+        a[i] = a[i] + 1;
+        s = s + a[i];
+        if (i % 2 == 0) { a[i] = 7; }
+        s = s + a[i] + arr[3];
+        bump();
+        s = s + arr[3] + g + g;
+        a[1] = 100; a[2] = 200;
+        s = s + a[1] + a[2];
+        i = i + 1;
+    }
+    s = s + f(3, 4) + f(g, s % 100);
+    putint(s); putch(10);
+    return s % 256;
+}
@@ -0,0 +1,20 @@
+int g;
+void bump(int d) { if (d < 0) return; g = g + d; }
+int arr[5] = {3, 1, 4, 1, 5};
+int sum3(int n) { int i = 0, s = 0; while (i < n) { s = s + arr[i]; i = i + 1; } return s; }
+int local_arr(int x) { int t[4] = {1, 2, 3, 4}; t[x % 4] = t[x % 4] + x; return t[0] + t[1] + t[2] + t[3]; }
+int even(int n) { if (n == 0) return 1; if (n == 1) return 0; return even(n - 2); }
+int odd(int n) { return 1 - even(n); }
+int sq(int x) { return x * x; }
+int quad(int x) { return sq(sq(x)); }
+int main() {
+    int i = 0, s = 0;
+    while (i < 50) {
+        bump(i - 10);
+        s = s + sum3(i % 6) + local_arr(i) + quad(i % 5);
+        i = i + 1;
+    }
+    s = s + even(7) * 100 + odd(7);
+    putint(s); putch(10); putint(g); putch(10);
+    return (s + g) % 256;
+}
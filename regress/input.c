@@ -0,0 +1,8 @@
+int main() {
+    int n = getint();
+    int s = 0; int i = 0;
+    while (i < n) { s = s + getint(); i = i + 1; }
+    int c = getch();
+    putint(s); putch(32); putint(c); putch(10);
+    return n;
+}
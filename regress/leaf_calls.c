@@ -0,0 +1,11 @@
+int add3(int a, int b, int c) { return a + b * c; }
+int pick(int a, int b, int c, int d) { if (a > b) return c - d; return d - c; }
+int swap2(int x, int y) { return pick(y, x, x + 1, y); }
+int early(int a, int b) { int t = a * b; putint(t); putch(32); return t + 1; }
+int main() {
+    int i = 0, s = 0;
+    while (i < 1000) { s = s + add3(i, s % 7, 3); s = s + swap2(i, s % 13); i = i + 1; }
+    s = s + early(3, 4);
+    putint(s); putch(10);
+    return s % 200;
+}
@@ -0,0 +1,31 @@
+int n = 12;
+int A[144];
+int B[144];
+int C[144];
+int k0 = 3;
+void touch() { k0 = k0 + 1; }
+void fillA(int v) { int i = 0; while (i < n) { int j = 0; while (j < n) { A[i * n + j] = (i * v + j) % 17; j = j + 1; } i = i + 1; } }
+void fillB(int v) { int i = 0; while (i < n) { int j = 0; while (j < n) { B[i * n + j] = (i * v + j) % 13; j = j + 1; } i = i + 1; } }
+int main() {
+    fillA(3); fillB(5);
+    int i = 0;
+    while (i < n) {
+        int j = 0;
+        while (j < n) {
+            int s = 0, k = 0;
+            while (k < n) { s = s + A[i * n + k] * B[k * n + j]; k = k + 1; }
+            C[i * n + j] = s + k0 * 2;
+            j = j + 1;
+        }
+        if (i % 4 == 0) touch();
+        i = i + 1;
+    }
+    int t = 0; i = 0;
+    while (i < n) { int j = 0; while (j < n) { t = t + C[i * n + j] * (j + 1); j = j + 1; } i = i + 1; }
+    int z[3] = {1, 2, 3}; int q = 0; i = 0;
+    while (i < 10) { q = q + z[1]; if (i == 5) z[1] = 7; i = i + 1; }
+    i = 0;
+    while (i < 10) { q = q + z[2] + k0; i = i + 1; }
+    putint(t); putch(10); putint(q); putch(10);
+    return t % 256;
+}
@@ -0,0 +1,12 @@
+int main() {
+    int i = 0; int s = 0;
+    while (i < 100) {
+        i = i + 1;
+        if (i % 3 == 0) continue;
+        if (i > 80) break;
+        int j = 0;
+        while (j < i) { if (j % 7 == 3) { s = s + j; } else s = s - 1; j = j + 1; }
+    }
+    putint(s); putch(10);
+    return 3;
+}
@@ -0,0 +1,8 @@
+int f(int a, int b, int c, int d, int e, int g, int h, int i, int j, int k) {
+    return a + 2*b + 3*c + 4*d + 5*e + 6*g + 7*h + 8*i + 9*j + 10*k;
+}
+int g2(int a, int b, int c, int d, int e, int g, int h, int i, int j, int k) {
+    int x = f(k, j, i, h, g, e, d, c, b, a);
+    return x - f(a, b, c, d, e, g, h, i, j, k) + a * k;
+}
+int main() { putint(f(1,2,3,4,5,6,7,8,9,10)); putch(32); putint(g2(1,2,3,4,5,6,7,8,9,10)); putch(10); return 0; }
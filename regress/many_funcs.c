@@ -0,0 +1,301 @@
+int f0(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 0; }
+int f1(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 1; }
+int f2(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 2; }
+int f3(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 3; }
+int f4(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 4; }
+int f5(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 5; }
+int f6(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 6; }
+int f7(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 7; }
+int f8(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 8; }
+int f9(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 9; }
+int f10(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 10; }
+int f11(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 11; }
+int f12(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 12; }
+int f13(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 13; }
+int f14(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 14; }
+int f15(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 15; }
+int f16(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 16; }
+int f17(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 17; }
+int f18(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 18; }
+int f19(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 19; }
+int f20(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 20; }
+int f21(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 21; }
+int f22(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 22; }
+int f23(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 23; }
+int f24(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 24; }
+int f25(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 25; }
+int f26(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 26; }
+int f27(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 27; }
+int f28(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 28; }
+int f29(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 29; }
+int f30(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 30; }
+int f31(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 31; }
+int f32(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 32; }
+int f33(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 33; }
+int f34(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 34; }
+int f35(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 35; }
+int f36(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 36; }
+int f37(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 37; }
+int f38(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 38; }
+int f39(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 39; }
+int f40(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 40; }
+int f41(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 41; }
+int f42(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 42; }
+int f43(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 43; }
+int f44(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 44; }
+int f45(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 45; }
+int f46(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 46; }
+int f47(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 47; }
+int f48(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 48; }
+int f49(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 49; }
+int f50(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 50; }
+int f51(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 51; }
+int f52(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 52; }
+int f53(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 53; }
+int f54(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 54; }
+int f55(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 55; }
+int f56(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 56; }
+int f57(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 57; }
+int f58(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 58; }
+int f59(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 59; }
+int f60(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 60; }
+int f61(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 61; }
+int f62(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 62; }
+int f63(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 63; }
+int f64(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 64; }
+int f65(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 65; }
+int f66(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 66; }
+int f67(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 67; }
+int f68(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 68; }
+int f69(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 69; }
+int f70(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 70; }
+int f71(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 71; }
+int f72(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 72; }
+int f73(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 73; }
+int f74(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 74; }
+int f75(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 75; }
+int f76(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 76; }
+int f77(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 77; }
+int f78(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 78; }
+int f79(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 79; }
+int f80(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 80; }
+int f81(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 81; }
+int f82(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 82; }
+int f83(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 83; }
+int f84(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 84; }
+int f85(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 85; }
+int f86(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 86; }
+int f87(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 87; }
+int f88(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 88; }
+int f89(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 89; }
+int f90(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 90; }
+int f91(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 91; }
+int f92(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 92; }
+int f93(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 93; }
+int f94(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 94; }
+int f95(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 95; }
+int f96(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 96; }
+int f97(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 97; }
+int f98(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 98; }
+int f99(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 99; }
+int f100(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 100; }
+int f101(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 101; }
+int f102(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 102; }
+int f103(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 103; }
+int f104(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 104; }
+int f105(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 105; }
+int f106(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 106; }
+int f107(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 107; }
+int f108(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 108; }
+int f109(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 109; }
+int f110(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 110; }
+int f111(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 111; }
+int f112(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 112; }
+int f113(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 113; }
+int f114(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 114; }
+int f115(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 115; }
+int f116(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 116; }
+int f117(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 117; }
+int f118(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 118; }
+int f119(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 119; }
+int f120(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 120; }
+int f121(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 121; }
+int f122(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 122; }
+int f123(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 123; }
+int f124(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 124; }
+int f125(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 125; }
+int f126(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 126; }
+int f127(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 127; }
+int f128(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 128; }
+int f129(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 129; }
+int f130(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 130; }
+int f131(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 131; }
+int f132(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 132; }
+int f133(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 133; }
+int f134(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 134; }
+int f135(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 135; }
+int f136(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 136; }
+int f137(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 137; }
+int f138(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 138; }
+int f139(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 139; }
+int f140(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 140; }
+int f141(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 141; }
+int f142(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 142; }
+int f143(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 143; }
+int f144(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 144; }
+int f145(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 145; }
+int f146(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 146; }
+int f147(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 147; }
+int f148(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 148; }
+int f149(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 149; }
+int f150(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 150; }
+int f151(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 151; }
+int f152(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 152; }
+int f153(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 153; }
+int f154(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 154; }
+int f155(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 155; }
+int f156(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 156; }
+int f157(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 157; }
+int f158(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 158; }
+int f159(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 159; }
+int f160(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 160; }
+int f161(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 161; }
+int f162(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 162; }
+int f163(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 163; }
+int f164(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 164; }
+int f165(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 165; }
+int f166(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 166; }
+int f167(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 167; }
+int f168(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 168; }
+int f169(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 169; }
+int f170(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 170; }
+int f171(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 171; }
+int f172(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 172; }
+int f173(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 173; }
+int f174(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 174; }
+int f175(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 175; }
+int f176(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 176; }
+int f177(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 177; }
+int f178(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 178; }
+int f179(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 179; }
+int f180(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 180; }
+int f181(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 181; }
+int f182(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 182; }
+int f183(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 183; }
+int f184(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 184; }
+int f185(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 185; }
+int f186(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 186; }
+int f187(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 187; }
+int f188(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 188; }
+int f189(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 189; }
+int f190(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 190; }
+int f191(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 191; }
+int f192(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 192; }
+int f193(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 193; }
+int f194(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 194; }
+int f195(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 195; }
+int f196(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 196; }
+int f197(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 197; }
+int f198(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 198; }
+int f199(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 199; }
+int f200(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 200; }
+int f201(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 201; }
+int f202(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 202; }
+int f203(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 203; }
+int f204(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 204; }
+int f205(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 205; }
+int f206(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 206; }
+int f207(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 207; }
+int f208(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 208; }
+int f209(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 209; }
+int f210(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 210; }
+int f211(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 211; }
+int f212(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 212; }
+int f213(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 213; }
+int f214(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 214; }
+int f215(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 215; }
+int f216(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 216; }
+int f217(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 217; }
+int f218(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 218; }
+int f219(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 219; }
+int f220(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 220; }
+int f221(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 221; }
+int f222(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 222; }
+int f223(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 223; }
+int f224(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 224; }
+int f225(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 225; }
+int f226(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 226; }
+int f227(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 227; }
+int f228(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 228; }
+int f229(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 229; }
+int f230(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 230; }
+int f231(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 231; }
+int f232(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 232; }
+int f233(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 233; }
+int f234(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 234; }
+int f235(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 235; }
+int f236(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 236; }
+int f237(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 237; }
+int f238(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 238; }
+int f239(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 239; }
+int f240(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 240; }
+int f241(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 241; }
+int f242(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 242; }
+int f243(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 243; }
+int f244(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 244; }
+int f245(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 245; }
+int f246(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 246; }
+int f247(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 247; }
+int f248(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 248; }
+int f249(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 249; }
+int f250(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 250; }
+int f251(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 251; }
+int f252(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 252; }
+int f253(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 253; }
+int f254(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 254; }
+int f255(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 255; }
+int f256(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 256; }
+int f257(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 257; }
+int f258(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 258; }
+int f259(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 259; }
+int f260(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 260; }
+int f261(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 261; }
+int f262(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 262; }
+int f263(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 263; }
+int f264(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 264; }
+int f265(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 265; }
+int f266(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 266; }
+int f267(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 267; }
+int f268(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 268; }
+int f269(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 269; }
+int f270(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 270; }
+int f271(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 271; }
+int f272(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 272; }
+int f273(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 273; }
+int f274(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 274; }
+int f275(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 275; }
+int f276(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 276; }
+int f277(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 277; }
+int f278(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 278; }
+int f279(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 279; }
+int f280(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 280; }
+int f281(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 281; }
+int f282(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 282; }
+int f283(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 283; }
+int f284(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 284; }
+int f285(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 285; }
+int f286(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 286; }
+int f287(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 287; }
+int f288(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 288; }
+int f289(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 289; }
+int f290(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 290; }
+int f291(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 291; }
+int f292(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 292; }
+int f293(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 293; }
+int f294(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 294; }
+int f295(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 295; }
+int f296(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 296; }
+int f297(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 0 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 297; }
+int f298(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 1 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 298; }
+int f299(int a, int b) { int s = 0; int i = 0; while (i < a) { if (i % 3 == 2 && b > 0 || i == 7) s = s + i * b; else s = s - 1; i = i + 1; } return s + 299; }
+int main() { int s = 0; s = s + f0(0, 0); s = s + f1(1, 1); s = s + f2(2, 2); s = s + f3(3, 3); s = s + f4(4, 4); s = s + f5(5, 0); s = s + f6(6, 1); s = s + f7(7, 2); s = s + f8(8, 3); s = s + f9(9, 4); s = s + f10(10, 0); s = s + f11(11, 1); s = s + f12(12, 2); s = s + f13(0, 3); s = s + f14(1, 4); s = s + f15(2, 0); s = s + f16(3, 1); s = s + f17(4, 2); s = s + f18(5, 3); s = s + f19(6, 4); s = s + f20(7, 0); s = s + f21(8, 1); s = s + f22(9, 2); s = s + f23(10, 3); s = s + f24(11, 4); s = s + f25(12, 0); s = s + f26(0, 1); s = s + f27(1, 2); s = s + f28(2, 3); s = s + f29(3, 4); s = s + f30(4, 0); s = s + f31(5, 1); s = s + f32(6, 2); s = s + f33(7, 3); s = s + f34(8, 4); s = s + f35(9, 0); s = s + f36(10, 1); s = s + f37(11, 2); s = s + f38(12, 3); s = s + f39(0, 4); s = s + f40(1, 0); s = s + f41(2, 1); s = s + f42(3, 2); s = s + f43(4, 3); s = s + f44(5, 4); s = s + f45(6, 0); s = s + f46(7, 1); s = s + f47(8, 2); s = s + f48(9, 3); s = s + f49(10, 4); s = s + f50(11, 0); s = s + f51(12, 1); s = s + f52(0, 2); s = s + f53(1, 3); s = s + f54(2, 4); s = s + f55(3, 0); s = s + f56(4, 1); s = s + f57(5, 2); s = s + f58(6, 3); s = s + f59(7, 4); s = s + f60(8, 0); s = s + f61(9, 1); s = s + f62(10, 2); s = s + f63(11, 3); s = s + f64(12, 4); s = s + f65(0, 0); s = s + f66(1, 1); s = s + f67(2, 2); s = s + f68(3, 3); s = s + f69(4, 4); s = s + f70(5, 0); s = s + f71(6, 1); s = s + f72(7, 2); s = s + f73(8, 3); s = s + f74(9, 4); s = s + f75(10, 0); s = s + f76(11, 1); s = s + f77(12, 2); s = s + f78(0, 3); s = s + f79(1, 4); s = s + f80(2, 0); s = s + f81(3, 1); s = s + f82(4, 2); s = s + f83(5, 3); s = s + f84(6, 4); s = s + f85(7, 0); s = s + f86(8, 1); s = s + f87(9, 2); s = s + f88(10, 3); s = s + f89(11, 4); s = s + f90(12, 0); s = s + f91(0, 1); s = s + f92(1, 2); s = s + f93(2, 3); s = s + f94(3, 4); s = s + f95(4, 0); s = s + f96(5, 1); s = s + f97(6, 2); s = s + f98(7, 3); s = s + f99(8, 4); s = s + f100(9, 0); s = s + f101(10, 1); s = s + f102(11, 2); s = s + f103(12, 3); s = s + f104(0, 4); s = s + f105(1, 0); s = s + f106(2, 1); s = s + f107(3, 2); s = s + f108(4, 3); s = s + f109(5, 4); s = s + f110(6, 0); s = s + f111(7, 1); s = s + f112(8, 2); s = s + f113(9, 3); s = s + f114(10, 4); s = s + f115(11, 0); s = s + f116(12, 1); s = s + f117(0, 2); s = s + f118(1, 3); s = s + f119(2, 4); s = s + f120(3, 0); s = s + f121(4, 1); s = s + f122(5, 2); s = s + f123(6, 3); s = s + f124(7, 4); s = s + f125(8, 0); s = s + f126(9, 1); s = s + f127(10, 2); s = s + f128(11, 3); s = s + f129(12, 4); s = s + f130(0, 0); s = s + f131(1, 1); s = s + f132(2, 2); s = s + f133(3, 3); s = s + f134(4, 4); s = s + f135(5, 0); s = s + f136(6, 1); s = s + f137(7, 2); s = s + f138(8, 3); s = s + f139(9, 4); s = s + f140(10, 0); s = s + f141(11, 1); s = s + f142(12, 2); s = s + f143(0, 3); s = s + f144(1, 4); s = s + f145(2, 0); s = s + f146(3, 1); s = s + f147(4, 2); s = s + f148(5, 3); s = s + f149(6, 4); s = s + f150(7, 0); s = s + f151(8, 1); s = s + f152(9, 2); s = s + f153(10, 3); s = s + f154(11, 4); s = s + f155(12, 0); s = s + f156(0, 1); s = s + f157(1, 2); s = s + f158(2, 3); s = s + f159(3, 4); s = s + f160(4, 0); s = s + f161(5, 1); s = s + f162(6, 2); s = s + f163(7, 3); s = s + f164(8, 4); s = s + f165(9, 0); s = s + f166(10, 1); s = s + f167(11, 2); s = s + f168(12, 3); s = s + f169(0, 4); s = s + f170(1, 0); s = s + f171(2, 1); s = s + f172(3, 2); s = s + f173(4, 3); s = s + f174(5, 4); s = s + f175(6, 0); s = s + f176(7, 1); s = s + f177(8, 2); s = s + f178(9, 3); s = s + f179(10, 4); s = s + f180(11, 0); s = s + f181(12, 1); s = s + f182(0, 2); s = s + f183(1, 3); s = s + f184(2, 4); s = s + f185(3, 0); s = s + f186(4, 1); s = s + f187(5, 2); s = s + f188(6, 3); s = s + f189(7, 4); s = s + f190(8, 0); s = s + f191(9, 1); s = s + f192(10, 2); s = s + f193(11, 3); s = s + f194(12, 4); s = s + f195(0, 0); s = s + f196(1, 1); s = s + f197(2, 2); s = s + f198(3, 3); s = s + f199(4, 4); s = s + f200(5, 0); s = s + f201(6, 1); s = s + f202(7, 2); s = s + f203(8, 3); s = s + f204(9, 4); s = s + f205(10, 0); s = s + f206(11, 1); s = s + f207(12, 2); s = s + f208(0, 3); s = s + f209(1, 4); s = s + f210(2, 0); s = s + f211(3, 1); s = s + f212(4, 2); s = s + f213(5, 3); s = s + f214(6, 4); s = s + f215(7, 0); s = s + f216(8, 1); s = s + f217(9, 2); s = s + f218(10, 3); s = s + f219(11, 4); s = s + f220(12, 0); s = s + f221(0, 1); s = s + f222(1, 2); s = s + f223(2, 3); s = s + f224(3, 4); s = s + f225(4, 0); s = s + f226(5, 1); s = s + f227(6, 2); s = s + f228(7, 3); s = s + f229(8, 4); s = s + f230(9, 0); s = s + f231(10, 1); s = s + f232(11, 2); s = s + f233(12, 3); s = s + f234(0, 4); s = s + f235(1, 0); s = s + f236(2, 1); s = s + f237(3, 2); s = s + f238(4, 3); s = s + f239(5, 4); s = s + f240(6, 0); s = s + f241(7, 1); s = s + f242(8, 2); s = s + f243(9, 3); s = s + f244(10, 4); s = s + f245(11, 0); s = s + f246(12, 1); s = s + f247(0, 2); s = s + f248(1, 3); s = s + f249(2, 4); s = s + f250(3, 0); s = s + f251(4, 1); s = s + f252(5, 2); s = s + f253(6, 3); s = s + f254(7, 4); s = s + f255(8, 0); s = s + f256(9, 1); s = s + f257(10, 2); s = s + f258(11, 3); s = s + f259(12, 4); s = s + f260(0, 0); s = s + f261(1, 1); s = s + f262(2, 2); s = s + f263(3, 3); s = s + f264(4, 4); s = s + f265(5, 0); s = s + f266(6, 1); s = s + f267(7, 2); s = s + f268(8, 3); s = s + f269(9, 4); s = s + f270(10, 0); s = s + f271(11, 1); s = s + f272(12, 2); s = s + f273(0, 3); s = s + f274(1, 4); s = s + f275(2, 0); s = s + f276(3, 1); s = s + f277(4, 2); s = s + f278(5, 3); s = s + f279(6, 4); s = s + f280(7, 0); s = s + f281(8, 1); s = s + f282(9, 2); s = s + f283(10, 3); s = s + f284(11, 4); s = s + f285(12, 0); s = s + f286(0, 1); s = s + f287(1, 2); s = s + f288(2, 3); s = s + f289(3, 4); s = s + f290(4, 0); s = s + f291(5, 1); s = s + f292(6, 2); s = s + f293(7, 3); s = s + f294(8, 4); s = s + f295(9, 0); s = s + f296(10, 1); s = s + f297(11, 2); s = s + f298(12, 3); s = s + f299(0, 4); putint(s); putch(10); return s % 256; }
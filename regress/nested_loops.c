@@ -0,0 +1,19 @@
+int main() {
+    int i = 0; int t = 0;
+    while (i < 20) {
+        int j = 0;
+        while (j < 20) {
+            int k = 0;
+            while (k < 20) {
+                if (i == j) { k = k + 1; continue; }
+                if (k > i + j) break;
+                t = t + (i * j + k) % 7;
+                k = k + 1;
+            }
+            j = j + 1;
+        }
+        i = i + 1;
+    }
+    putint(t); putch(10);
+    return t % 256;
+}
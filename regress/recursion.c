@@ -0,0 +1,8 @@
+int gcd(int a, int b) { if (b == 0) return a; return gcd(b, a % b); }
+int ack(int m, int n) { if (m == 0) return n + 1; if (n == 0) return ack(m - 1, 1); return ack(m - 1, ack(m, n - 1)); }
+int main() {
+    int i = 1; int s = 0;
+    while (i < 200) { s = s + gcd(i * 7, 1001); i = i + 1; }
+    putint(s); putch(32); putint(ack(2, 3)); putch(10);
+    return 0;
+}
@@ -0,0 +1,11 @@
+int x = 10;
+int f(int x) { { int x = 3; x = x + 1; } return x * 2; }
+int main() {
+    int r = x;
+    { int x = 5; r = r + x; { int x = 7; r = r * x; } r = r + x; }
+    r = r + x + f(4);
+    const int k = 3 * 4;
+    int arr[k] = {1};
+    putint(r + arr[0] + k); putch(10);
+    return r % 100;
+}
@@ -0,0 +1,13 @@
+int cnt = 0;
+int side(int x) { cnt = cnt + 1; return x; }
+int main() {
+    int a = 0; int i = 0;
+    while (i < 10) {
+        if (side(i) > 3 && side(i) < 7 || side(i) == 9) a = a + 1;
+        if (!(i % 2) || side(0)) a = a + 10;
+        if (side(i) && side(1) && !side(0)) a = a + 100;
+        i = i + 1;
+    }
+    putint(a); putch(32); putint(cnt); putch(10);
+    return a % 200;
+}
@@ -0,0 +1,20 @@
+int a[100];
+int seed = 12345;
+int rnd() { seed = (seed * 1103 + 12345) % 65536; return seed; }
+int main() {
+    int n = 100; int i = 0;
+    while (i < n) { a[i] = rnd() % 1000; i = i + 1; }
+    i = 0;
+    while (i < n) {
+        int j = 0;
+        while (j < n - 1 - i) {
+            if (a[j] > a[j + 1]) { int t = a[j]; a[j] = a[j + 1]; a[j + 1] = t; }
+            j = j + 1;
+        }
+        i = i + 1;
+    }
+    i = 0; int ok = 1;
+    while (i < n - 1) { if (a[i] > a[i+1]) ok = 0; i = i + 1; }
+    putint(a[0]); putch(32); putint(a[50]); putch(32); putint(a[99]); putch(32); putint(ok); putch(10);
+    return 0;
+}
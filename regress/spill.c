@@ -0,0 +1,18 @@
+int main() {
+    int a0 = 1; int a1 = 2; int a2 = 3; int a3 = 4; int a4 = 5; int a5 = 6; int a6 = 7; int a7 = 8;
+    int b0 = 9; int b1 = 10; int b2 = 11; int b3 = 12; int b4 = 13; int b5 = 14; int b6 = 15; int b7 = 16;
+    int c0 = 17; int c1 = 18; int c2 = 19; int c3 = 20; int c4 = 21; int c5 = 22; int c6 = 23; int c7 = 24;
+    int d0 = 25; int d1 = 26; int d2 = 27; int d3 = 28; int d4 = 29; int d5 = 30; int d6 = 31; int d7 = 32;
+    int i = 0;
+    while (i < 5) {
+        a0 = a0 + b7; a1 = a1 * 2 - a0; a2 = a2 + a1; a3 = a3 - a2; a4 = a4 + a3 * 3; a5 = a5 + a4; a6 = a6 - a5; a7 = a7 + a6;
+        b0 = b0 + a7; b1 = b1 + b0; b2 = b2 - b1; b3 = b3 + b2; b4 = b4 + b3; b5 = b5 - b4; b6 = b6 + b5; b7 = b7 % 100 + b6;
+        c0 = c0 + d7; c1 = c1 + c0; c2 = c2 + c1; c3 = c3 + c2; c4 = c4 / 2 + c3; c5 = c5 + c4; c6 = c6 + c5; c7 = c7 + c6;
+        d0 = d0 + c7; d1 = d1 + d0; d2 = d2 + d1; d3 = d3 + d2; d4 = d4 + d3; d5 = d5 + d4; d6 = d6 + d5; d7 = d7 % 1000 + d6;
+        putint(a0 + a1 + a2 + a3 + a4 + a5 + a6 + a7); putch(32);
+        i = i + 1;
+    }
+    int s = a0+a1+a2+a3+a4+a5+a6+a7+b0+b1+b2+b3+b4+b5+b6+b7+c0+c1+c2+c3+c4+c5+c6+c7+d0+d1+d2+d3+d4+d5+d6+d7;
+    putint(s); putch(10);
+    return 0;
+}
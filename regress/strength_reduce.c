@@ -0,0 +1,27 @@
+int seed = 12345;
+int rnd() { seed = seed * 1103515245 + 12345; return seed; }
+int M[200];
+int main() {
+    int i = 0, acc = 0;
+    while (i < 3000) {
+        int x = rnd();
+        if (i % 7 == 0) x = -x;
+        if (i == 0) x = 0;
+        if (i == 1) x = -2147483647 - 1;
+        if (i == 2) x = 2147483647;
+        acc = acc + x / 2 + x / 4 + x / 1024 + x / -8 + x / 3 + x / 7 + x / -5 + x / 10 + x / 641 + x / 1000000007 + x / -2147483647;
+        acc = acc * 31 + (x % 2 + x % 16 + x % -32 + x % 3 + x % 10 + x % -7 + x % 65536 + x % 1000);
+        acc = acc + x * 3 + x * 5 + x * 7 + x * 8 + x * -4 + x * 15 + x * 17 + x * 1 + x * 0;
+        i = i + 1;
+    }
+    putint(acc); putch(10);
+    int n = 10, s = 0;
+    i = 0;
+    while (i < n) { int j = 0; while (j < 20) { M[i * 20 + j] = i * 3 + j * 7; j = j + 1; } i = i + 1; }
+    i = 0;
+    while (i < 20) { int j = 0; while (j < n) { s = s + M[j * 20 + i] * (i * n + j); j = j + 2; } i = i + 1; }
+    int k = 199;
+    while (k >= 0) { s = s + M[k] * k; k = k - 3; }
+    putint(s); putch(10);
+    return (acc + s) % 256;
+}
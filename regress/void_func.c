@@ -0,0 +1,4 @@
+int g;
+void inc(int d) { g = g + d; if (g > 100) return; }
+void noop() {}
+int main() { int i = 0; while (i < 50) { inc(i); noop(); i = i + 1; } putint(g); putch(10); return g % 256; }
@@ -0,0 +1,48 @@
+#include "arena.h"
+#include <cstdint>
+#include <cstdlib>
+using namespace std;
+
+void *Arena::Allocate(size_t size, size_t align){
+    size_t pad = (align - reinterpret_cast<uintptr_t>(cur) % align) % align;
+    if(cur == nullptr || pad + size > left){
+        //超过块大小的对象单独占一块
+        size_t chunk_size = size + align > kChunkSize ? size + align : kChunkSize;
+        char *chunk = static_cast<char *>(malloc(chunk_size));
+        if(chunk == nullptr) throw bad_alloc();
+        chunks.push_back(chunk);
+        cur = chunk;
+        left = chunk_size;
+        pad = (align - reinterpret_cast<uintptr_t>(cur) % align) % align;
+    }
+    alloc_count++;
+    alloc_bytes += size;
+    void *res = cur + pad;
+    cur += pad + size;
+    left -= pad + size;
+    return res;
+}
+
+const string *Arena::Intern(string_view str){
+    auto it = interned.find(str);
+    if(it != interned.end()){
+        return it->second;
+    }
+    const string *res = New<string>(str);
+    interned.emplace(string_view(*res), res);
+    return res;
+}
+
+void Arena::Release(){
+    for(auto it = dtors.rbegin(); it != dtors.rend(); ++it){
+        it->second(it->first);
+    }
+    dtors.clear();
+    interned.clear();
+    for(char *chunk : chunks){
+        free(chunk);
+    }
+    chunks.clear();
+    cur = nullptr;
+    left = 0;
+}
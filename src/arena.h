@@ -0,0 +1,53 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+using namespace std;
+
+//一个编译单元的内存池：AST 结点和词法分析得到的字符串都从这里分配
+//对象按块顺序分配（bump pointer），编译结束时整体释放，不再递归析构整棵树
+class Arena {
+public:
+    Arena() = default;
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+    ~Arena() { Release(); }
+
+    void *Allocate(size_t size, size_t align);
+
+    template <typename T, typename... Args>
+    T *New(Args &&...args){
+        void *mem = Allocate(sizeof(T), alignof(T));
+        T *obj = new (mem) T(std::forward<Args>(args)...);
+        //只有需要析构的对象才登记，释放时线性地调用一遍
+        if constexpr (!is_trivially_destructible_v<T>) {
+            dtors.push_back({obj, [](void *p) { static_cast<T *>(p)->~T(); }});
+        }
+        return obj;
+    }
+
+    //相同内容的字符串只保存一份，返回的指针在 Release 之前一直有效
+    const string *Intern(string_view str);
+
+    void Release();
+
+    //累计分配的对象个数和字节数，-time-report 用
+    size_t AllocCount() const { return alloc_count; }
+    size_t AllocBytes() const { return alloc_bytes; }
+
+private:
+    static const size_t kChunkSize = 64 * 1024;
+
+    vector<char *> chunks;
+    char *cur = nullptr;
+    size_t left = 0;
+    size_t alloc_count = 0;
+    size_t alloc_bytes = 0;
+    vector<pair<void *, void (*)(void *)>> dtors;
+    unordered_map<string_view, const string *> interned;
+};
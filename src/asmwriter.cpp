@@ -0,0 +1,17 @@
+#include "asmwriter.h"
+#include "intfmt.h"
+#include <cstdio>
+using namespace std;
+
+void AsmWriter::AppendInt(long long value){
+    char tmp[kMaxIntChars];
+    buf.append(tmp, FormatInt(tmp, value));
+}
+
+bool AsmWriter::WriteToFile(const string &path) const {
+    FILE *fp = fopen(path.c_str(), "wb");
+    if (!fp) return false;
+    bool ok = fwrite(buf.data(), 1, buf.size(), fp) == buf.size();
+    ok = fclose(fp) == 0 && ok;
+    return ok;
+}
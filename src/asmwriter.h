@@ -0,0 +1,50 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <type_traits>
+using namespace std;
+
+//汇编输出缓冲：生成的代码先全部写进内存，最后一次性写入文件
+//整数直接格式化进缓冲区，不经过 iostream
+class AsmWriter {
+public:
+    explicit AsmWriter(size_t reserve_size = 1 << 16) { buf.reserve(reserve_size); }
+
+    AsmWriter &operator<<(string_view str){
+        buf.append(str.data(), str.size());
+        return *this;
+    }
+    AsmWriter &operator<<(const char *str){
+        return *this << string_view(str);
+    }
+    AsmWriter &operator<<(const string &str){
+        buf.append(str);
+        return *this;
+    }
+    AsmWriter &operator<<(char c){
+        buf.push_back(c);
+        return *this;
+    }
+    template <typename T, typename = enable_if_t<is_integral_v<T> && !is_same_v<T, char> && !is_same_v<T, bool>>>
+    AsmWriter &operator<<(T value){
+        AppendInt(static_cast<long long>(value));
+        return *this;
+    }
+
+    //把另一个缓冲区的内容接在后面
+    void Append(const AsmWriter &other){
+        buf.append(other.buf);
+    }
+
+    const string &Str() const { return buf; }
+    size_t Size() const { return buf.size(); }
+    void Clear() { buf.clear(); }
+
+    //失败时返回 false
+    bool WriteToFile(const string &path) const;
+
+private:
+    string buf;
+
+    void AppendInt(long long value);
+};
@@ -7,65 +7,118 @@
 #include <vector>
 #include <unordered_map>
 #include "symtable.h"
+#include "arena.h"
 using namespace std;
 
 
-inline SymbolTable sym_table;
-inline KoopaIRBuilder builder;
-inline bool is_in_global = true;
+//SysY 运行时库的声明不随输入变化：标识符、符号表项和 raw 函数声明
+//每个线程第一次编译时构建一次，之后的编译（-daemon 的工作线程）直接复用
+struct SysYLibrary {
+    Arena arena;
+    IdentTable idents{arena};
+    vector<pair<SymbolId, SymbolEntry>> symbols;
+    RawIRArena raw_arena;
+    vector<koopa_raw_function_t> raw_decls;
+
+    SysYLibrary(){
+        koopa_raw_type_t i32 = raw_arena.Int32Type();
+        koopa_raw_type_t ptr = raw_arena.PointerType(i32);
+        koopa_raw_type_t unit = raw_arena.UnitType();
+        struct LibFunc {
+            const char *name;
+            vector<koopa_raw_type_t> param_types;
+            koopa_raw_type_t ret;
+        };
+        const LibFunc funcs[] = {
+            {"getint", {}, i32},
+            {"getch", {}, i32},
+            {"getarray", {ptr}, i32},
+            {"putint", {i32}, unit},
+            {"putch", {i32}, unit},
+            {"putarray", {i32, ptr}, unit},
+            {"starttime", {}, unit},
+            {"stoptime", {}, unit},
+        };
+        RawIRBuilder raw_builder(raw_arena);
+        for(const LibFunc &f : funcs){
+            koopa_raw_function_t decl = raw_builder.AddFuncDecl(f.name, f.param_types, f.ret);
+            SymbolType type = f.ret == i32 ? SymbolType::RET_INT : SymbolType::RET_VOID;
+            symbols.push_back({idents.Intern(f.name), {type, 0, nullptr, decl}});
+            raw_decls.push_back(decl);
+        }
+    }
+
+    static const SysYLibrary &ForThisThread(){
+        static thread_local SysYLibrary lib;
+        return lib;
+    }
+};
+
+//一次编译的前端状态，编译结束时整体释放
+//每个线程同一时间只做一次编译，cur_ctx 指向这个线程正在做的那次；-daemon 下多个编译在不同线程上并发
+struct CompileContext {
+    Arena ast_arena;   //AST 结点和标识符都分配在这里
+    IdentTable ident_table{ast_arena, SysYLibrary::ForThisThread().idents};   //库函数名已经占好前几个 id
+    SymbolTable sym_table{ident_table};
+    KoopaIRBuilder builder;
+    bool is_in_global = true;
+    ostream *diag = &cerr;  //语义错误写到这里
+
+    //符号表和 IR 生成器的内部错误也一并写到 out
+    void SetDiag(ostream &out){
+        diag = &out;
+        sym_table.SetDiag(&out);
+        builder.SetDiag(&out);
+    }
+};
+inline thread_local CompileContext *cur_ctx = nullptr;
+
+//语义错误：错误信息已经写进 cur_ctx->diag，由驱动捕获后返回非 0，不直接退出进程
+struct CompileError {};
 
 class BaseAST {
 //这个是基类，要提供之后的接口也可以是一个纯虚函数
 //我这里要提供一个什么接口？
     public:
     virtual ~BaseAST() = default;
-    virtual string GenKoopaIR() const = 0;
+    //表达式返回结果的值，语句和声明返回空指针
+    virtual koopa_raw_value_t GenKoopaIR() const = 0;
     virtual int CalcValue() const {
-        cerr << "CalcValue not implemented for this AST node!" << endl;
+        *cur_ctx->diag << "CalcValue not implemented for this AST node!" << endl;
         return 0;
     }
+    //作为 if / while 的条件生成代码：结果为真跳到 true_bb，为假跳到 false_bb
+    //默认先求值再 br；&&、||、! 会覆盖它，直接生成跳转，不需要临时变量
+    virtual void GenCondIR(koopa_raw_basic_block_t true_bb, koopa_raw_basic_block_t false_bb) const {
+        koopa_raw_value_t val = GenKoopaIR();
+        cur_ctx->builder.EndWithBranch(val, true_bb, false_bb);
+    }
 };
 
 //定义此时的compUnit、
 class CompUnitAST : public BaseAST {
     public:
-    vector<unique_ptr<BaseAST>> global_defs;
+    vector<BaseAST*> global_defs;
 
         void InitSysYLibrary() const {
+        // 库函数的声明每个线程只建一次，这里只把它们登记到这次编译里
+        const SysYLibrary &lib = SysYLibrary::ForThisThread();
         // 1. 提前注册到符号表，供后续 AST 节点检查和生成调用指令
-        sym_table.Insert("getint", {SymbolType::RET_INT, 0, ""});
-        sym_table.Insert("getch", {SymbolType::RET_INT, 0, ""});
-        sym_table.Insert("getarray", {SymbolType::RET_INT, 0, ""});
-        
-        sym_table.Insert("putint", {SymbolType::RET_VOID, 0, ""});
-        sym_table.Insert("putch", {SymbolType::RET_VOID, 0, ""});
-        sym_table.Insert("putarray", {SymbolType::RET_VOID, 0, ""});
-        
-        sym_table.Insert("starttime", {SymbolType::RET_VOID, 0, ""});
-        sym_table.Insert("stoptime", {SymbolType::RET_VOID, 0, ""});
-
-        // 2. 将库函数的 Koopa IR 声明 (decl) 提前存入 Builder 的全局定义中
-        // 注意：这里需要确保你的 builder.AddGlobalDecl 支持直接追加字符串并带有换行
-        builder.AddGlobalDecl("decl @getint(): i32");
-        builder.AddGlobalDecl("decl @getch(): i32");
-        builder.AddGlobalDecl("decl @getarray(*i32): i32");
-        builder.AddGlobalDecl("decl @putint(i32)");
-        builder.AddGlobalDecl("decl @putch(i32)");
-        builder.AddGlobalDecl("decl @putarray(i32, *i32)");
-        builder.AddGlobalDecl("decl @starttime()");
-        builder.AddGlobalDecl("decl @stoptime()");
-        builder.AddGlobalDecl(""); // 加个空行美化生成的 IR
+        for(const auto &sym : lib.symbols){
+            cur_ctx->sym_table.Insert(sym.first, sym.second);
+        }
+        // 2. 将库函数的声明 (decl) 提前登记到 Builder 的 program 中
+        cur_ctx->builder.AddLibraryDecls(lib.raw_decls);
     }
-    string GenKoopaIR() const override{
+    koopa_raw_value_t GenKoopaIR() const override{
 
         InitSysYLibrary(); // 初始化库函数声明
         for(const auto& def: global_defs){
             def->GenKoopaIR();
         }
 
-        string final_ir = builder.GetProgramIR();
-        cout << final_ir << endl;
-        return final_ir;
+        // 整个程序留在 builder 里，由调用者取出
+        return nullptr;
     }
     
 };
@@ -73,75 +126,77 @@ class CompUnitAST : public BaseAST {
 
 class FuncFParamAST : public BaseAST {
     public:
-        unique_ptr<BaseAST> b_type;
-        string ident;
+        BaseAST* b_type = nullptr;
+        SymbolId ident = -1;
 
-        string GetSignature() const{
-            return "@" + ident + ": i32";
+        //形参的值要按下标从函数里取，由 FuncFParamsAST 调用 GenParamIR
+        koopa_raw_value_t GenKoopaIR() const override{
+            return nullptr;
         }
 
-        string GenKoopaIR() const override{
-            string param_name = "@" + ident;
-            string local_var_name = "@" + ident + "_local_" + to_string(builder.GetUniqueId());
-
+        void GenParamIR(koopa_raw_value_t arg) const {
+            string local_var_name = "@" + cur_ctx->ident_table.Name(ident) + "_local_" + to_string(cur_ctx->builder.GetUniqueId());
+            koopa_raw_value_t local_var = cur_ctx->builder.AddLocalAlloc(local_var_name, -1);
 
-            SymbolEntry entry = {SymbolType::VARIABLE, 0, local_var_name};
-            if (!sym_table.Insert(ident, entry)) {
-                cerr << "Semantic Error: Redefinition of parameter '" << ident << "'" << endl;
-                exit(1);
+            SymbolEntry entry = {SymbolType::VARIABLE, 0, local_var};
+            if (!cur_ctx->sym_table.Insert(ident, entry)) {
+                *cur_ctx->diag << "Semantic Error: Redefinition of parameter '" << cur_ctx->ident_table.Name(ident) << "'" << endl;
+                throw CompileError();
             }
 
-            builder.AddAlloc(local_var_name + " = alloc i32");
-            builder.AddInst("store " + param_name + ", " + local_var_name);
-            
-            return "";
+            cur_ctx->builder.AddStore(arg, local_var);
         }
     
 };
 
 class FuncFParamsAST : public BaseAST {
     public:
-        vector<unique_ptr<BaseAST>> params;
-        string GenKoopaIR() const override {
-            for(const auto& param: params){
-                param->GenKoopaIR();
+        vector<BaseAST*> params;
+        koopa_raw_value_t GenKoopaIR() const override {
+            for(size_t i = 0; i < params.size(); i++){
+                static_cast<FuncFParamAST*>(params[i])->GenParamIR(cur_ctx->builder.GetParam(i));
             }
-            return "";
+            return nullptr;
         }
 
-        string GetSignature() const{
-           string sig = "";
-            for (size_t i = 0; i < params.size(); ++i) {
-                auto param_ptr = static_cast<FuncFParamAST*>(params[i].get());
-                sig += param_ptr->GetSignature();
-                if (i != params.size() - 1) sig += ", ";
+        vector<string> GetParamNames() const{
+            vector<string> names;
+            for (const auto& param : params) {
+                names.push_back(cur_ctx->ident_table.Name(static_cast<FuncFParamAST*>(param)->ident));
             }
-            return sig;
+            return names;
         }
 };
 
+class FuncTypeAST : public BaseAST {
+    public:
+    string type = "int";
+
+    koopa_raw_value_t GenKoopaIR() const override {
+        return nullptr;
+    }
+};
+
 class FuncDefAST :public BaseAST {
     public:
-    std:: unique_ptr<BaseAST> func_type;
-    std:: string ident;
-    std:: unique_ptr<BaseAST> block;
-    unique_ptr<BaseAST> func_params;
-
-    string GenKoopaIR() const override {
-        is_in_global = false;
-        builder.Reset();
-
-        string type_str = func_type->GenKoopaIR(); 
-        string koopa_ret_type = (type_str == "int") ? ": i32" : ""; 
-        sym_table.Insert(ident, {type_str == "int" ? SymbolType::RET_INT : SymbolType::RET_VOID, 0, ""});
-        string sig_params = "";
+    BaseAST* func_type = nullptr;
+    SymbolId ident = -1;
+    BaseAST* block = nullptr;
+    BaseAST* func_params = nullptr;
+
+    koopa_raw_value_t GenKoopaIR() const override {
+        cur_ctx->is_in_global = false;
+
+        const string &type_str = static_cast<FuncTypeAST*>(func_type)->type;
+        vector<string> param_names;
         if (func_params) {
-            auto params_ptr = static_cast<FuncFParamsAST*>(func_params.get());
-            sig_params = params_ptr->GetSignature(); 
+            auto params_ptr = static_cast<FuncFParamsAST*>(func_params);
+            param_names = params_ptr->GetParamNames(); 
         }
 
-        string signature = "fun @" + ident + "(" + sig_params + ")" + koopa_ret_type;
-        sym_table.EnterScope();
+        koopa_raw_function_t func = cur_ctx->builder.BeginFunction(cur_ctx->ident_table.Name(ident), param_names, type_str == "int");
+        cur_ctx->sym_table.Insert(ident, {type_str == "int" ? SymbolType::RET_INT : SymbolType::RET_VOID, 0, nullptr, func});
+        cur_ctx->sym_table.EnterScope();
 
 
         if(func_params){
@@ -152,114 +207,105 @@ class FuncDefAST :public BaseAST {
         block->GenKoopaIR();
 
         // 6. 退出作用域
-        sym_table.ExitScope();
+        cur_ctx->sym_table.ExitScope();
 
         // 7. 处理无 return 的兜底
-        if (!builder.IsBlockClosed()) {
+        if (!cur_ctx->builder.IsBlockClosed()) {
             if (type_str == "void") {
-                builder.EndWithRet("");
+                cur_ctx->builder.EndWithRet(nullptr);
             } else {
-                builder.EndWithRet("0"); 
+                cur_ctx->builder.EndWithRet(cur_ctx->builder.Integer(0)); 
             }
         }
 
         // 8. 组装并追加到全局 Buffer 中
-        string func_ir = builder.BuildFunction(signature);
-        builder.AddGlobalDecl(func_ir); // 把这个函数存进整个程序的代码里
+        cur_ctx->builder.EndFunction();
 
-        is_in_global = true; 
-        return "";
+        cur_ctx->is_in_global = true; 
+        return nullptr;
     }
 };
 
 
 
-class FuncTypeAST : public BaseAST {
-    public:
-    string type = "int";
-
-    string GenKoopaIR() const override {
-        return type;
-    }
-};
 
 class BlockAST : public BaseAST {
     public:
-    vector<unique_ptr<BaseAST>> block_items;
+    vector<BaseAST*> block_items;
 
-    string GenKoopaIR() const override {
-        sym_table.EnterScope();
+    koopa_raw_value_t GenKoopaIR() const override {
+        cur_ctx->sym_table.EnterScope();
         for(const auto &item: block_items){
             item->GenKoopaIR();
-            if(builder.IsBlockClosed()){
+            if(cur_ctx->builder.IsBlockClosed()){
                 break; 
             }
         }
-        sym_table.ExitScope();
-        return "";
+        cur_ctx->sym_table.ExitScope();
+        return nullptr;
     }
 };
 
 class BlockItemAST : public BaseAST {
     public:
-    unique_ptr<BaseAST> decl;
-    unique_ptr<BaseAST> stmt;
+    BaseAST* decl = nullptr;
+    BaseAST* stmt = nullptr;
 
-    string GenKoopaIR() const override {
+    koopa_raw_value_t GenKoopaIR() const override {
         if(decl){
             return decl->GenKoopaIR();
         } else if(stmt){
         return stmt->GenKoopaIR();
         }
-        return "";
+        return nullptr;
     }
 };
 
 
 class LValAST : public BaseAST {
     public:
-        string ident;
-        unique_ptr<BaseAST> array_idx;
-        string GetPtrIR() const{
-            auto entry = sym_table.Lookup(ident);
+        SymbolId ident = -1;
+        BaseAST* array_idx = nullptr;
+        koopa_raw_value_t GetPtrIR() const{
+            auto entry = cur_ctx->sym_table.Lookup(ident);
             if(!entry){
-                cerr << "Semantic Error: Undefined symbol '" << ident << "'" << endl;
-                exit(1);
+                *cur_ctx->diag << "Semantic Error: Undefined symbol '" << cur_ctx->ident_table.Name(ident) << "'" << endl;
+                throw CompileError();
             }
 
             if(!array_idx){
-                return entry->var_name;
+                return entry->ptr;
             }else{
-                string idx_val = array_idx->GenKoopaIR();
-                string elem_ptr = builder.GetTmpVar();
-                builder.AddInst(elem_ptr + " = getelemptr "+ entry->var_name + ", " + idx_val);
-                return elem_ptr;
+                koopa_raw_value_t idx_val = array_idx->GenKoopaIR();
+                return cur_ctx->builder.AddGetElemPtr(entry->ptr, idx_val);
             }
         }
 
 
 
-        string GenKoopaIR() const override {
-            auto entry = sym_table.Lookup(ident);
+        koopa_raw_value_t GenKoopaIR() const override {
+            auto entry = cur_ctx->sym_table.Lookup(ident);
+            if(!entry){
+                *cur_ctx->diag << "Semantic Error: Undefined symbol '" << cur_ctx->ident_table.Name(ident) << "'" << endl;
+                throw CompileError();
+            }
             if(entry->type == SymbolType::CONSTANT && !array_idx){
-                return to_string(entry->int_val);
+                return cur_ctx->builder.Integer(entry->int_val);
             }else{
-                string ptr = GetPtrIR();
-                string tmp_var = builder.GetTmpVar();
-                builder.AddInst(tmp_var + " = load " + ptr);
-                return tmp_var;
+                koopa_raw_value_t ptr = GetPtrIR();
+                return cur_ctx->builder.AddLoad(ptr);
             }
         }
 
         int CalcValue() const override {
-            auto entry = sym_table.Lookup(ident);
+            auto entry = cur_ctx->sym_table.Lookup(ident);
             if (!entry) {
-                cerr << "Semantic Error: Undefined symbol '" << ident << "'" << endl;
-                exit(1);
+                *cur_ctx->diag << "Semantic Error: Undefined symbol '" << cur_ctx->ident_table.Name(ident) << "'" << endl;
+                throw CompileError();
             }
             if (entry->type == SymbolType::VARIABLE) {
-                cerr << "Semantic Error: Variable '" << ident << "' cannot be used in constant expression" << endl;
-                exit(1);
+                *cur_ctx->diag << "Semantic Error: Variable '" << cur_ctx->ident_table.Name(ident) << "' cannot be used in constant expression" << endl;
+                throw CompileError();
             }
             return entry->int_val;
         }
@@ -270,72 +316,72 @@ class StmtAST : public BaseAST {
     public:
     bool is_return = false;
     bool is_if = false;
-    unique_ptr<BaseAST> exp;
-    unique_ptr<BaseAST> lval;
-    unique_ptr<BaseAST> block;
-    unique_ptr<BaseAST> else_stmt;
-    unique_ptr<BaseAST> cond;
-    unique_ptr<BaseAST> then_stmt;
-    unique_ptr<BaseAST> while_exp;
+    BaseAST* exp = nullptr;
+    BaseAST* lval = nullptr;
+    BaseAST* block = nullptr;
+    BaseAST* else_stmt = nullptr;
+    BaseAST* cond = nullptr;
+    BaseAST* then_stmt = nullptr;
+    BaseAST* while_exp = nullptr;
     bool is_break = false;
     bool is_continue = false;
     
 
-    string GenKoopaIR() const override {
+    koopa_raw_value_t GenKoopaIR() const override {
         if(is_return){
-            string ret_val = exp ? exp->GenKoopaIR() : "0"; 
-            builder.EndWithRet(ret_val);
-            return "";
+            koopa_raw_value_t ret_val = exp ? exp->GenKoopaIR() : cur_ctx->builder.Integer(0); 
+            cur_ctx->builder.EndWithRet(ret_val);
+            return nullptr;
         }else if(is_if){
-            string cond_val = cond->GenKoopaIR();
-            int id = builder.GetUniqueId();
-            string then_label = "%then_" + to_string(id);
-            string else_label = "%else_" + to_string(id);
-            string end_label = "%end_" + to_string(id);
+            string id = to_string(cur_ctx->builder.GetUniqueId());
+            koopa_raw_basic_block_t then_bb = cur_ctx->builder.NewBlock("%then_" + id);
+            koopa_raw_basic_block_t else_bb = else_stmt ? cur_ctx->builder.NewBlock("%else_" + id) : nullptr;
+            koopa_raw_basic_block_t end_bb = cur_ctx->builder.NewBlock("%end_" + id);
 
-            builder.EndWithBranch(cond_val, then_label, else_label);
+            // 没有 else 时条件为假直接跳到 end
+            cond->GenCondIR(then_bb, else_stmt ? else_bb : end_bb);
 
-            builder.StartNewBlock(then_label);
+            cur_ctx->builder.StartNewBlock(then_bb);
             then_stmt->GenKoopaIR();
-            builder.EndWithJump(end_label);
+            cur_ctx->builder.EndWithJump(end_bb);
 
-            builder.StartNewBlock(else_label);
             if(else_stmt){
+                cur_ctx->builder.StartNewBlock(else_bb);
                 else_stmt->GenKoopaIR();
+                cur_ctx->builder.EndWithJump(end_bb);
             }
-            builder.EndWithJump(end_label);
 
-            builder.StartNewBlock(end_label);
-            return "";
+            cur_ctx->builder.StartNewBlock(end_bb);
+            return nullptr;
 
 
         } else if(lval && exp){
-            LValAST* lval_ptr = static_cast<LValAST*>(lval.get());
-            string ptr_name = lval_ptr->GetPtrIR(); // 调用上面新增的取指针方法
-            string val_name = exp->GenKoopaIR();
-            builder.AddInst("store " + val_name + ", " + ptr_name);
+            LValAST* lval_ptr = static_cast<LValAST*>(lval);
+            koopa_raw_value_t ptr = lval_ptr->GetPtrIR(); // 调用上面新增的取指针方法
+            koopa_raw_value_t val = exp->GenKoopaIR();
+            cur_ctx->builder.AddStore(val, ptr);
         }else if(block){
             block->GenKoopaIR();
         }else if(exp){
             exp->GenKoopaIR();
         }else if(while_exp){
             while_exp->GenKoopaIR();
-        }else if(is_break){
-            string taget_label = builder.GetCurrentLoopEnd();
-            builder.EndWithJump(taget_label);
-        }else if(is_continue){
-            string target_label = builder.GetCurrentLoopEntry();
-            builder.EndWithJump(target_label);
-        }
-        return "";
+        }else if(is_break || is_continue){
+            koopa_raw_basic_block_t target = is_break ? cur_ctx->builder.GetCurrentLoopEnd() : cur_ctx->builder.GetCurrentLoopEntry();
+            if(!target){
+                throw CompileError(); // 不在循环里，错误信息 builder 已经写过了
+            }
+            cur_ctx->builder.EndWithJump(target);
+        }
+        return nullptr;
     }
 };
 
 class NumberAST :public BaseAST {
     public:
     int value;
-    string GenKoopaIR() const override {
-        return to_string(value);
+    koopa_raw_value_t GenKoopaIR() const override {
+        return cur_ctx->builder.Integer(value);
     }
 
     int CalcValue() const override {
@@ -345,12 +391,16 @@ class NumberAST :public BaseAST {
 
 class ExpAST : public BaseAST {
     public:
-        unique_ptr<BaseAST> lor_exp;
+        BaseAST* lor_exp = nullptr;
 
-        string GenKoopaIR() const override {
+        koopa_raw_value_t GenKoopaIR() const override {
             return lor_exp->GenKoopaIR();
         }
 
+        void GenCondIR(koopa_raw_basic_block_t true_bb, koopa_raw_basic_block_t false_bb) const override {
+            lor_exp->GenCondIR(true_bb, false_bb);
+        }
+
         int CalcValue() const override {
             return lor_exp->CalcValue();
         }
@@ -358,11 +408,11 @@ class ExpAST : public BaseAST {
 
 class PrimaryExpAST : public BaseAST {
     public:
-        unique_ptr<BaseAST> exp;
-        unique_ptr<BaseAST> number;
-        unique_ptr<BaseAST> LVal;
+        BaseAST* exp = nullptr;
+        BaseAST* number = nullptr;
+        BaseAST* LVal = nullptr;
 
-        string GenKoopaIR() const override {
+        koopa_raw_value_t GenKoopaIR() const override {
             if(exp){
                 return exp->GenKoopaIR();
             } else if(number){
@@ -370,7 +420,15 @@ class PrimaryExpAST : public BaseAST {
             } else if(LVal){
                 return LVal->GenKoopaIR();
             }
-            return "";
+            return nullptr;
+        }
+
+        void GenCondIR(koopa_raw_basic_block_t true_bb, koopa_raw_basic_block_t false_bb) const override {
+            if(exp){
+                exp->GenCondIR(true_bb, false_bb);
+            } else {
+                BaseAST::GenCondIR(true_bb, false_bb);
+            }
         }
 
         int CalcValue() const override {
@@ -386,53 +444,77 @@ class PrimaryExpAST : public BaseAST {
 };
 
 
+class FuncRParamsAST : public BaseAST {
+    public:
+        vector<BaseAST*> exps;
+        //计算每个实参的 IR，得到对应的值
+        vector<koopa_raw_value_t> GenArgs() const {
+            vector<koopa_raw_value_t> args;
+            for (const auto& exp : exps) {
+                args.push_back(exp->GenKoopaIR());
+            }
+            return args;
+        }
+
+        //实参由 UnaryExpAST 通过 GenArgs 取得
+        koopa_raw_value_t GenKoopaIR() const override {
+            GenArgs();
+            return nullptr;
+        }
+};
+
 class UnaryExpAST : public BaseAST {
     public:
-        unique_ptr<BaseAST> primary_exp;
+        BaseAST* primary_exp = nullptr;
         char op = 0;
-        unique_ptr<BaseAST> unary_exp;
-        unique_ptr<BaseAST> func_call;
-        string ident;
+        BaseAST* unary_exp = nullptr;
+        BaseAST* func_call = nullptr;
+        SymbolId ident = -1;
 
 
-        string GenKoopaIR() const override {
+        koopa_raw_value_t GenKoopaIR() const override {
             if(primary_exp){
                 return primary_exp->GenKoopaIR();
             } else if(op && unary_exp){
-                string inner_val = unary_exp->GenKoopaIR();
+                koopa_raw_value_t inner_val = unary_exp->GenKoopaIR();
                 if(op == '+'){
                     return inner_val;
                 }
-                string res_var = builder.GetTmpVar();
                 if(op == '-'){
-                    builder.AddInst(res_var + " = sub 0, " + inner_val);
-                }else if(op == '!'){
-                    builder.AddInst(res_var + " = eq " + inner_val + ", 0");
+                    return cur_ctx->builder.AddBinary(KOOPA_RBO_SUB, cur_ctx->builder.Integer(0), inner_val);
                 }
-                return res_var;
-            }else if(!ident.empty()){
-                string args = "";
+                return cur_ctx->builder.AddBinary(KOOPA_RBO_EQ, inner_val, cur_ctx->builder.Integer(0));
+            }else if(ident >= 0){
+                vector<koopa_raw_value_t> args;
                 if(func_call){
-                    args = func_call->GenKoopaIR();
+                    args = static_cast<FuncRParamsAST*>(func_call)->GenArgs();
                 }
-                auto entry = sym_table.Lookup(ident);
+                auto entry = cur_ctx->sym_table.Lookup(ident);
                 if (!entry) {
-                    cerr << "Semantic Error: Undefined variable '" << ident << "'" << endl;
-                    exit(1);
+                    *cur_ctx->diag << "Semantic Error: Undefined variable '" << cur_ctx->ident_table.Name(ident) << "'" << endl;
+                    throw CompileError();
                 }
-                if (entry->type == SymbolType::RET_INT) {
-                    auto res_var = builder.GetTmpVar();
-                    builder.AddInst(res_var + " = call @" + ident + "(" + args + ")");
-                    return res_var;
-                }else if(entry->type == SymbolType:: RET_VOID){
-                    builder.AddInst("call @" + ident + "(" + args + ")");
-                    return "";
+                if (entry->type == SymbolType::RET_INT || entry->type == SymbolType::RET_VOID) {
+                    return cur_ctx->builder.AddCall(entry->func, args);
                 } else {
-                    cerr << "Semantic Error: Symbol '" << ident << "' is not a function" << endl;
-                    exit(1);
+                    *cur_ctx->diag << "Semantic Error: Symbol '" << cur_ctx->ident_table.Name(ident) << "' is not a function" << endl;
+                    throw CompileError();
                 }
             }
-            return "";
+            return nullptr;
+        }
+
+        void GenCondIR(koopa_raw_basic_block_t true_bb, koopa_raw_basic_block_t false_bb) const override {
+            if(primary_exp){
+                primary_exp->GenCondIR(true_bb, false_bb);
+            } else if(op == '!' && unary_exp){
+                unary_exp->GenCondIR(false_bb, true_bb);
+            } else if(op && unary_exp){
+                // +x、-x 与 x 的真假相同
+                unary_exp->GenCondIR(true_bb, false_bb);
+            } else {
+                BaseAST::GenCondIR(true_bb, false_bb);
+            }
         }
 
         int CalcValue() const override {
@@ -447,26 +529,25 @@ class UnaryExpAST : public BaseAST {
 
 class AddExpAST : public BaseAST {
     public:
-    unique_ptr<BaseAST> mul_exp;
-    unique_ptr<BaseAST> add_exp;
+    BaseAST* mul_exp = nullptr;
+    BaseAST* add_exp = nullptr;
     char op = 0; // '+' or '-'
 
-    string GenKoopaIR() const override {
+    koopa_raw_value_t GenKoopaIR() const override {
         if(add_exp){
-            string left_val = add_exp->GenKoopaIR();
-            string right_val = mul_exp->GenKoopaIR();
-            string res_var = builder.GetTmpVar();
-            if(op == '+'){
-                builder.AddInst(res_var + " = add " + left_val + ", " + right_val);
-            } else if(op == '-'){
-                builder.AddInst(res_var + " = sub " + left_val + ", " + right_val);
-            }
-            return res_var;
+            koopa_raw_value_t left_val = add_exp->GenKoopaIR();
+            koopa_raw_value_t right_val = mul_exp->GenKoopaIR();
+            return cur_ctx->builder.AddBinary(op == '+' ? KOOPA_RBO_ADD : KOOPA_RBO_SUB, left_val, right_val);
         } else {
             return mul_exp->GenKoopaIR();
         }
     }
 
+    void GenCondIR(koopa_raw_basic_block_t true_bb, koopa_raw_basic_block_t false_bb) const override {
+        if(add_exp) BaseAST::GenCondIR(true_bb, false_bb);
+        else mul_exp->GenCondIR(true_bb, false_bb);
+    }
+
     int CalcValue() const override {
         if(!add_exp) return mul_exp->CalcValue();
         int left = add_exp->CalcValue();
@@ -479,28 +560,30 @@ class AddExpAST : public BaseAST {
 
 class MulExpAST : public BaseAST {
     public:
-    unique_ptr<BaseAST> unary_exp;
-    unique_ptr<BaseAST> mul_exp;
+    BaseAST* unary_exp = nullptr;
+    BaseAST* mul_exp = nullptr;
     char op = 0;
     
-    string GenKoopaIR() const override {
+    koopa_raw_value_t GenKoopaIR() const override {
         if(mul_exp){
-            string left_val = mul_exp->GenKoopaIR();
-            string right_val = unary_exp->GenKoopaIR();
-            string res_var = builder.GetTmpVar();
+            koopa_raw_value_t left_val = mul_exp->GenKoopaIR();
+            koopa_raw_value_t right_val = unary_exp->GenKoopaIR();
             if(op == '*'){
-                builder.AddInst(res_var + " = mul " + left_val + ", " + right_val);
+                return cur_ctx->builder.AddBinary(KOOPA_RBO_MUL, left_val, right_val);
             } else if(op == '/'){
-                builder.AddInst(res_var + " = div " + left_val + ", " + right_val);
-            } else if(op == '%'){
-                builder.AddInst(res_var + " = mod " + left_val + ", " + right_val);
+                return cur_ctx->builder.AddBinary(KOOPA_RBO_DIV, left_val, right_val);
             }
-            return res_var;
+            return cur_ctx->builder.AddBinary(KOOPA_RBO_MOD, left_val, right_val);
         }else {
             return unary_exp->GenKoopaIR();
         }
     }
 
+    void GenCondIR(koopa_raw_basic_block_t true_bb, koopa_raw_basic_block_t false_bb) const override {
+        if(mul_exp) BaseAST::GenCondIR(true_bb, false_bb);
+        else unary_exp->GenCondIR(true_bb, false_bb);
+    }
+
      int CalcValue() const override {
         if(!mul_exp) return unary_exp->CalcValue();
         int left = mul_exp->CalcValue();
@@ -514,30 +597,32 @@ class MulExpAST : public BaseAST {
 
 class RelExp : public BaseAST{
     public:
-    unique_ptr<BaseAST> add_exp;
-    unique_ptr<BaseAST> rel_exp;
+    BaseAST* add_exp = nullptr;
+    BaseAST* rel_exp = nullptr;
     string op = ""; // '<', '>', '<=', '>='
 
-    string GenKoopaIR() const override {
+    koopa_raw_value_t GenKoopaIR() const override {
         if(rel_exp){
-            string left_val = rel_exp->GenKoopaIR();
-            string right_val = add_exp->GenKoopaIR();
-            string res_var = builder.GetTmpVar();
+            koopa_raw_value_t left_val = rel_exp->GenKoopaIR();
+            koopa_raw_value_t right_val = add_exp->GenKoopaIR();
             if(op == "<"){
-                builder.AddInst(res_var + " = lt " + left_val + ", " + right_val);
+                return cur_ctx->builder.AddBinary(KOOPA_RBO_LT, left_val, right_val);
             } else if(op == ">"){
-                builder.AddInst(res_var + " = gt " + left_val + ", " + right_val);
+                return cur_ctx->builder.AddBinary(KOOPA_RBO_GT, left_val, right_val);
             } else if(op == "<="){
-                builder.AddInst(res_var + " = le " + left_val + ", " + right_val);
-            } else if(op == ">="){
-                builder.AddInst(res_var + " = ge " + left_val + ", " + right_val);
+                return cur_ctx->builder.AddBinary(KOOPA_RBO_LE, left_val, right_val);
             }
-            return res_var;
+            return cur_ctx->builder.AddBinary(KOOPA_RBO_GE, left_val, right_val);
         } else {
             return add_exp->GenKoopaIR();
         }
     }
 
+    void GenCondIR(koopa_raw_basic_block_t true_bb, koopa_raw_basic_block_t false_bb) const override {
+        if(rel_exp) BaseAST::GenCondIR(true_bb, false_bb);
+        else add_exp->GenCondIR(true_bb, false_bb);
+    }
+
     int CalcValue() const override {
         if(!rel_exp) return add_exp->CalcValue();
         int left = rel_exp->CalcValue();
@@ -552,26 +637,25 @@ class RelExp : public BaseAST{
 
 class EqExp : public BaseAST{
     public:
-        unique_ptr<BaseAST> rel_exp;
-        unique_ptr<BaseAST> eq_exp;
+        BaseAST* rel_exp = nullptr;
+        BaseAST* eq_exp = nullptr;
         string op = ""; // '==' or '!='
 
-        string GenKoopaIR() const override {
+        koopa_raw_value_t GenKoopaIR() const override {
             if(eq_exp){
-                string left_val = eq_exp->GenKoopaIR();
-                string right_val = rel_exp->GenKoopaIR();
-                string res_var = builder.GetTmpVar();
-                if(op == "=="){
-                    builder.AddInst(res_var + " = eq " + left_val + ", " + right_val);
-                } else if(op == "!="){
-                    builder.AddInst(res_var + " = ne " + left_val + ", " + right_val);
-                }
-                return res_var;
+                koopa_raw_value_t left_val = eq_exp->GenKoopaIR();
+                koopa_raw_value_t right_val = rel_exp->GenKoopaIR();
+                return cur_ctx->builder.AddBinary(op == "==" ? KOOPA_RBO_EQ : KOOPA_RBO_NOT_EQ, left_val, right_val);
             } else {
                 return rel_exp->GenKoopaIR();
             }
         }
 
+        void GenCondIR(koopa_raw_basic_block_t true_bb, koopa_raw_basic_block_t false_bb) const override {
+            if(eq_exp) BaseAST::GenCondIR(true_bb, false_bb);
+            else rel_exp->GenCondIR(true_bb, false_bb);
+        }
+
         int CalcValue() const override {
             if(!eq_exp) return rel_exp->CalcValue();
             int left = eq_exp->CalcValue();
@@ -582,51 +666,59 @@ class EqExp : public BaseAST{
 
 class LAndExp : public BaseAST {
     public:
-        unique_ptr<BaseAST> eq_exp;
-        unique_ptr<BaseAST> land_exp;
+        BaseAST* eq_exp = nullptr;
+        BaseAST* land_exp = nullptr;
 
-        string GenKoopaIR() const override {
+        koopa_raw_value_t GenKoopaIR() const override {
             if(land_exp){
                                 // 为这个 && 表达式分配一个临时变量（指针），用于存储最终结果
-                string tmp_ptr = "@and_tmp_" + to_string(builder.GetUniqueId());
-                builder.AddAlloc(tmp_ptr + " = alloc i32");
+                koopa_raw_value_t tmp_ptr = cur_ctx->builder.AddLocalAlloc("@and_tmp_" + to_string(cur_ctx->builder.GetUniqueId()), -1);
+                koopa_raw_value_t zero = cur_ctx->builder.Integer(0);
 
                 // 生成左操作数，并转为布尔
-                string left_val = land_exp->GenKoopaIR();
-                string left_bool = builder.GetTmpVar();
-                builder.AddInst(left_bool + " = ne " + left_val + ", 0");
+                koopa_raw_value_t left_val = land_exp->GenKoopaIR();
+                koopa_raw_value_t left_bool = cur_ctx->builder.AddBinary(KOOPA_RBO_NOT_EQ, left_val, zero);
 
-                int id = builder.GetUniqueId();
-                string right_label = "%and_right_" + to_string(id);
-                string false_label = "%and_false_" + to_string(id);
-                string end_label = "%and_end_" + to_string(id);
+                string id = to_string(cur_ctx->builder.GetUniqueId());
+                koopa_raw_basic_block_t right_bb = cur_ctx->builder.NewBlock("%and_right_" + id);
+                koopa_raw_basic_block_t false_bb = cur_ctx->builder.NewBlock("%and_false_" + id);
+                koopa_raw_basic_block_t end_bb = cur_ctx->builder.NewBlock("%and_end_" + id);
 
                 // 根据 left_bool 分支
-                builder.EndWithBranch(left_bool, right_label, false_label);
+                cur_ctx->builder.EndWithBranch(left_bool, right_bb, false_bb);
 
                 // 右分支（left 为真）
-                builder.StartNewBlock(right_label);
-                string right_val = eq_exp->GenKoopaIR();
-                string right_bool = builder.GetTmpVar();
-                builder.AddInst(right_bool + " = ne " + right_val + ", 0");
-                builder.AddInst("store " + right_bool + ", " + tmp_ptr);  // 存储右分支结果
-                builder.EndWithJump(end_label);
+                cur_ctx->builder.StartNewBlock(right_bb);
+                koopa_raw_value_t right_val = eq_exp->GenKoopaIR();
+                koopa_raw_value_t right_bool = cur_ctx->builder.AddBinary(KOOPA_RBO_NOT_EQ, right_val, zero);
+                cur_ctx->builder.AddStore(right_bool, tmp_ptr);  // 存储右分支结果
+                cur_ctx->builder.EndWithJump(end_bb);
 
                 // 假分支（left 为假）
-                builder.StartNewBlock(false_label);
-                builder.AddInst("store 0, " + tmp_ptr);  // 结果直接为 0
-                builder.EndWithJump(end_label);
+                cur_ctx->builder.StartNewBlock(false_bb);
+                cur_ctx->builder.AddStore(zero, tmp_ptr);  // 结果直接为 0
+                cur_ctx->builder.EndWithJump(end_bb);
 
                 // 结束块：从临时变量加载最终结果
-                builder.StartNewBlock(end_label);
-                string result = builder.GetTmpVar();
-                builder.AddInst(result + " = load " + tmp_ptr);
-                return result;
+                cur_ctx->builder.StartNewBlock(end_bb);
+                return cur_ctx->builder.AddLoad(tmp_ptr);
             } else {
                 return eq_exp->GenKoopaIR();
             }
         }
 
+        // 短路求值：左边为假直接跳到 false_bb，不再经过临时变量
+        void GenCondIR(koopa_raw_basic_block_t true_bb, koopa_raw_basic_block_t false_bb) const override {
+            if(land_exp){
+                koopa_raw_basic_block_t right_bb = cur_ctx->builder.NewBlock("%and_right_" + to_string(cur_ctx->builder.GetUniqueId()));
+                land_exp->GenCondIR(right_bb, false_bb);
+                cur_ctx->builder.StartNewBlock(right_bb);
+                eq_exp->GenCondIR(true_bb, false_bb);
+            } else {
+                eq_exp->GenCondIR(true_bb, false_bb);
+            }
+        }
+
         int CalcValue() const override {
             if(land_exp){
                 return (land_exp->CalcValue() != 0) && (eq_exp->CalcValue() != 0);
@@ -638,49 +730,57 @@ class LAndExp : public BaseAST {
 
 class LOrExp : public BaseAST {
     public:
-        unique_ptr<BaseAST> land_exp;
-        unique_ptr<BaseAST> lor_exp;
+        BaseAST* land_exp = nullptr;
+        BaseAST* lor_exp = nullptr;
 
-        string GenKoopaIR() const override {
+        koopa_raw_value_t GenKoopaIR() const override {
             if(lor_exp){
-               string tmp_ptr = "@or_tmp_" + to_string(builder.GetUniqueId());
-                builder.AddAlloc(tmp_ptr + " = alloc i32");
+               koopa_raw_value_t tmp_ptr = cur_ctx->builder.AddLocalAlloc("@or_tmp_" + to_string(cur_ctx->builder.GetUniqueId()), -1);
+                koopa_raw_value_t zero = cur_ctx->builder.Integer(0);
 
                 // 左操作数
-                string left_val = lor_exp->GenKoopaIR();
-                string left_bool = builder.GetTmpVar();
-                builder.AddInst(left_bool + " = ne " + left_val + ", 0");
+                koopa_raw_value_t left_val = lor_exp->GenKoopaIR();
+                koopa_raw_value_t left_bool = cur_ctx->builder.AddBinary(KOOPA_RBO_NOT_EQ, left_val, zero);
 
-                int id = builder.GetUniqueId();
-                string true_label = "%or_true_" + to_string(id);
-                string right_label = "%or_right_" + to_string(id);
-                string end_label = "%or_end_" + to_string(id);
+                string id = to_string(cur_ctx->builder.GetUniqueId());
+                koopa_raw_basic_block_t true_bb = cur_ctx->builder.NewBlock("%or_true_" + id);
+                koopa_raw_basic_block_t right_bb = cur_ctx->builder.NewBlock("%or_right_" + id);
+                koopa_raw_basic_block_t end_bb = cur_ctx->builder.NewBlock("%or_end_" + id);
 
-                builder.EndWithBranch(left_bool, true_label, right_label);
+                cur_ctx->builder.EndWithBranch(left_bool, true_bb, right_bb);
 
                 // 真分支（left 为真）
-                builder.StartNewBlock(true_label);
-                builder.AddInst("store 1, " + tmp_ptr);  // 结果为 1
-                builder.EndWithJump(end_label);
+                cur_ctx->builder.StartNewBlock(true_bb);
+                cur_ctx->builder.AddStore(cur_ctx->builder.Integer(1), tmp_ptr);  // 结果为 1
+                cur_ctx->builder.EndWithJump(end_bb);
 
                 // 右分支（left 为假）
-                builder.StartNewBlock(right_label);
-                string right_val = land_exp->GenKoopaIR();
-                string right_bool = builder.GetTmpVar();
-                builder.AddInst(right_bool + " = ne " + right_val + ", 0");
-                builder.AddInst("store " + right_bool + ", " + tmp_ptr);
-                builder.EndWithJump(end_label);
+                cur_ctx->builder.StartNewBlock(right_bb);
+                koopa_raw_value_t right_val = land_exp->GenKoopaIR();
+                koopa_raw_value_t right_bool = cur_ctx->builder.AddBinary(KOOPA_RBO_NOT_EQ, right_val, zero);
+                cur_ctx->builder.AddStore(right_bool, tmp_ptr);
+                cur_ctx->builder.EndWithJump(end_bb);
 
                 // 结束块
-                builder.StartNewBlock(end_label);
-                string result = builder.GetTmpVar();
-                builder.AddInst(result + " = load " + tmp_ptr);
-                return result;
+                cur_ctx->builder.StartNewBlock(end_bb);
+                return cur_ctx->builder.AddLoad(tmp_ptr);
             } else {
                 return land_exp->GenKoopaIR();
             }
         }
 
+        // 短路求值：左边为真直接跳到 true_bb
+        void GenCondIR(koopa_raw_basic_block_t true_bb, koopa_raw_basic_block_t false_bb) const override {
+            if(lor_exp){
+                koopa_raw_basic_block_t right_bb = cur_ctx->builder.NewBlock("%or_right_" + to_string(cur_ctx->builder.GetUniqueId()));
+                lor_exp->GenCondIR(true_bb, right_bb);
+                cur_ctx->builder.StartNewBlock(right_bb);
+                land_exp->GenCondIR(true_bb, false_bb);
+            } else {
+                land_exp->GenCondIR(true_bb, false_bb);
+            }
+        }
+
         int CalcValue() const override {
             if(lor_exp){
                 return (land_exp->CalcValue() != 0) || (lor_exp->CalcValue() != 0);
@@ -692,9 +792,9 @@ class LOrExp : public BaseAST {
 
 class DeclAST : public BaseAST {
     public:
-        unique_ptr<BaseAST> const_decl;
-        unique_ptr<BaseAST> var_decl;
-        string GenKoopaIR() const override {
+        BaseAST* const_decl = nullptr;
+        BaseAST* var_decl = nullptr;
+        koopa_raw_value_t GenKoopaIR() const override {
             if(const_decl) {
                 return const_decl->GenKoopaIR();
             } else {
@@ -705,31 +805,31 @@ class DeclAST : public BaseAST {
 
 class ConstDeclAST : public BaseAST {
     public:
-        std::vector<std::unique_ptr<BaseAST>> const_defs;
-        unique_ptr<BaseAST> b_type;
-        string GenKoopaIR() const override {
+        vector<BaseAST*> const_defs;
+        BaseAST* b_type = nullptr;
+        koopa_raw_value_t GenKoopaIR() const override {
             for (const auto& def : const_defs) {
                 def->GenKoopaIR();
             }
-            return "";
+            return nullptr;
         }
 };
 
 class BTypeAST : public BaseAST {
     public:
         string type = "int";
-        string GenKoopaIR() const override {
-            return type;
+        koopa_raw_value_t GenKoopaIR() const override {
+            return nullptr;
         }
 };
 class ConstInitValAST : public BaseAST {
     public:
         bool is_array = false;
-        unique_ptr<BaseAST> const_exp;
-        vector<unique_ptr<BaseAST>> init_list;
-        string GenKoopaIR() const override {
+        BaseAST* const_exp = nullptr;
+        vector<BaseAST*> init_list;
+        koopa_raw_value_t GenKoopaIR() const override {
             if(!is_array) return const_exp->GenKoopaIR();
-            return "";
+            return nullptr;
         }
 
         int CalcValue() const override {
@@ -737,33 +837,30 @@ class ConstInitValAST : public BaseAST {
             return 0;
         }
 
-        string GetGlobalInitStr(int expected_len) const {
-            if (!is_array) return to_string(const_exp->CalcValue());
-            string res = "{";
+        vector<int> GetGlobalInitVals(int expected_len) const {
+            if (!is_array) return {const_exp->CalcValue()};
+            vector<int> res;
             for (int i = 0; i < expected_len; ++i) {
-                if (i < init_list.size()) {
-                    res += to_string(init_list[i]->CalcValue());
+                if (i < (int)init_list.size()) {
+                    res.push_back(init_list[i]->CalcValue());
                 } else {
-                    res += "0";
+                    res.push_back(0);
                 }
-                if (i != expected_len - 1) res += ", ";
             }
-            res += "}";
             return res;
         }
 
-        void GenLocalInitIR(const string& base_ptr, int expected_len) const {
+        void GenLocalInitIR(koopa_raw_value_t base_ptr, int expected_len) const {
             for (int i = 0; i < expected_len; ++i) {
-                string elem_ptr = builder.GetTmpVar();
-                builder.AddInst(elem_ptr + " = getelemptr " + base_ptr + ", " + to_string(i));
+                koopa_raw_value_t elem_ptr = cur_ctx->builder.AddGetElemPtr(base_ptr, cur_ctx->builder.Integer(i));
                 
-                string val_name;
-                if (i < init_list.size()) {
-                    val_name = init_list[i]->GenKoopaIR();
+                koopa_raw_value_t val;
+                if (i < (int)init_list.size()) {
+                    val = init_list[i]->GenKoopaIR();
                 } else {
-                    val_name = "0";
+                    val = cur_ctx->builder.Integer(0);
                 }
-                builder.AddInst("store " + val_name + ", " + elem_ptr);
+                cur_ctx->builder.AddStore(val, elem_ptr);
             }
         }
 };
@@ -771,38 +868,39 @@ class ConstInitValAST : public BaseAST {
 
 class ConstDefAST : public BaseAST {    
     public:
-        string ident;
-        unique_ptr<BaseAST> const_init_val;
-        unique_ptr<BaseAST> array_len;
-
-        string GenKoopaIR() const override {
-            string var_name = is_in_global ? "@" + ident : "@" + ident + "_" + to_string(builder.GetUniqueId());
+        SymbolId ident = -1;
+        BaseAST* const_init_val = nullptr;
+        BaseAST* array_len = nullptr;
 
+        koopa_raw_value_t GenKoopaIR() const override {
             if(!array_len){
                 int real_value = const_init_val->CalcValue();
-                SymbolEntry entry = {SymbolType::CONSTANT, real_value, var_name};
-                if (!sym_table.Insert(ident, entry)) {
-                    cerr << "Semantic Error: Redefinition of symbol '" << ident << "'" << endl;
-                    exit(1);
+                SymbolEntry entry = {SymbolType::CONSTANT, real_value};
+                if (!cur_ctx->sym_table.Insert(ident, entry)) {
+                    *cur_ctx->diag << "Semantic Error: Redefinition of symbol '" << cur_ctx->ident_table.Name(ident) << "'" << endl;
+                    throw CompileError();
                 }
             }else{
-                SymbolEntry entry = {SymbolType::CONSTANT, 0, var_name}; // 数组常量的 int_val 字段暂不使用
-                if (!sym_table.Insert(ident, entry)) {
-                    cerr << "Semantic Error: Redefinition of symbol '" << ident << "'" << endl;
-                    exit(1);
-                }
-
+                string var_name = cur_ctx->is_in_global ? "@" + cur_ctx->ident_table.Name(ident) : "@" + cur_ctx->ident_table.Name(ident) + "_" + to_string(cur_ctx->builder.GetUniqueId());
                 int len = array_len->CalcValue();
-                string type_str = "[i32," + to_string(len) + "]";
-                if(is_in_global){
-                    string init_str = static_cast<ConstInitValAST*>(const_init_val.get())->GetGlobalInitStr(len);
-                    builder.AddGlobalDecl("global " + var_name + " = alloc " + type_str + ", " + init_str);
+                koopa_raw_value_t var;
+                if(cur_ctx->is_in_global){
+                    vector<int> init = static_cast<ConstInitValAST*>(const_init_val)->GetGlobalInitVals(len);
+                    var = cur_ctx->builder.AddGlobalAlloc(var_name, len, init);
                 }else{
-                    builder.AddAlloc(var_name + " = alloc " + type_str);
-                    static_cast<ConstInitValAST*>(const_init_val.get())->GenLocalInitIR(var_name, len);
+                    var = cur_ctx->builder.AddLocalAlloc(var_name, len);
+                }
+
+                SymbolEntry entry = {SymbolType::CONSTANT, 0, var}; // 数组常量的 int_val 字段暂不使用
+                if (!cur_ctx->sym_table.Insert(ident, entry)) {
+                    *cur_ctx->diag << "Semantic Error: Redefinition of symbol '" << cur_ctx->ident_table.Name(ident) << "'" << endl;
+                    throw CompileError();
+                }
+                if(!cur_ctx->is_in_global){
+                    static_cast<ConstInitValAST*>(const_init_val)->GenLocalInitIR(var, len);
                 }
             }
-            return "";
+            return nullptr;
         }
 };
 
@@ -810,9 +908,9 @@ class ConstDefAST : public BaseAST {
 
 class ConstExpAST : public BaseAST {
     public:
-        unique_ptr<BaseAST> exp;
+        BaseAST* exp = nullptr;
 
-        string GenKoopaIR() const override {
+        koopa_raw_value_t GenKoopaIR() const override {
             return exp->GenKoopaIR();
         }
 
@@ -823,26 +921,26 @@ class ConstExpAST : public BaseAST {
 
 class VarDeclAST : public BaseAST {
     public:
-        vector<unique_ptr<BaseAST> > var_defs;
-        unique_ptr<BaseAST> b_type;
+        vector<BaseAST*> var_defs;
+        BaseAST* b_type = nullptr;
 
 
-        string GenKoopaIR() const override {
+        koopa_raw_value_t GenKoopaIR() const override {
             for(const auto& def: var_defs){
                 def->GenKoopaIR();
             }
-            return "";
+            return nullptr;
         }
 };
 
 class InitValAST : public BaseAST {
     public:
         bool is_array = false;
-        unique_ptr<BaseAST> exp;
-        vector<unique_ptr<BaseAST>> init_list;
-        string GenKoopaIR() const override {
+        BaseAST* exp = nullptr;
+        vector<BaseAST*> init_list;
+        koopa_raw_value_t GenKoopaIR() const override {
             if(!is_array) return exp->GenKoopaIR();
-            return "";
+            return nullptr;
         }
 
         int CalcValue() const override {
@@ -850,33 +948,30 @@ class InitValAST : public BaseAST {
             return 0;
         }
 
-        string GetGlobalInitStr(int len) const {
-            if(!is_array) return to_string(exp->CalcValue());
-            string ret = "{";
+        vector<int> GetGlobalInitVals(int len) const {
+            if(!is_array) return {exp->CalcValue()};
+            vector<int> ret;
             for(int i = 0; i < len; ++i){
-                if (i < init_list.size()) {
-                    ret += to_string(init_list[i]->CalcValue());
+                if (i < (int)init_list.size()) {
+                    ret.push_back(init_list[i]->CalcValue());
                 } else {
-                    ret += "0"; // 补齐 0
+                    ret.push_back(0); // 补齐 0
                 }
-                if (i != len - 1) ret += ", ";
             }
-            ret += "}";
             return ret;
         }
 
-        void GenLocalInitIR(const string& base_ptr, int len) const {
+        void GenLocalInitIR(koopa_raw_value_t base_ptr, int len) const {
             for(int i = 0; i < len; i++){
-                string elem_ptr = builder.GetTmpVar();
-                builder.AddInst(elem_ptr + " = getelemptr " + base_ptr + ", " + to_string(i));
+                koopa_raw_value_t elem_ptr = cur_ctx->builder.AddGetElemPtr(base_ptr, cur_ctx->builder.Integer(i));
 
-                string val_name;
-                if (i < init_list.size()) {
-                    val_name = init_list[i]->GenKoopaIR();
+                koopa_raw_value_t val;
+                if (i < (int)init_list.size()) {
+                    val = init_list[i]->GenKoopaIR();
                 } else {
-                    val_name = "0"; // 局部数组未显式初始化的部分也要清零
+                    val = cur_ctx->builder.Integer(0); // 局部数组未显式初始化的部分也要清零
                 }
-                builder.AddInst("store " + val_name + ", " + elem_ptr);
+                cur_ctx->builder.AddStore(val, elem_ptr);
             }
         }
 };
@@ -885,100 +980,77 @@ class InitValAST : public BaseAST {
 
 class VarDefAST : public BaseAST {
     public:
-        string ident;
-        unique_ptr<BaseAST> init_val; // 可以为 nullptr，表示未初始化
-        unique_ptr<BaseAST> array_len;
-
-        string GenKoopaIR() const override {
+        SymbolId ident = -1;
+        BaseAST* init_val = nullptr; // 可以为 nullptr，表示未初始化
+        BaseAST* array_len = nullptr;
+
+        koopa_raw_value_t GenKoopaIR() const override {
+
+            //为变量生成一个koopa IR中的变量名
+            string var_name = cur_ctx->is_in_global ? "@" + cur_ctx->ident_table.Name(ident) : "@" + cur_ctx->ident_table.Name(ident) + "_" + to_string(cur_ctx->builder.GetUniqueId());
+            int len = array_len ? array_len->CalcValue() : -1;
+            koopa_raw_value_t var;
+            if(cur_ctx->is_in_global){
+                vector<int> init;
+                if(!array_len){
+                    init = {init_val ? init_val->CalcValue() : 0};
+                }else if(init_val){
+                    init = static_cast<InitValAST*>(init_val)->GetGlobalInitVals(len);
+                }
+                var = cur_ctx->builder.AddGlobalAlloc(var_name, len, init);   //数组没有初始值时是 zeroinit
+            }else{
+                var = cur_ctx->builder.AddLocalAlloc(var_name, len);
+            }
 
-            //为变量生成一个koopa IR中的临时变量名
-            string var_name = is_in_global ? "@" + ident : "@" + ident + "_" + to_string(builder.GetUniqueId());
-            SymbolEntry entry = {SymbolType::VARIABLE, 0, var_name};
-            if (!sym_table.Insert(ident, entry)) {
-                cerr << "Semantic Error: Redefinition of symbol '" << ident << "'" << endl;
-                exit(1);
+            SymbolEntry entry = {SymbolType::VARIABLE, 0, var};
+            if (!cur_ctx->sym_table.Insert(ident, entry)) {
+                *cur_ctx->diag << "Semantic Error: Redefinition of symbol '" << cur_ctx->ident_table.Name(ident) << "'" << endl;
+                throw CompileError();
             }
 
-            if(!array_len){
-                if(is_in_global){
-                    int val = init_val ? init_val->CalcValue() : 0;
-                    builder.AddGlobalDecl("global " + var_name + " = alloc i32, " + to_string(val));
-                }else {
-                    builder.AddAlloc(var_name + " = alloc i32");
-                    if (init_val) {
-                        string val_name = init_val->GenKoopaIR();
-                        builder.AddInst("store " + val_name + ", " + var_name);
-                    }
-                }
-            }else{
-                //对于数组的生成ir环节
-                int len = array_len->CalcValue();
-                string type_str = "[i32," + to_string(len) + "]";
-                if(is_in_global){
-                    if(init_val){
-                        string init_str = static_cast<InitValAST*>(init_val.get())->GetGlobalInitStr(len);
-                        builder.AddGlobalDecl("global " + var_name + " = alloc " + type_str + ", " + init_str);
-                    }else{
-                        builder.AddGlobalDecl("global " + var_name + " = alloc " + type_str + ",zeorinit");
-                    }
+            //局部变量的初始值在变量登记之后生成
+            if(!cur_ctx->is_in_global && init_val){
+                if(!array_len){
+                    koopa_raw_value_t val = init_val->GenKoopaIR();
+                    cur_ctx->builder.AddStore(val, var);
                 }else{
-                    builder.AddAlloc(var_name +  " = alloc " + type_str);
-                    if(init_val){
-                        static_cast<InitValAST*>(init_val.get())->GenLocalInitIR(var_name,len);
-                    }
+                    static_cast<InitValAST*>(init_val)->GenLocalInitIR(var, len);
                 }
             }
-            return "";
+            return nullptr;
         }
 };
 
 
 class WhileAST: public BaseAST{
     public:
-        unique_ptr<BaseAST> cond;
-        unique_ptr<BaseAST> stmt;
-
-    string GenKoopaIR() const override {
-        int id = builder.GetUniqueId();
-        string entry_label = "%while_entry_" + to_string(id);
-        string body_label = "%while_body_" + to_string(id);
-        string end_label = "%while_end_" + to_string(id);
-        builder.EndWithJump(entry_label);
-        builder.StartNewBlock(entry_label);
-        string cond_val = cond->GenKoopaIR();
-        builder.EndWithBranch(cond_val, body_label, end_label);
-        builder.StartNewBlock(body_label);
-
-        builder.Pushloop(entry_label, end_label);
+        BaseAST* cond = nullptr;
+        BaseAST* stmt = nullptr;
+
+    koopa_raw_value_t GenKoopaIR() const override {
+        string id = to_string(cur_ctx->builder.GetUniqueId());
+        koopa_raw_basic_block_t entry_bb = cur_ctx->builder.NewBlock("%while_entry_" + id);
+        koopa_raw_basic_block_t body_bb = cur_ctx->builder.NewBlock("%while_body_" + id);
+        koopa_raw_basic_block_t end_bb = cur_ctx->builder.NewBlock("%while_end_" + id);
+        cur_ctx->builder.EndWithJump(entry_bb);
+        cur_ctx->builder.StartNewBlock(entry_bb);
+        cond->GenCondIR(body_bb, end_bb);
+        cur_ctx->builder.StartNewBlock(body_bb);
+
+        cur_ctx->builder.Pushloop(entry_bb, end_bb);
         if(stmt){
             stmt->GenKoopaIR();
         }
 
-        builder.Poploop();
-        builder.EndWithJump(entry_label);
-        builder.StartNewBlock(end_label);
+        cur_ctx->builder.Poploop();
+        cur_ctx->builder.EndWithJump(entry_bb);
+        cur_ctx->builder.StartNewBlock(end_bb);
 
-        return "";
+        return nullptr;
     }
 };
 
 
-class FuncRParamsAST : public BaseAST {
-    public:
-        vector<unique_ptr<BaseAST>> exps;
-        string GenKoopaIR() const override {
-             string args_str = "";
-            for (size_t i = 0; i < exps.size(); ++i) {
-                // 计算每个实参的 IR，并获取对应的临时变量名/常量值
-                string arg_val = exps[i]->GenKoopaIR();
-                args_str += arg_val;
-                if (i != exps.size() - 1) {
-                    args_str += ", ";
-                }
-            }
-            return args_str;
-        }
-};
 
 
 //定义functype
@@ -0,0 +1,220 @@
+#include "cache.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <functional>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+using namespace std;
+
+//换了键的算法或者输出格式时改这个版本号，旧条目自然失效
+static const char *kCacheVersion = "sysy-cache-1";
+
+static uint32_t Rotr(uint32_t x, int n){
+    return (x >> n) | (x << (32 - n));
+}
+
+//FIPS 180-4 SHA-256，返回 64 位十六进制串
+static string Sha256(const string &data){
+    static const uint32_t k[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+    };
+    uint32_t h[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+    //补位：0x80，若干个 0，最后 8 字节是位长度（大端）
+    string msg = data;
+    uint64_t bits = (uint64_t) data.size() * 8;
+    msg.push_back((char) 0x80);
+    while(msg.size() % 64 != 56) msg.push_back(0);
+    for(int i = 7; i >= 0; i--) msg.push_back((char) (bits >> (i * 8)));
+
+    for(size_t off = 0; off < msg.size(); off += 64){
+        uint32_t w[64];
+        for(int i = 0; i < 16; i++){
+            const unsigned char *p = (const unsigned char *) msg.data() + off + i * 4;
+            w[i] = (uint32_t) p[0] << 24 | (uint32_t) p[1] << 16 | (uint32_t) p[2] << 8 | p[3];
+        }
+        for(int i = 16; i < 64; i++){
+            uint32_t s0 = Rotr(w[i - 15], 7) ^ Rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = Rotr(w[i - 2], 17) ^ Rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4], f = h[5], g = h[6], hh = h[7];
+        for(int i = 0; i < 64; i++){
+            uint32_t t1 = hh + (Rotr(e, 6) ^ Rotr(e, 11) ^ Rotr(e, 25)) + ((e & f) ^ (~e & g)) + k[i] + w[i];
+            uint32_t t2 = (Rotr(a, 2) ^ Rotr(a, 13) ^ Rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            hh = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+        h[0] += a; h[1] += b; h[2] += c; h[3] += d;
+        h[4] += e; h[5] += f; h[6] += g; h[7] += hh;
+    }
+
+    char hex[65];
+    for(int i = 0; i < 8; i++) snprintf(hex + i * 8, 9, "%08x", h[i]);
+    return string(hex, 64);
+}
+
+static bool ReadFile(const string &path, string &data){
+    ifstream in(path, ios::binary);
+    if(!in) return false;
+    ostringstream ss;
+    ss << in.rdbuf();
+    data = ss.str();
+    return true;
+}
+
+static bool CopyFile(const string &from, const string &to){
+    ifstream in(from, ios::binary);
+    ofstream out(to, ios::binary | ios::trunc);
+    if(!in || !out) return false;
+    out << in.rdbuf();
+    return (bool) out;
+}
+
+//条目名是 64 位十六进制的键，目录里的其他文件（stats、写了一半的临时文件）不算
+static bool IsEntry(const string &name){
+    return name.size() == 64 && all_of(name.begin(), name.end(), [](char c){ return isxdigit((unsigned char) c); });
+}
+
+CompileCache::CompileCache(const string &dir, uint64_t max_bytes) : dir(dir), max_bytes(max_bytes) {
+    if(!dir.empty()) mkdir(dir.c_str(), 0755);
+}
+
+string CompileCache::Key(const CompileOptions &opt){
+    //每一段前面加上长度，不同的切分不会拼出同一个串
+    string material;
+    auto add = [&](const string &part){
+        material += to_string(part.size()) + ":" + part;
+    };
+    add(kCacheVersion);
+    //编译器重新构建后可执行文件的大小或修改时间会变，旧的输出不再可信
+    struct stat exe;
+    if(stat("/proc/self/exe", &exe) == 0){
+        add(to_string(exe.st_size) + "." + to_string(exe.st_mtim.tv_sec) + "." + to_string(exe.st_mtim.tv_nsec));
+    }
+    add(opt.mode);
+    string data;
+    if(!ReadFile(opt.input_file, data)) return "";
+    add(data);
+    if(!opt.profile_use.empty()){
+        if(!ReadFile(opt.profile_use, data)) return "";
+        add(data);
+    }else{
+        add("");
+    }
+    return Sha256(material);
+}
+
+bool CompileCache::Fetch(const string &key, const string &output_file){
+    string entry = dir + "/" + key;
+    //更新修改时间，淘汰时按它判断最近使用
+    if(utimensat(AT_FDCWD, entry.c_str(), nullptr, 0) != 0){
+        AddStat(false);
+        return false;
+    }
+    //复制而不是硬链接：输出文件之后可能被不带 -cache 的编译原地覆盖，和条目共用 inode 会把条目一起改掉
+    if(!CopyFile(entry, output_file)){
+        AddStat(false);
+        return false;
+    }
+    AddStat(true);
+    return true;
+}
+
+void CompileCache::Store(const string &key, const string &output_file){
+    //先写到临时文件再改名，其他进程不会读到写了一半的条目
+    string tmp = dir + "/tmp." + to_string(getpid()) + "." + to_string(hash<thread::id>()(this_thread::get_id()));
+    if(!CopyFile(output_file, tmp) || rename(tmp.c_str(), (dir + "/" + key).c_str()) != 0){
+        unlink(tmp.c_str());
+        return;
+    }
+    Evict();
+}
+
+void CompileCache::Evict(){
+    struct Entry {
+        string path;
+        uint64_t size;
+        timespec mtime;
+    };
+    vector<Entry> entries;
+    uint64_t total = 0;
+    DIR *d = opendir(dir.c_str());
+    if(!d) return;
+    while(dirent *ent = readdir(d)){
+        if(!IsEntry(ent->d_name)) continue;
+        string path = dir + "/" + ent->d_name;
+        struct stat st;
+        if(stat(path.c_str(), &st) != 0) continue;
+        entries.push_back({path, (uint64_t) st.st_size, st.st_mtim});
+        total += st.st_size;
+    }
+    closedir(d);
+    if(total <= max_bytes) return;
+
+    sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b){
+        return a.mtime.tv_sec != b.mtime.tv_sec ? a.mtime.tv_sec < b.mtime.tv_sec : a.mtime.tv_nsec < b.mtime.tv_nsec;
+    });
+    for(const Entry &e : entries){
+        if(total <= max_bytes) break;
+        //别的进程可能已经删掉了
+        unlink(e.path.c_str());
+        total -= e.size;
+    }
+}
+
+void CompileCache::AddStat(bool hit){
+    int fd = open((dir + "/stats").c_str(), O_RDWR | O_CREAT, 0644);
+    if(fd < 0) return;
+    flock(fd, LOCK_EX);
+    char buf[64] = {0};
+    unsigned long long hits = 0, misses = 0;
+    if(pread(fd, buf, sizeof(buf) - 1, 0) > 0) sscanf(buf, "%llu %llu", &hits, &misses);
+    (hit ? hits : misses)++;
+    //计数只增不减，新内容不会比旧内容短，不用截断
+    int len = snprintf(buf, sizeof(buf), "%llu %llu\n", hits, misses);
+    if(pwrite(fd, buf, len, 0) != len){
+        cerr << "警告：无法更新缓存统计 " << dir << "/stats" << endl;
+    }
+    flock(fd, LOCK_UN);
+    close(fd);
+}
+
+void CompileCache::WriteStats(ostream &os) const {
+    unsigned long long hits = 0, misses = 0;
+    string data;
+    if(ReadFile(dir + "/stats", data)) sscanf(data.c_str(), "%llu %llu", &hits, &misses);
+    uint64_t entries = 0, total = 0;
+    if(DIR *d = opendir(dir.c_str())){
+        while(dirent *ent = readdir(d)){
+            struct stat st;
+            if(!IsEntry(ent->d_name) || stat((dir + "/" + ent->d_name).c_str(), &st) != 0) continue;
+            entries++;
+            total += st.st_size;
+        }
+        closedir(d);
+    }
+    unsigned long long lookups = hits + misses;
+    os << "hits: " << hits << "\n";
+    os << "misses: " << misses << "\n";
+    os << "hit_rate: " << (lookups ? 100.0 * hits / lookups : 0.0) << "%\n";
+    os << "entries: " << entries << "\n";
+    os << "bytes: " << total << " / " << max_bytes << "\n";
+}
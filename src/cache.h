@@ -0,0 +1,31 @@
+#pragma once
+#include "driver.h"
+#include <cstdint>
+#include <ostream>
+#include <string>
+using namespace std;
+
+//-cache DIR：按内容寻址的编译缓存，只缓存 -koopa 和 -riscv 的输出
+//键是输入内容、模式、-fprofile-use 的内容和编译器本身（可执行文件的大小和修改时间）的 SHA-256，条目是 DIR/键
+//命中时把条目复制到输出路径；条目的修改时间就是最近使用时间，总大小超过上限时淘汰最旧的
+//命中和未命中的次数记在 DIR/stats 里，多个进程和 -daemon 的多个线程共用时用 flock 互斥
+class CompileCache {
+public:
+    CompileCache(const string &dir, uint64_t max_bytes);
+
+    //读不到输入或 profile 时返回空串，这次编译不走缓存
+    static string Key(const CompileOptions &opt);
+    //命中时输出已经放好，返回 true
+    bool Fetch(const string &key, const string &output_file);
+    //编译成功后把输出存进缓存，必要时淘汰旧条目
+    void Store(const string &key, const string &output_file);
+    //命中率、条目数和总大小，-cache-stats 用
+    void WriteStats(ostream &os) const;
+
+private:
+    string dir;
+    uint64_t max_bytes;
+
+    void AddStat(bool hit);
+    void Evict();
+};
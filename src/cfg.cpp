@@ -0,0 +1,165 @@
+#include "cfg.h"
+#include "irutil.h"
+#include <algorithm>
+using namespace std;
+
+CFG::CFG(koopa_raw_function_t func){
+    if(func->bbs.len == 0) return;
+
+    //非递归 DFS 求后序，再反转得到逆后序
+    koopa_raw_basic_block_t entry = (koopa_raw_basic_block_t) func->bbs.buffer[0];
+    unordered_map<koopa_raw_basic_block_t, bool> visited;
+    vector<pair<koopa_raw_basic_block_t, vector<koopa_raw_basic_block_t>>> stack;
+    vector<koopa_raw_basic_block_t> post_order;
+    visited[entry] = true;
+    stack.push_back({entry, GetSuccessors(entry)});
+    while(!stack.empty()){
+        auto &top = stack.back();
+        if(top.second.empty()){
+            post_order.push_back(top.first);
+            stack.pop_back();
+            continue;
+        }
+        //按原顺序访问后继
+        koopa_raw_basic_block_t next = top.second.front();
+        top.second.erase(top.second.begin());
+        if(!visited[next]){
+            visited[next] = true;
+            stack.push_back({next, GetSuccessors(next)});
+        }
+    }
+    blocks.assign(post_order.rbegin(), post_order.rend());
+    for(size_t i = 0; i < blocks.size(); i++){
+        index[blocks[i]] = i;
+    }
+
+    preds.resize(blocks.size());
+    succs.resize(blocks.size());
+    for(size_t i = 0; i < blocks.size(); i++){
+        for(auto s : GetSuccessors(blocks[i])){
+            int j = index[s];
+            succs[i].push_back(j);
+            preds[j].push_back(i);
+        }
+    }
+    ComputeDominators();
+}
+
+//Cooper, Harvey, Kennedy 的迭代算法
+void CFG::ComputeDominators(){
+    int n = blocks.size();
+    idom.assign(n, -1);
+    idom[0] = 0;
+    auto intersect = [&](int a, int b){
+        while(a != b){
+            while(a > b) a = idom[a];
+            while(b > a) b = idom[b];
+        }
+        return a;
+    };
+    bool changed = true;
+    while(changed){
+        changed = false;
+        for(int i = 1; i < n; i++){
+            int new_idom = -1;
+            for(int p : preds[i]){
+                if(idom[p] < 0) continue;
+                new_idom = new_idom < 0 ? p : intersect(p, new_idom);
+            }
+            if(new_idom != idom[i]){
+                idom[i] = new_idom;
+                changed = true;
+            }
+        }
+    }
+    dom_children.assign(n, {});
+    for(int i = 1; i < n; i++){
+        dom_children[idom[i]].push_back(i);
+    }
+}
+
+bool CFG::Dominates(int a, int b) const {
+    //逆后序中支配者的编号一定更小
+    while(b > a){
+        b = idom[b];
+    }
+    return a == b;
+}
+
+vector<vector<int>> CFG::ComputeFrontier() const {
+    int n = blocks.size();
+    vector<vector<int>> frontier(n);
+    for(int i = 0; i < n; i++){
+        if(preds[i].size() < 2) continue;
+        for(int p : preds[i]){
+            int runner = p;
+            while(runner != idom[i]){
+                if(find(frontier[runner].begin(), frontier[runner].end(), i) == frontier[runner].end()){
+                    frontier[runner].push_back(i);
+                }
+                runner = idom[runner];
+            }
+        }
+    }
+    return frontier;
+}
+
+vector<Loop> CFG::FindLoops() const {
+    int n = blocks.size();
+    vector<Loop> loops;
+    for(int h = 0; h < n; h++){
+        Loop loop;
+        loop.header = h;
+        for(int u : preds[h]){
+            if(Dominates(h, u)) loop.latches.push_back(u);
+        }
+        if(loop.latches.empty()) continue;
+        //从回边的起点沿前驱反向搜索，直到循环头为止
+        vector<bool> in_loop(n, false);
+        in_loop[h] = true;
+        vector<int> work;
+        for(int u : loop.latches){
+            if(!in_loop[u]){
+                in_loop[u] = true;
+                work.push_back(u);
+            }
+        }
+        while(!work.empty()){
+            int b = work.back();
+            work.pop_back();
+            for(int p : preds[b]){
+                if(!in_loop[p]){
+                    in_loop[p] = true;
+                    work.push_back(p);
+                }
+            }
+        }
+        for(int b = 0; b < n; b++){
+            if(in_loop[b]) loop.blocks.push_back(b);
+        }
+        loops.push_back(move(loop));
+    }
+
+    //外层循环一定比内层大；直接外层是包含自己 header 的最小的那个
+    stable_sort(loops.begin(), loops.end(), [](const Loop &a, const Loop &b){
+        return a.blocks.size() > b.blocks.size();
+    });
+    for(size_t i = 0; i < loops.size(); i++){
+        for(size_t j = i; j-- > 0;){
+            if(binary_search(loops[j].blocks.begin(), loops[j].blocks.end(), loops[i].header)){
+                loops[i].parent = j;
+                loops[i].depth = loops[j].depth + 1;
+                break;
+            }
+        }
+    }
+    return loops;
+}
+
+vector<int> CFG::ComputeLoopDepth() const {
+    vector<int> depth(blocks.size(), 0);
+    for(const Loop &loop : FindLoops()){
+        for(int b : loop.blocks) depth[b]++;
+    }
+    return depth;
+}
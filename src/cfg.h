@@ -0,0 +1,41 @@
+#pragma once
+#include "koopa.h"
+#include <vector>
+#include <unordered_map>
+using namespace std;
+
+//自然循环：header 支配所有回边（latch -> header）的起点，同一个 header 的回边合并成一个循环
+//块都用 CFG 中的编号
+struct Loop {
+    int header;
+    vector<int> latches;
+    vector<int> blocks;     //包括 header，按编号排序
+    int parent = -1;        //直接外层循环在 FindLoops 结果中的下标
+    int depth = 1;
+};
+
+//函数的控制流图与支配树，只包含从入口可达的基本块
+//块用逆后序编号：blocks[0] 是入口块
+class CFG {
+public:
+    explicit CFG(koopa_raw_function_t func);
+
+    vector<koopa_raw_basic_block_t> blocks;
+    unordered_map<koopa_raw_basic_block_t, int> index;
+    vector<vector<int>> preds;
+    vector<vector<int>> succs;
+    vector<int> idom;                   //入口块的 idom 是它自己
+    vector<vector<int>> dom_children;
+
+    int Size() const { return blocks.size(); }
+    bool Dominates(int a, int b) const;
+    //支配边界，按需计算
+    vector<vector<int>> ComputeFrontier() const;
+    //全部自然循环，外层循环排在内层之前
+    vector<Loop> FindLoops() const;
+    //每个块所在自然循环的层数
+    vector<int> ComputeLoopDepth() const;
+
+private:
+    void ComputeDominators();
+};
@@ -0,0 +1,238 @@
+#include "constfold.h"
+#include "cfg.h"
+#include "irutil.h"
+#include <array>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+using namespace std;
+
+namespace {
+
+//格：UNDEF（还没有信息）> CONST > OVERDEFINED
+struct Lattice {
+    enum Kind { UNDEF, CONST, OVER } kind = UNDEF;
+    int32_t value = 0;
+
+    bool operator!=(const Lattice &o) const {
+        return kind != o.kind || (kind == CONST && value != o.value);
+    }
+};
+
+Lattice Meet(const Lattice &a, const Lattice &b){
+    if(a.kind == Lattice::UNDEF) return b;
+    if(b.kind == Lattice::UNDEF) return a;
+    if(a.kind == Lattice::CONST && b.kind == Lattice::CONST && a.value == b.value) return a;
+    return {Lattice::OVER, 0};
+}
+
+Lattice Const(int32_t v){
+    return {Lattice::CONST, v};
+}
+
+} // namespace
+
+void ConstFoldPass::Run(const koopa_raw_program_t &program){
+    for(size_t i = 0; i < program.funcs.len; i++){
+        koopa_raw_function_t func = (koopa_raw_function_t) program.funcs.buffer[i];
+        if(func->bbs.len == 0) continue;
+        RunOnFunction(func);
+    }
+}
+
+void ConstFoldPass::RunOnFunction(koopa_raw_function_t func){
+    CFG cfg(func);
+    int n = cfg.Size();
+
+    //只有二元运算和基本块参数参与传播，其余的值（load、call、函数参数……）都是 OVER
+    unordered_map<koopa_raw_value_t, Lattice> state;
+    auto get = [&](koopa_raw_value_t v) -> Lattice {
+        if(v->kind.tag == KOOPA_RVT_INTEGER) return Const(v->kind.data.integer.value);
+        auto it = state.find(v);
+        if(it != state.end()) return it->second;
+        if(v->kind.tag == KOOPA_RVT_BINARY || v->kind.tag == KOOPA_RVT_BLOCK_ARG_REF) return {};
+        return {Lattice::OVER, 0};
+    };
+    bool changed = true;
+    auto update = [&](koopa_raw_value_t v, const Lattice &l){
+        Lattice &cur = state[v];
+        if(cur != l){
+            cur = l;
+            changed = true;
+        }
+    };
+
+    auto eval = [&](koopa_raw_value_t inst) -> Lattice {
+        const auto &bin = inst->kind.data.binary;
+        Lattice l = get(bin.lhs), r = get(bin.rhs);
+        //与另一个操作数无关的情形：x * 0、x & 0、x - x、x == x ……
+        bool l_zero = l.kind == Lattice::CONST && l.value == 0;
+        bool r_zero = r.kind == Lattice::CONST && r.value == 0;
+        if((bin.op == KOOPA_RBO_MUL || bin.op == KOOPA_RBO_AND) && (l_zero || r_zero)) return Const(0);
+        if(bin.lhs == bin.rhs && l.kind != Lattice::UNDEF){
+            switch(bin.op){
+                case KOOPA_RBO_SUB: case KOOPA_RBO_XOR: case KOOPA_RBO_NOT_EQ:
+                case KOOPA_RBO_LT: case KOOPA_RBO_GT:
+                    return Const(0);
+                case KOOPA_RBO_EQ: case KOOPA_RBO_LE: case KOOPA_RBO_GE:
+                    return Const(1);
+                default:
+                    break;
+            }
+        }
+        if(l.kind == Lattice::OVER || r.kind == Lattice::OVER) return {Lattice::OVER, 0};
+        if(l.kind == Lattice::UNDEF || r.kind == Lattice::UNDEF) return {};
+        int32_t res;
+        if(!EvalBinary(bin.op, l.value, r.value, res)) return {Lattice::OVER, 0};
+        return Const(res);
+    };
+
+    //exec_out[b][0]：jump 或 br 的真分支这条边可执行；exec_out[b][1]：br 的假分支
+    vector<bool> exec_block(n, false);
+    vector<array<bool, 2>> exec_out(n, {false, false});
+    exec_block[0] = true;
+    auto mark_edge = [&](int b, int k, koopa_raw_basic_block_t target){
+        if(!exec_out[b][k]){
+            exec_out[b][k] = true;
+            changed = true;
+        }
+        int t = cfg.index[target];
+        if(!exec_block[t]){
+            exec_block[t] = true;
+            changed = true;
+        }
+    };
+
+    //按逆后序反复扫描直到不动点，格只会单调下降，所以一定会结束
+    while(changed){
+        changed = false;
+        for(int b = 0; b < n; b++){
+            if(!exec_block[b]) continue;
+            koopa_raw_basic_block_t bb = cfg.blocks[b];
+
+            //块参数：所有可执行入边上实参的交汇
+            for(size_t i = 0; i < bb->params.len; i++){
+                Lattice l;
+                for(int p : cfg.preds[b]){
+                    koopa_raw_basic_block_t pred = cfg.blocks[p];
+                    koopa_raw_value_t term = (koopa_raw_value_t) pred->insts.buffer[pred->insts.len - 1];
+                    if(term->kind.tag == KOOPA_RVT_JUMP){
+                        if(exec_out[p][0]) l = Meet(l, get((koopa_raw_value_t) term->kind.data.jump.args.buffer[i]));
+                    }else if(term->kind.tag == KOOPA_RVT_BRANCH){
+                        const auto &br = term->kind.data.branch;
+                        if(br.true_bb == bb && exec_out[p][0]) l = Meet(l, get((koopa_raw_value_t) br.true_args.buffer[i]));
+                        if(br.false_bb == bb && exec_out[p][1]) l = Meet(l, get((koopa_raw_value_t) br.false_args.buffer[i]));
+                    }
+                }
+                update((koopa_raw_value_t) bb->params.buffer[i], l);
+            }
+
+            for(size_t j = 0; j < bb->insts.len; j++){
+                koopa_raw_value_t inst = (koopa_raw_value_t) bb->insts.buffer[j];
+                if(inst->kind.tag == KOOPA_RVT_BINARY){
+                    update(inst, eval(inst));
+                }else if(inst->kind.tag == KOOPA_RVT_JUMP){
+                    mark_edge(b, 0, inst->kind.data.jump.target);
+                }else if(inst->kind.tag == KOOPA_RVT_BRANCH){
+                    const auto &br = inst->kind.data.branch;
+                    Lattice c = get(br.cond);
+                    if(c.kind == Lattice::CONST){
+                        if(c.value != 0) mark_edge(b, 0, br.true_bb);
+                        else mark_edge(b, 1, br.false_bb);
+                    }else if(c.kind == Lattice::OVER){
+                        mark_edge(b, 0, br.true_bb);
+                        mark_edge(b, 1, br.false_bb);
+                    }
+                }
+            }
+        }
+    }
+
+    //1. 常量替换，结果是常量的二元运算直接删除
+    unordered_map<koopa_raw_value_t, koopa_raw_value_t> replace;
+    unordered_set<koopa_raw_value_t> dead;
+    unordered_map<koopa_raw_basic_block_t, vector<bool>> keep_params;
+    for(int b = 0; b < n; b++){
+        koopa_raw_basic_block_t bb = cfg.blocks[b];
+        if(!exec_block[b]) continue;
+        for(size_t i = 0; i < bb->params.len; i++){
+            koopa_raw_value_t param = (koopa_raw_value_t) bb->params.buffer[i];
+            Lattice l = get(param);
+            if(l.kind != Lattice::CONST) continue;
+            replace[param] = arena.Integer(l.value);
+            auto &keep = keep_params[bb];
+            if(keep.empty()) keep.assign(bb->params.len, true);
+            keep[i] = false;
+        }
+        for(size_t j = 0; j < bb->insts.len; j++){
+            koopa_raw_value_t inst = (koopa_raw_value_t) bb->insts.buffer[j];
+            if(inst->kind.tag != KOOPA_RVT_BINARY) continue;
+            Lattice l = get(inst);
+            if(l.kind == Lattice::CONST){
+                replace[inst] = arena.Integer(l.value);
+                dead.insert(inst);
+            }
+        }
+    }
+    ReplaceUses(func, replace);
+    replace.clear();
+
+    //2. 代数恒等式：x + 0、x - 0、x * 1、x / 1、x | 0、x ^ 0、移位 0 位都直接用 x
+    for(int b = 0; b < n; b++){
+        koopa_raw_basic_block_t bb = cfg.blocks[b];
+        for(size_t j = 0; j < bb->insts.len; j++){
+            koopa_raw_value_t inst = (koopa_raw_value_t) bb->insts.buffer[j];
+            if(inst->kind.tag != KOOPA_RVT_BINARY || dead.count(inst)) continue;
+            const auto &bin = inst->kind.data.binary;
+            auto is_int = [](koopa_raw_value_t v, int32_t x){
+                return v->kind.tag == KOOPA_RVT_INTEGER && v->kind.data.integer.value == x;
+            };
+            koopa_raw_value_t same = nullptr;
+            switch(bin.op){
+                case KOOPA_RBO_ADD: case KOOPA_RBO_OR: case KOOPA_RBO_XOR:
+                    if(is_int(bin.rhs, 0)) same = bin.lhs;
+                    else if(is_int(bin.lhs, 0)) same = bin.rhs;
+                    break;
+                case KOOPA_RBO_MUL:
+                    if(is_int(bin.rhs, 1)) same = bin.lhs;
+                    else if(is_int(bin.lhs, 1)) same = bin.rhs;
+                    break;
+                case KOOPA_RBO_SUB: case KOOPA_RBO_SHL: case KOOPA_RBO_SHR: case KOOPA_RBO_SAR:
+                    if(is_int(bin.rhs, 0)) same = bin.lhs;
+                    break;
+                case KOOPA_RBO_DIV:
+                    if(is_int(bin.rhs, 1)) same = bin.lhs;
+                    break;
+                default:
+                    break;
+            }
+            if(same){
+                replace[inst] = same;
+                dead.insert(inst);
+            }
+        }
+    }
+    ReplaceUses(func, replace);
+
+    //3. 条件恒定的 br 改成 jump
+    for(int b = 0; b < n; b++){
+        koopa_raw_basic_block_t bb = cfg.blocks[b];
+        koopa_raw_value_t term = (koopa_raw_value_t) bb->insts.buffer[bb->insts.len - 1];
+        if(term->kind.tag != KOOPA_RVT_BRANCH) continue;
+        koopa_raw_branch_t br = term->kind.data.branch;
+        if(br.cond->kind.tag != KOOPA_RVT_INTEGER) continue;
+        bool taken = br.cond->kind.data.integer.value != 0;
+        auto &kind = AsMutable(term)->kind;
+        kind.tag = KOOPA_RVT_JUMP;
+        kind.data.jump.target = taken ? br.true_bb : br.false_bb;
+        kind.data.jump.args = taken ? br.true_args : br.false_args;
+    }
+
+    for(int b = 0; b < n; b++){
+        FilterSlice<koopa_raw_value_t>(AsMutable(cfg.blocks[b])->insts, [&](koopa_raw_value_t inst){
+            return dead.count(inst) == 0;
+        });
+    }
+    RemoveBlockParams(func, keep_params);
+    RemoveUnreachableBlocks(func);
+}
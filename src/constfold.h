@@ -0,0 +1,15 @@
+#pragma once
+#include "koopa.h"
+#include "rawir.h"
+using namespace std;
+
+//稀疏条件常量传播（SCCP）+ 代数化简
+//常量结果直接替换掉指令，条件恒定的 br 改成 jump，并删除因此变得不可达的基本块
+class ConstFoldPass {
+public:
+    explicit ConstFoldPass(RawIRArena &arena) : arena(arena) {}
+    void Run(const koopa_raw_program_t &program);
+private:
+    RawIRArena &arena;
+    void RunOnFunction(koopa_raw_function_t func);
+};
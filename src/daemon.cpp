@@ -0,0 +1,113 @@
+#include "daemon.h"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+using namespace std;
+
+//请求行的长度上限，防止客户端一直不发换行
+static const size_t kMaxRequest = 64 * 1024;
+
+//读到第一个换行为止，连接提前关闭或超长时返回 false
+static bool ReadRequest(int fd, string &line){
+    char buf[4096];
+    while(line.size() < kMaxRequest){
+        ssize_t n = read(fd, buf, sizeof(buf));
+        if(n <= 0) return false;
+        line.append(buf, n);
+        size_t pos = line.find('\n');
+        if(pos != string::npos){
+            line.resize(pos);
+            return true;
+        }
+    }
+    return false;
+}
+
+static void WriteAll(int fd, const string &data){
+    size_t done = 0;
+    while(done < data.size()){
+        //客户端提前断开时不要因为 SIGPIPE 退出
+        ssize_t n = send(fd, data.data() + done, data.size() - done, MSG_NOSIGNAL);
+        if(n <= 0) return;
+        done += n;
+    }
+}
+
+static void HandleConnection(int fd, const CompileOptions &defaults){
+    string line;
+    ostringstream diag;
+    int status = 1;
+    if(!ReadRequest(fd, line)){
+        diag << "错误：请求格式应为 \"模式\\t输入文件\\t输出文件\\n\"" << endl;
+    }else{
+        vector<string> fields;
+        istringstream is(line);
+        string field;
+        while(getline(is, field, '\t')) fields.push_back(field);
+        if(fields.size() != 3){
+            diag << "错误：请求格式应为 \"模式\\t输入文件\\t输出文件\\n\"" << endl;
+        }else if(fields[0] != "koopa" && fields[0] != "riscv"){
+            //-interp 要读写标准输入输出，不能在常驻进程里做
+            diag << "错误：未知的模式 " << fields[0] << endl;
+        }else{
+            CompileOptions opt = defaults;
+            opt.mode = fields[0];
+            opt.input_file = fields[1];
+            opt.output_file = fields[2];
+            status = Compile(opt, diag);
+        }
+    }
+    WriteAll(fd, to_string(status) + "\n" + diag.str());
+    close(fd);
+}
+
+int RunDaemon(const string &socket_path, int jobs, const CompileOptions &defaults){
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if(socket_path.size() >= sizeof(addr.sun_path)){
+        cerr << "错误：套接字路径过长 " << socket_path << endl;
+        return 1;
+    }
+    strcpy(addr.sun_path, socket_path.c_str());
+
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(listen_fd < 0){
+        cerr << "错误：无法创建套接字：" << strerror(errno) << endl;
+        return 1;
+    }
+    //上次没有正常退出时留下的套接字文件
+    unlink(socket_path.c_str());
+    if(bind(listen_fd, (sockaddr *) &addr, sizeof(addr)) < 0 || listen(listen_fd, 128) < 0){
+        cerr << "错误：无法监听 " << socket_path << "：" << strerror(errno) << endl;
+        close(listen_fd);
+        return 1;
+    }
+
+    //每个线程自己 accept，由内核把连接分给空闲的线程，不需要额外的任务队列
+    vector<thread> workers;
+    for(int i = 0; i < jobs; i++){
+        workers.emplace_back([listen_fd, &defaults](){
+            while(true){
+                int fd = accept(listen_fd, nullptr, nullptr);
+                if(fd < 0){
+                    if(errno == EINTR || errno == ECONNABORTED) continue;
+                    cerr << "错误：accept 失败：" << strerror(errno) << endl;
+                    return;
+                }
+                HandleConnection(fd, defaults);
+            }
+        });
+    }
+    for(auto &t : workers){
+        t.join();
+    }
+    close(listen_fd);
+    return 1;
+}
@@ -0,0 +1,10 @@
+#pragma once
+#include "driver.h"
+#include <string>
+using namespace std;
+
+//-daemon：常驻进程，在 Unix 域套接字上接收编译请求，省掉每次编译的进程启动开销
+//每个连接一个请求，一行 "模式\t输入文件\t输出文件\n"，模式是 koopa 或 riscv，相对路径按常驻进程的工作目录解析
+//回复第一行是退出码，后面是这次编译的错误信息，写完后关闭连接
+//jobs 个线程同时 accept，各自完整地做一次编译；请求的其余选项取自 defaults；只有出错时返回
+int RunDaemon(const string &socket_path, int jobs, const CompileOptions &defaults);
@@ -0,0 +1,138 @@
+#include "dce.h"
+#include "irutil.h"
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+using namespace std;
+
+void DCEPass::Run(const koopa_raw_program_t &program){
+    for(size_t i = 0; i < program.funcs.len; i++){
+        koopa_raw_function_t func = (koopa_raw_function_t) program.funcs.buffer[i];
+        if(func->bbs.len == 0) continue;
+        RunOnFunction(func);
+    }
+}
+
+void DCEPass::RunOnFunction(koopa_raw_function_t func){
+    RemoveUnreachableBlocks(func);
+
+    //使用关系，以及每个块参数在各条入边上对应的实参
+    unordered_map<koopa_raw_value_t, vector<koopa_raw_value_t>> users;
+    unordered_map<koopa_raw_value_t, vector<koopa_raw_value_t>> incoming;
+    auto add_args = [&](koopa_raw_basic_block_t target, const koopa_raw_slice_t &args){
+        for(size_t i = 0; i < args.len; i++){
+            incoming[(koopa_raw_value_t) target->params.buffer[i]].push_back((koopa_raw_value_t) args.buffer[i]);
+        }
+    };
+    for(size_t i = 0; i < func->bbs.len; i++){
+        koopa_raw_basic_block_t bb = (koopa_raw_basic_block_t) func->bbs.buffer[i];
+        for(size_t j = 0; j < bb->insts.len; j++){
+            koopa_raw_value_t inst = (koopa_raw_value_t) bb->insts.buffer[j];
+            ForEachOperand(inst, [&](koopa_raw_value_t op){
+                users[op].push_back(inst);
+            });
+            if(inst->kind.tag == KOOPA_RVT_JUMP){
+                add_args(inst->kind.data.jump.target, inst->kind.data.jump.args);
+            }else if(inst->kind.tag == KOOPA_RVT_BRANCH){
+                const auto &br = inst->kind.data.branch;
+                add_args(br.true_bb, br.true_args);
+                add_args(br.false_bb, br.false_args);
+            }
+        }
+    }
+
+    //只被写的地址：局部 alloc，或者由它算出来的指针，并且只作为 store 的目标出现
+    unordered_map<koopa_raw_value_t, bool> write_only;
+    function<bool(koopa_raw_value_t)> is_write_only = [&](koopa_raw_value_t ptr) -> bool {
+        auto it = write_only.find(ptr);
+        if(it != write_only.end()) return it->second;
+        bool res = true;
+        for(koopa_raw_value_t user : users[ptr]){
+            auto tag = user->kind.tag;
+            if(tag == KOOPA_RVT_STORE && user->kind.data.store.dest == ptr && user->kind.data.store.value != ptr){
+                continue;
+            }
+            if((tag == KOOPA_RVT_GET_ELEM_PTR && user->kind.data.get_elem_ptr.src == ptr) ||
+               (tag == KOOPA_RVT_GET_PTR && user->kind.data.get_ptr.src == ptr)){
+                if(is_write_only(user)) continue;
+            }
+            res = false;
+            break;
+        }
+        write_only[ptr] = res;
+        return res;
+    };
+    auto stores_to_dead_memory = [&](koopa_raw_value_t store){
+        koopa_raw_value_t ptr = store->kind.data.store.dest;
+        //一路追到最初的 alloc
+        koopa_raw_value_t base = ptr;
+        while(base->kind.tag == KOOPA_RVT_GET_ELEM_PTR || base->kind.tag == KOOPA_RVT_GET_PTR){
+            base = base->kind.tag == KOOPA_RVT_GET_ELEM_PTR ? base->kind.data.get_elem_ptr.src
+                                                           : base->kind.data.get_ptr.src;
+        }
+        return base->kind.tag == KOOPA_RVT_ALLOC && is_write_only(base);
+    };
+
+    //标记阶段
+    unordered_set<koopa_raw_value_t> live;
+    vector<koopa_raw_value_t> work;
+    auto mark = [&](koopa_raw_value_t v){
+        auto tag = v->kind.tag;
+        if(tag == KOOPA_RVT_INTEGER || tag == KOOPA_RVT_GLOBAL_ALLOC || tag == KOOPA_RVT_FUNC_ARG_REF) return;
+        if(live.insert(v).second) work.push_back(v);
+    };
+    for(size_t i = 0; i < func->bbs.len; i++){
+        koopa_raw_basic_block_t bb = (koopa_raw_basic_block_t) func->bbs.buffer[i];
+        for(size_t j = 0; j < bb->insts.len; j++){
+            koopa_raw_value_t inst = (koopa_raw_value_t) bb->insts.buffer[j];
+            switch(inst->kind.tag){
+                case KOOPA_RVT_STORE:
+                    if(stores_to_dead_memory(inst)) break;
+                    mark(inst);
+                    break;
+                case KOOPA_RVT_CALL:
+                case KOOPA_RVT_RETURN:
+                case KOOPA_RVT_JUMP:
+                case KOOPA_RVT_BRANCH:
+                    mark(inst);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+    while(!work.empty()){
+        koopa_raw_value_t v = work.back();
+        work.pop_back();
+        if(v->kind.tag == KOOPA_RVT_BLOCK_ARG_REF){
+            //块参数活跃时，每条入边上的实参才是活跃的
+            for(koopa_raw_value_t arg : incoming[v]) mark(arg);
+            continue;
+        }
+        if(v->kind.tag == KOOPA_RVT_JUMP) continue;
+        if(v->kind.tag == KOOPA_RVT_BRANCH){
+            mark(v->kind.data.branch.cond);
+            continue;
+        }
+        ForEachOperand(v, mark);
+    }
+
+    //清除阶段
+    unordered_map<koopa_raw_basic_block_t, vector<bool>> keep_params;
+    for(size_t i = 0; i < func->bbs.len; i++){
+        koopa_raw_basic_block_t bb = (koopa_raw_basic_block_t) func->bbs.buffer[i];
+        FilterSlice<koopa_raw_value_t>(AsMutable(bb)->insts, [&](koopa_raw_value_t inst){
+            return live.count(inst) > 0;
+        });
+        vector<bool> keep(bb->params.len, true);
+        bool any_dead = false;
+        for(size_t k = 0; k < bb->params.len; k++){
+            if(!live.count((koopa_raw_value_t) bb->params.buffer[k])){
+                keep[k] = false;
+                any_dead = true;
+            }
+        }
+        if(any_dead) keep_params[bb] = keep;
+    }
+    RemoveBlockParams(func, keep_params);
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include "koopa.h"
+using namespace std;
+
+//死代码删除：从有副作用的指令出发标记用到的值，没有被标记的指令和基本块参数全部删除
+//只被写、从来不被读的局部变量/数组连同对它们的 store 一起删除；不可达的基本块也会被删掉
+class DCEPass {
+public:
+    void Run(const koopa_raw_program_t &program);
+private:
+    void RunOnFunction(koopa_raw_function_t func);
+};
@@ -0,0 +1,263 @@
+#include "driver.h"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include "ast.h"
+#include "visit.h"
+#include "asmwriter.h"
+#include "rawir.h"
+#include "koopatext.h"
+#include "mem2reg.h"
+#include "inline.h"
+#include "constfold.h"
+#include "dce.h"
+#include "gvn.h"
+#include "licm.h"
+#include "strength.h"
+#include "layout.h"
+#include "timereport.h"
+#include "interp.h"
+#include "profile.h"
+#include "cache.h"
+using namespace std;
+
+//可重入的 flex 扫描器
+typedef void *yyscan_t;
+extern int yylex_init(yyscan_t *scanner);
+extern void yyset_in(FILE *in, yyscan_t scanner);
+extern int yylex_destroy(yyscan_t scanner);
+extern int yyparse(BaseAST *&ast, yyscan_t scanner);
+
+int Compile(const CompileOptions &opt, ostream &diag) {
+  const string &mode = opt.mode;
+  const string &input_file = opt.input_file;
+  const string &output_file = opt.output_file;
+  const string &report_file = opt.report_file;
+  const string &profile_gen = opt.profile_gen;
+  const string &profile_use = opt.profile_use;
+  int jobs = opt.jobs;
+
+  //这次编译的前端状态，返回时连同 AST 一起释放
+  CompileContext ctx;
+  ctx.SetDiag(diag);
+  cur_ctx = &ctx;
+  struct ResetContext {
+      ~ResetContext() { cur_ctx = nullptr; }
+  } reset_ctx;
+
+  TimeReport report;
+  report.SetInfo("input", input_file);
+  report.SetInfo("mode", mode);
+  //每个 pass 之后 IR 的规模；不输出报告时不用数
+  auto count_ir = [&](const koopa_raw_program_t &program){
+      if(report_file.empty()) return;
+      long long insts, blocks;
+      CountProgram(program, insts, blocks);
+      report.Count("ir_insts", insts);
+      report.Count("ir_blocks", blocks);
+  };
+
+  //编译缓存：命中时输出已经放好，不用分析、生成 IR 和汇编；-interp 的结果取决于运行时输入，不缓存
+  CompileCache cache(opt.cache_dir, opt.cache_size);
+  string cache_key;
+  if(!opt.cache_dir.empty() && mode != "interp"){
+      report.Begin("cache");
+      cache_key = CompileCache::Key(opt);
+      bool hit = !cache_key.empty() && cache.Fetch(cache_key, output_file);
+      report.End();
+      report.Count("cache_hit", hit);
+      if(hit){
+          if(!report_file.empty() && !report.WriteJSON(report_file)){
+              diag << "错误：无法写入报告文件 " << report_file << endl;
+              return 1;
+          }
+          return 0;
+      }
+  }
+
+  //打开输入文件
+  FILE *input = fopen(input_file.c_str(), "r");
+  if(!input){
+      diag << "错误：无法打开输入文件 " << input_file << endl;
+      return 1;
+  }
+
+  report.Begin("parse");
+  BaseAST *ast = nullptr;   // 结点归 ctx.ast_arena 所有
+  yyscan_t scanner;
+  yylex_init(&scanner);
+  yyset_in(input, scanner);
+  int ret = yyparse(ast, scanner);
+  yylex_destroy(scanner);
+  fclose(input);
+  report.End();
+  report.Count("ast_allocs", ctx.ast_arena.AllocCount());
+  report.Count("ast_bytes", ctx.ast_arena.AllocBytes());
+
+  if (ret || !ast) {
+      diag << "Compiler Error: Parsing failed, AST is null!" << endl;
+      return 1; // 发生语法错误，返回非0状态码
+  }
+  // 前端直接在内存中构建 raw program；-koopa 模式最后再把它写成文本
+  RawIRArena ir_arena;
+  RawIRBuilder raw_builder(ir_arena);
+  ctx.builder.UseRawIR(&raw_builder);
+  report.Begin("gen_ir");
+  try{
+      ast->GenKoopaIR();
+  }catch(const CompileError &){
+      return 1;
+  }
+  report.End();
+  if(mode == "koopa"){
+      report.Begin("write");
+      Rope text;
+      KoopaTextWriter(text).Write(raw_builder.GetProgram());
+      report.Count("koopa_bytes", text.Size());
+      if(!text.WriteToFile(output_file)){
+          diag << "错误：无法写入输出文件 " << output_file << endl;
+          return 1;
+      }
+      report.End();
+    }else if(mode == "riscv"){
+      koopa_raw_program_t raw = raw_builder.GetProgram();
+      report.Count("ir_values", ir_arena.ValueCount());
+      count_ir(raw);
+
+      // profile 按基本块名对应，必须在任何优化改动基本块之前挂上
+      BlockProfile profile;
+      BlockProfile *use_profile = nullptr;
+      if(!profile_use.empty()){
+          if(!profile.Load(profile_use)){
+              diag << "错误：无法读取 profile 文件 " << profile_use << endl;
+              return 1;
+          }
+          profile.Attach(raw);
+          use_profile = &profile;
+      }
+
+      // 优化：把局部变量提升为 SSA 值，pass 新建的 IR 对象也放在 ir_arena 中
+      Mem2RegPass mem2reg(ir_arena);
+      report.Begin("mem2reg");
+      mem2reg.Run(raw);
+      report.End();
+      count_ir(raw);
+
+      // 把小函数内联进调用者，之后的常量传播可以跨过原来的调用边界
+      InlinePass inliner(ir_arena, use_profile);
+      report.Begin("inline");
+      inliner.Run(raw);
+      report.End();
+      count_ir(raw);
+
+      // 常量传播与折叠，删除条件恒定的分支留下的死块
+      ConstFoldPass const_fold(ir_arena);
+      report.Begin("const_fold");
+      const_fold.Run(raw);
+      report.End();
+      count_ir(raw);
+
+      // 全局值编号：删除重复的计算和重复的 load
+      GVNPass gvn;
+      report.Begin("gvn");
+      gvn.Run(raw);
+      report.End();
+      count_ir(raw);
+
+      // 删除没有用到的计算、只写不读的局部变量和不可达的基本块
+      DCEPass dce;
+      report.Begin("dce");
+      dce.Run(raw);
+      report.End();
+      count_ir(raw);
+
+      // 循环不变量外提到前置块
+      LICMPass licm(ir_arena, use_profile);
+      report.Begin("licm");
+      licm.Run(raw);
+      report.End();
+      count_ir(raw);
+
+      // 强度削弱：归纳变量的乘法和数组下标改成递推，乘除以常数改成移位，再清掉替换下来的指令
+      StrengthReducePass strength(ir_arena);
+      report.Begin("strength_reduce");
+      strength.Run(raw);
+      report.End();
+      count_ir(raw);
+      report.Begin("dce");
+      dce.Run(raw);
+      report.End();
+      count_ir(raw);
+
+      // 基本块排布：让循环里热的后继直接落空，省掉 j
+      BlockLayoutPass layout(use_profile);
+      report.Begin("block_layout");
+      layout.Run(raw);
+      report.End();
+      count_ir(raw);
+
+        // 2. 遍历 raw 结构，汇编先写进内存缓冲区，最后一次性写入文件
+      AsmWriter asm_out;
+      AsmGenerator gen(asm_out, use_profile);
+
+      report.Begin("codegen");
+      gen.Generate(raw, jobs);
+      report.End();
+      if(!report_file.empty()){
+          const string &text = asm_out.Str();
+          report.Count("asm_lines", count(text.begin(), text.end(), '\n'));
+          report.Count("asm_bytes", text.size());
+          report.Count("jobs", jobs);
+      }
+
+      report.Begin("write");
+      if(!asm_out.WriteToFile(output_file)){
+          diag << "错误：无法写入输出文件 " << output_file << endl;
+          return 1;
+      }
+      report.End();
+    }else if(mode == "interp"){
+      // 直接解释执行未优化的 IR：程序输出写到 -o 指定的文件，基本块计数写到 -fprofile-generate 的文件，没有指定时打印到 stderr
+      koopa_raw_program_t raw = raw_builder.GetProgram();
+      FILE *prog_out = fopen(output_file.c_str(), "w");
+      if(!prog_out){
+          diag << "错误：无法写入输出文件 " << output_file << endl;
+          return 1;
+      }
+      Interpreter interp(raw);
+      report.Begin("interp");
+      int exit_code = interp.Run(prog_out);
+      report.End();
+      fclose(prog_out);
+      if(profile_gen.empty()){
+          interp.WriteBlockCounts(stderr);
+      }else{
+          FILE *prof_out = fopen(profile_gen.c_str(), "w");
+          if(!prof_out){
+              diag << "错误：无法写入 profile 文件 " << profile_gen << endl;
+              return 1;
+          }
+          interp.WriteBlockCounts(prof_out);
+          fclose(prof_out);
+      }
+      if(!report_file.empty() && !report.WriteJSON(report_file)){
+          diag << "错误：无法写入报告文件 " << report_file << endl;
+          return 1;
+      }
+      return exit_code & 0xff;
+    }else{
+      diag << "错误：未知的模式 " << mode << "，没有生成输出文件" << endl;
+      return 1;
+    }
+  if(!cache_key.empty()){
+      cache.Store(cache_key, output_file);
+  }
+  if(!report_file.empty() && !report.WriteJSON(report_file)){
+      diag << "错误：无法写入报告文件 " << report_file << endl;
+      return 1;
+  }
+  
+  
+  return 0;
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <string>
+using namespace std;
+
+//一次编译的参数，和命令行选项一一对应
+struct CompileOptions {
+    string mode;            //koopa、riscv 或 interp
+    string input_file;
+    string output_file;
+    int jobs = 1;           //后端并行生成代码的线程数
+    string report_file;     //-time-report，为空时不输出
+    string profile_gen;     //-fprofile-generate，为空时块计数打印到 stderr
+    string profile_use;     //-fprofile-use，为空时不用 profile
+    string cache_dir;       //-cache，为空时不用编译缓存
+    uint64_t cache_size = 256ull << 20;    //-cache-size，缓存总大小的上限（字节）
+};
+
+//完成一次编译，返回进程退出码（-interp 时是被解释程序 main 的返回值）
+//前端状态放在这次调用自己的 CompileContext 里，不同线程可以同时调用；错误信息写到 diag
+int Compile(const CompileOptions &opt, ostream &diag);
@@ -0,0 +1,191 @@
+#include "gvn.h"
+#include "cfg.h"
+#include "irutil.h"
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+using namespace std;
+
+//表达式的键：指令种类、二元运算符和两个（已经编号过的）操作数
+struct ExprKey {
+    koopa_raw_value_tag_t tag;
+    int op;
+    koopa_raw_value_t lhs, rhs;
+    bool operator==(const ExprKey &other) const {
+        return tag == other.tag && op == other.op && lhs == other.lhs && rhs == other.rhs;
+    }
+};
+
+struct ExprKeyHash {
+    size_t operator()(const ExprKey &key) const {
+        size_t h = hash<const void *>()(key.lhs);
+        h = h * 31 + hash<const void *>()(key.rhs);
+        return h * 31 + key.tag * 64 + key.op;
+    }
+};
+
+static bool IsCommutative(koopa_raw_binary_op_t op){
+    switch(op){
+        case KOOPA_RBO_ADD: case KOOPA_RBO_MUL:
+        case KOOPA_RBO_AND: case KOOPA_RBO_OR: case KOOPA_RBO_XOR:
+        case KOOPA_RBO_EQ: case KOOPA_RBO_NOT_EQ:
+            return true;
+        default:
+            return false;
+    }
+}
+
+//同一个数组中常量下标不同的两个元素一定不重叠
+static bool Disjoint(koopa_raw_value_t a, koopa_raw_value_t b){
+    if(a->kind.tag != b->kind.tag) return false;
+    koopa_raw_value_t src_a, src_b, idx_a, idx_b;
+    if(a->kind.tag == KOOPA_RVT_GET_ELEM_PTR){
+        src_a = a->kind.data.get_elem_ptr.src, idx_a = a->kind.data.get_elem_ptr.index;
+        src_b = b->kind.data.get_elem_ptr.src, idx_b = b->kind.data.get_elem_ptr.index;
+    }else if(a->kind.tag == KOOPA_RVT_GET_PTR){
+        src_a = a->kind.data.get_ptr.src, idx_a = a->kind.data.get_ptr.index;
+        src_b = b->kind.data.get_ptr.src, idx_b = b->kind.data.get_ptr.index;
+    }else{
+        return false;
+    }
+    return src_a == src_b && idx_a->kind.tag == KOOPA_RVT_INTEGER && idx_b->kind.tag == KOOPA_RVT_INTEGER &&
+           idx_a->kind.data.integer.value != idx_b->kind.data.integer.value;
+}
+
+void GVNPass::Run(const koopa_raw_program_t &program){
+    for(size_t i = 0; i < program.funcs.len; i++){
+        koopa_raw_function_t func = (koopa_raw_function_t) program.funcs.buffer[i];
+        if(func->bbs.len == 0) continue;
+        RunOnFunction(func);
+    }
+}
+
+void GVNPass::RunOnFunction(koopa_raw_function_t func){
+    //不可达的块不在支配树里，先删掉，免得它们还引用被删除的指令
+    RemoveUnreachableBlocks(func);
+    CFG cfg(func);
+    int n = cfg.Size();
+
+    unordered_set<koopa_raw_value_t> escaped = CollectEscapedRoots(func);
+
+    //值相同的整数常量统一成同一个对象，这样表达式的键可以直接比较指针
+    unordered_map<int32_t, koopa_raw_value_t> consts;
+    unordered_map<koopa_raw_value_t, koopa_raw_value_t> replace;
+    auto resolve = [&](koopa_raw_value_t v){
+        auto it = replace.find(v);
+        if(it != replace.end()) return it->second;
+        if(v->kind.tag == KOOPA_RVT_INTEGER){
+            return consts.emplace(v->kind.data.integer.value, v).first->second;
+        }
+        return v;
+    };
+
+    //纯表达式表随支配树的进出作用域；离开一个块时撤销它加入的键
+    unordered_map<ExprKey, koopa_raw_value_t, ExprKeyHash> table;
+    vector<vector<ExprKey>> pushed(n);
+    //每个块末尾可用的 (地址, 值)
+    vector<vector<pair<koopa_raw_value_t, koopa_raw_value_t>>> loads_out(n);
+
+    vector<pair<int, bool>> stack = {{0, false}};
+    while(!stack.empty()){
+        auto [b, leaving] = stack.back();
+        stack.pop_back();
+        if(leaving){
+            for(const ExprKey &key : pushed[b]) table.erase(key);
+            continue;
+        }
+
+        auto &loads = loads_out[b];
+        if(cfg.preds[b].size() == 1 && cfg.preds[b][0] == cfg.idom[b]){
+            loads = loads_out[cfg.idom[b]];
+        }
+        auto kill = [&](const function<bool(koopa_raw_value_t)> &clobbered){
+            vector<pair<koopa_raw_value_t, koopa_raw_value_t>> kept;
+            for(auto &entry : loads){
+                if(!clobbered(entry.first)) kept.push_back(entry);
+            }
+            loads = move(kept);
+        };
+
+        koopa_raw_basic_block_t bb = cfg.blocks[b];
+        for(size_t j = 0; j < bb->insts.len; j++){
+            koopa_raw_value_t inst = (koopa_raw_value_t) bb->insts.buffer[j];
+            //被支配的使用点一定在定义之后处理，这里可以直接改写
+            ForEachOperandRef(inst, [&](koopa_raw_value_t &op){
+                op = resolve(op);
+            });
+
+            const auto &kind = inst->kind;
+            ExprKey key{kind.tag, 0, nullptr, nullptr};
+            switch(kind.tag){
+                case KOOPA_RVT_BINARY:
+                    key.op = kind.data.binary.op;
+                    key.lhs = kind.data.binary.lhs;
+                    key.rhs = kind.data.binary.rhs;
+                    if(IsCommutative(kind.data.binary.op) && less<koopa_raw_value_t>()(key.rhs, key.lhs)){
+                        swap(key.lhs, key.rhs);
+                    }
+                    break;
+                case KOOPA_RVT_GET_ELEM_PTR:
+                    key.lhs = kind.data.get_elem_ptr.src;
+                    key.rhs = kind.data.get_elem_ptr.index;
+                    break;
+                case KOOPA_RVT_GET_PTR:
+                    key.lhs = kind.data.get_ptr.src;
+                    key.rhs = kind.data.get_ptr.index;
+                    break;
+                case KOOPA_RVT_LOAD: {
+                    koopa_raw_value_t addr = kind.data.load.src;
+                    bool found = false;
+                    for(auto &entry : loads){
+                        if(entry.first == addr){
+                            replace[inst] = entry.second;
+                            found = true;
+                            break;
+                        }
+                    }
+                    if(!found) loads.push_back({addr, inst});
+                    continue;
+                }
+                case KOOPA_RVT_STORE: {
+                    koopa_raw_value_t dest = kind.data.store.dest;
+                    koopa_raw_value_t root = PointerRoot(dest);
+                    kill([&](koopa_raw_value_t addr){
+                        return addr == dest || (MayAlias(PointerRoot(addr), root) && !Disjoint(addr, dest));
+                    });
+                    //store 之后从同一地址读出的就是刚存的值
+                    loads.push_back({dest, kind.data.store.value});
+                    continue;
+                }
+                case KOOPA_RVT_CALL:
+                    kill([&](koopa_raw_value_t addr){
+                        koopa_raw_value_t root = PointerRoot(addr);
+                        return root->kind.tag != KOOPA_RVT_ALLOC || escaped.count(root);
+                    });
+                    continue;
+                default:
+                    continue;
+            }
+            auto res = table.emplace(key, inst);
+            if(res.second){
+                pushed[b].push_back(key);
+            }else{
+                replace[inst] = res.first->second;
+            }
+        }
+
+        stack.push_back({b, true});
+        for(auto it = cfg.dom_children[b].rbegin(); it != cfg.dom_children[b].rend(); ++it){
+            stack.push_back({*it, false});
+        }
+    }
+
+    if(replace.empty()) return;
+    for(int b = 0; b < n; b++){
+        FilterSlice<koopa_raw_value_t>(AsMutable(cfg.blocks[b])->insts, [&](koopa_raw_value_t inst){
+            return replace.count(inst) == 0;
+        });
+    }
+}
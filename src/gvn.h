@@ -0,0 +1,13 @@
+#pragma once
+#include "koopa.h"
+using namespace std;
+
+//基于支配树的全局值编号：沿支配树向下遍历，支配者中已经算过的同样表达式直接复用
+//纯的二元运算、getelemptr/getptr 按（运算，操作数）去重；load 在没有可能写同一地址的 store/call 时复用
+//load 的可用信息只沿唯一前驱就是直接支配者的边传下去，汇合点重新开始
+class GVNPass {
+public:
+    void Run(const koopa_raw_program_t &program);
+private:
+    void RunOnFunction(koopa_raw_function_t func);
+};
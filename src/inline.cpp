@@ -0,0 +1,263 @@
+#include "inline.h"
+#include "cfg.h"
+#include "irutil.h"
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+using namespace std;
+
+//被调函数指令数（扣掉调用本身的开销后）的上限，调用点在循环里时放宽一倍
+static const int kInlineBudget = 40;
+//内联后调用者的指令数上限，避免代码膨胀
+static const int kMaxCallerSize = 4000;
+//有 profile 时，执行次数达到全程序最热块的这个比例的调用点算热点
+static const double kHotFraction = 0.01;
+
+static int CountInsts(koopa_raw_function_t func){
+    int size = 0;
+    for(size_t i = 0; i < func->bbs.len; i++){
+        size += ((koopa_raw_basic_block_t) func->bbs.buffer[i])->insts.len;
+    }
+    return size;
+}
+
+template <typename T>
+static vector<T> SliceItems(const koopa_raw_slice_t &slice, size_t begin, size_t end){
+    vector<T> items;
+    for(size_t i = begin; i < end; i++){
+        items.push_back((T) slice.buffer[i]);
+    }
+    return items;
+}
+
+void InlinePass::Run(const koopa_raw_program_t &program){
+    vector<koopa_raw_function_t> bottom_up;
+    FindRecursive(program, bottom_up);
+    for(auto func : bottom_up){
+        func_size[func] = CountInsts(func);
+    }
+    for(auto func : bottom_up){
+        RunOnFunction(func);
+    }
+}
+
+//Tarjan 求调用图的强连通分量：分量按被调者在前的顺序产生，大小超过 1 或者自己调用自己的就是递归
+void InlinePass::FindRecursive(const koopa_raw_program_t &program, vector<koopa_raw_function_t> &bottom_up){
+    unordered_map<koopa_raw_function_t, vector<koopa_raw_function_t>> callees;
+    vector<koopa_raw_function_t> funcs;
+    for(size_t i = 0; i < program.funcs.len; i++){
+        koopa_raw_function_t func = (koopa_raw_function_t) program.funcs.buffer[i];
+        if(func->bbs.len == 0) continue;
+        funcs.push_back(func);
+        for(size_t b = 0; b < func->bbs.len; b++){
+            koopa_raw_basic_block_t bb = (koopa_raw_basic_block_t) func->bbs.buffer[b];
+            for(size_t j = 0; j < bb->insts.len; j++){
+                koopa_raw_value_t inst = (koopa_raw_value_t) bb->insts.buffer[j];
+                if(inst->kind.tag != KOOPA_RVT_CALL) continue;
+                koopa_raw_function_t callee = inst->kind.data.call.callee;
+                if(callee->bbs.len == 0) continue;
+                callees[func].push_back(callee);
+                if(callee == func) recursive.insert(func);
+            }
+        }
+    }
+
+    unordered_map<koopa_raw_function_t, int> index, low;
+    unordered_set<koopa_raw_function_t> on_stack;
+    vector<koopa_raw_function_t> stack;
+    int counter = 0;
+    function<void(koopa_raw_function_t)> visit = [&](koopa_raw_function_t f){
+        index[f] = low[f] = counter++;
+        stack.push_back(f);
+        on_stack.insert(f);
+        for(auto g : callees[f]){
+            if(index.count(g) == 0){
+                visit(g);
+                low[f] = min(low[f], low[g]);
+            }else if(on_stack.count(g)){
+                low[f] = min(low[f], index[g]);
+            }
+        }
+        if(low[f] != index[f]) return;
+        vector<koopa_raw_function_t> scc;
+        koopa_raw_function_t g;
+        do{
+            g = stack.back();
+            stack.pop_back();
+            on_stack.erase(g);
+            scc.push_back(g);
+        }while(g != f);
+        if(scc.size() > 1){
+            recursive.insert(scc.begin(), scc.end());
+        }
+        bottom_up.insert(bottom_up.end(), scc.begin(), scc.end());
+    };
+    for(auto f : funcs){
+        if(index.count(f) == 0) visit(f);
+    }
+}
+
+bool InlinePass::ShouldInline(koopa_raw_function_t caller, koopa_raw_basic_block_t bb, koopa_raw_value_t call, int loop_depth) const {
+    koopa_raw_function_t callee = call->kind.data.call.callee;
+    if(callee->bbs.len == 0 || callee == caller || recursive.count(callee)) return false;
+    int size = func_size.at(callee);
+    //省掉的是传参、call 和取返回值
+    int cost = size - (int)call->kind.data.call.args.len - 2;
+    int budget = loop_depth > 0 ? 2 * kInlineBudget : kInlineBudget;
+    //没执行过的调用点只在内联后不变大时才内联，热点放宽到 4 倍
+    double count;
+    if(profile && profile->Lookup(bb, count)){
+        if(count == 0){
+            budget = 0;
+        }else if(count >= profile->MaxCount() * kHotFraction){
+            budget = 4 * kInlineBudget;
+        }
+    }
+    return cost <= budget && func_size.at(caller) + size <= kMaxCallerSize;
+}
+
+void InlinePass::RunOnFunction(koopa_raw_function_t func){
+    //只展开原有块中的调用；内联进来的块来自已经处理过的被调函数，不再展开
+    CFG cfg(func);
+    vector<int> depth = cfg.ComputeLoopDepth();
+    unordered_map<koopa_raw_basic_block_t, int> bb_depth;
+    for(int i = 0; i < cfg.Size(); i++){
+        bb_depth[cfg.blocks[i]] = depth[i];
+    }
+
+    vector<koopa_raw_basic_block_t> bbs = SliceItems<koopa_raw_basic_block_t>(func->bbs, 0, func->bbs.len);
+    unordered_map<koopa_raw_value_t, koopa_raw_value_t> replace;
+    bool changed = false;
+    for(size_t i = 0; i < bbs.size(); i++){
+        koopa_raw_basic_block_t bb = bbs[i];
+        auto it = bb_depth.find(bb);
+        if(it == bb_depth.end()) continue;
+        for(size_t j = 0; j < bb->insts.len; j++){
+            koopa_raw_value_t inst = (koopa_raw_value_t) bb->insts.buffer[j];
+            if(inst->kind.tag != KOOPA_RVT_CALL || !ShouldInline(func, bb, inst, it->second)) continue;
+            func_size[func] += func_size[inst->kind.data.call.callee];
+            //续块接着在后面的循环中处理，其中剩下的调用也有机会被内联
+            bb_depth[InlineCall(bbs, i, j, replace)] = it->second;
+            changed = true;
+            break;
+        }
+    }
+    if(!changed) return;
+    AsMutable(func)->bbs = arena.NewSlice(bbs, KOOPA_RSIK_BASIC_BLOCK);
+    ReplaceUses(func, replace);
+}
+
+koopa_raw_basic_block_t InlinePass::InlineCall(vector<koopa_raw_basic_block_t> &bbs, size_t bb_pos, size_t idx,
+                                               unordered_map<koopa_raw_value_t, koopa_raw_value_t> &replace){
+    koopa_raw_basic_block_t bb = bbs[bb_pos];
+    koopa_raw_value_t call = (koopa_raw_value_t) bb->insts.buffer[idx];
+    const koopa_raw_call_t &data = call->kind.data.call;
+    koopa_raw_function_t callee = data.callee;
+    koopa_raw_basic_block_t callee_entry = (koopa_raw_basic_block_t) callee->bbs.buffer[0];
+    string prefix = "%" + string(callee->name + 1) + "_inl" + to_string(inline_cnt++) + "_";
+    auto copy_slice = [&](const koopa_raw_slice_t &slice){
+        return arena.NewSlice(SliceItems<const void *>(slice, 0, slice.len), slice.kind);
+    };
+
+    //续块：call 之后的指令，返回值作为它的块参数
+    koopa_raw_basic_block_data_t *cont = arena.NewBlock(arena.NewName(prefix + "ret"));
+    cont->insts = arena.NewSlice(SliceItems<koopa_raw_value_t>(bb->insts, idx + 1, bb->insts.len), KOOPA_RSIK_VALUE);
+    bool has_ret = call->ty->tag != KOOPA_RTT_UNIT;
+    if(has_ret){
+        koopa_raw_value_data_t *ret_val = arena.NewValue(call->ty, arena.NewName(prefix + "ret_val"), KOOPA_RVT_BLOCK_ARG_REF);
+        ret_val->kind.data.block_arg_ref.index = 0;
+        cont->params = arena.NewSlice(vector<koopa_raw_value_t>{ret_val}, KOOPA_RSIK_VALUE);
+        replace[call] = ret_val;
+    }
+
+    //第一遍复制块、块参数和指令，第二遍再改写操作数，这样前向引用也能找到副本
+    unordered_map<koopa_raw_value_t, koopa_raw_value_t> vmap;
+    unordered_map<koopa_raw_basic_block_t, koopa_raw_basic_block_t> bmap;
+    for(size_t i = 0; i < callee->params.len; i++){
+        vmap[(koopa_raw_value_t) callee->params.buffer[i]] = (koopa_raw_value_t) data.args.buffer[i];
+    }
+    auto clone_value = [&](koopa_raw_value_t val){
+        koopa_raw_value_data_t *copy = arena.NewValue(val->ty, val->name, val->kind.tag);
+        copy->kind = val->kind;
+        vmap[val] = copy;
+        return copy;
+    };
+    vector<koopa_raw_basic_block_t> clones;
+    for(size_t b = 0; b < callee->bbs.len; b++){
+        koopa_raw_basic_block_t src = (koopa_raw_basic_block_t) callee->bbs.buffer[b];
+        koopa_raw_basic_block_data_t *dst = arena.NewBlock(arena.NewName(prefix + (src->name ? src->name + 1 : "bb")));
+        vector<koopa_raw_value_t> params, insts;
+        for(size_t i = 0; i < src->params.len; i++){
+            params.push_back(clone_value((koopa_raw_value_t) src->params.buffer[i]));
+        }
+        for(size_t i = 0; i < src->insts.len; i++){
+            insts.push_back(clone_value((koopa_raw_value_t) src->insts.buffer[i]));
+        }
+        dst->params = arena.NewSlice(params, KOOPA_RSIK_VALUE);
+        dst->insts = arena.NewSlice(insts, KOOPA_RSIK_VALUE);
+        bmap[src] = dst;
+        clones.push_back(dst);
+    }
+    for(auto clone : clones){
+        for(size_t i = 0; i < clone->insts.len; i++){
+            koopa_raw_value_data_t *inst = AsMutable((koopa_raw_value_t) clone->insts.buffer[i]);
+            auto &kind = inst->kind;
+            switch(kind.tag){
+                case KOOPA_RVT_CALL:
+                    kind.data.call.args = copy_slice(kind.data.call.args);
+                    break;
+                case KOOPA_RVT_JUMP:
+                    kind.data.jump.args = copy_slice(kind.data.jump.args);
+                    kind.data.jump.target = bmap[kind.data.jump.target];
+                    break;
+                case KOOPA_RVT_BRANCH:
+                    kind.data.branch.true_args = copy_slice(kind.data.branch.true_args);
+                    kind.data.branch.false_args = copy_slice(kind.data.branch.false_args);
+                    kind.data.branch.true_bb = bmap[kind.data.branch.true_bb];
+                    kind.data.branch.false_bb = bmap[kind.data.branch.false_bb];
+                    break;
+                case KOOPA_RVT_RETURN: {
+                    //ret 改成带着返回值跳到续块
+                    koopa_raw_value_t val = kind.data.ret.value;
+                    kind.tag = KOOPA_RVT_JUMP;
+                    kind.data.jump.target = cont;
+                    kind.data.jump.args = has_ret && val ? arena.NewSlice(vector<koopa_raw_value_t>{val}, KOOPA_RSIK_VALUE)
+                                                         : arena.EmptySlice(KOOPA_RSIK_VALUE);
+                    break;
+                }
+                default:
+                    break;
+            }
+            ForEachOperandRef(inst, [&](koopa_raw_value_t &op){
+                auto it = vmap.find(op);
+                if(it != vmap.end()) op = it->second;
+            });
+        }
+    }
+
+    //调用所在的块截断在 call 之前，改为跳到被调函数的入口
+    koopa_raw_value_data_t *jump = arena.NewValue(arena.UnitType(), nullptr, KOOPA_RVT_JUMP);
+    jump->kind.data.jump.target = clones[0];
+    jump->kind.data.jump.args = arena.EmptySlice(KOOPA_RSIK_VALUE);
+    vector<koopa_raw_value_t> head = SliceItems<koopa_raw_value_t>(bb->insts, 0, idx);
+    head.push_back(jump);
+    AsMutable(bb)->insts = arena.NewSlice(head, KOOPA_RSIK_VALUE);
+
+    //被调函数的块按这个调用点占被调函数总调用次数的比例分到次数
+    double call_count, entry_count;
+    if(profile && profile->Lookup(bb, call_count)){
+        double scale = profile->Lookup(callee_entry, entry_count) && entry_count > 0 ? call_count / entry_count : 0;
+        for(size_t b = 0; b < callee->bbs.len; b++){
+            double count;
+            if(profile->Lookup((koopa_raw_basic_block_t) callee->bbs.buffer[b], count)){
+                profile->Set(clones[b], count * scale);
+            }
+        }
+        profile->Set(cont, call_count);
+    }
+
+    clones.push_back(cont);
+    bbs.insert(bbs.begin() + bb_pos + 1, clones.begin(), clones.end());
+    return cont;
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include "koopa.h"
+#include "rawir.h"
+#include "profile.h"
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+using namespace std;
+
+//函数内联：把小函数的调用替换成被调函数基本块的副本
+//参数直接换成实参，ret 改成跳到调用点之后的续块，返回值作为续块的块参数传回
+//调用图中成环（递归）的函数不内联；按调用图自底向上处理，被调函数先完成内联
+class InlinePass {
+public:
+    //profile 不为空时按调用点的实际执行次数调整预算，并给内联进来的块估计执行次数
+    explicit InlinePass(RawIRArena &arena, BlockProfile *profile = nullptr) : arena(arena), profile(profile) {}
+    void Run(const koopa_raw_program_t &program);
+private:
+    RawIRArena &arena;
+    BlockProfile *profile;
+    unordered_set<koopa_raw_function_t> recursive;
+    unordered_map<koopa_raw_function_t, int> func_size;
+    int inline_cnt = 0;
+
+    void FindRecursive(const koopa_raw_program_t &program, vector<koopa_raw_function_t> &bottom_up);
+    bool ShouldInline(koopa_raw_function_t caller, koopa_raw_basic_block_t bb, koopa_raw_value_t call, int loop_depth) const;
+    void RunOnFunction(koopa_raw_function_t func);
+    //把 bb 中第 idx 条指令（call）展开，返回调用点之后的续块
+    //call 的返回值要换成续块参数，记在 replace 里，由调用者统一替换
+    koopa_raw_basic_block_t InlineCall(vector<koopa_raw_basic_block_t> &bbs, size_t bb_pos, size_t idx,
+                                       unordered_map<koopa_raw_value_t, koopa_raw_value_t> &replace);
+};
@@ -0,0 +1,382 @@
+#include "interp.h"
+#include "irutil.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+using namespace std;
+
+//栈最多占用的字数（256MB），超过就认为是无穷递归
+static const size_t kMaxMemoryWords = 64u << 20;
+
+static const struct {
+    const char *name;
+    int id;
+} kBuiltins[] = {
+    {"@getint", 0}, {"@getch", 1}, {"@getarray", 2}, {"@putint", 3},
+    {"@putch", 4}, {"@putarray", 5}, {"@starttime", 6}, {"@stoptime", 7},
+};
+
+Interpreter::Interpreter(const koopa_raw_program_t &program){
+    //全局变量依次排在内存开头
+    for(size_t i = 0; i < program.values.len; i++){
+        koopa_raw_value_t val = (koopa_raw_value_t) program.values.buffer[i];
+        global_addr[val] = globals_end;
+        globals_end += GetTypeSize(val->ty->data.pointer.base) / 4;
+    }
+    mem.assign(globals_end + (1 << 16), 0);
+    for(size_t i = 0; i < program.values.len; i++){
+        koopa_raw_value_t val = (koopa_raw_value_t) program.values.buffer[i];
+        InitGlobal(val->kind.data.global_alloc.init, global_addr[val]);
+    }
+
+    //先给函数编号，翻译 call 时要用
+    for(size_t i = 0; i < program.funcs.len; i++){
+        koopa_raw_function_t func = (koopa_raw_function_t) program.funcs.buffer[i];
+        if(func->bbs.len == 0) continue;
+        func_index[func] = funcs.size();
+        funcs.emplace_back();
+        if(strcmp(func->name, "@main") == 0) main_func = funcs.size() - 1;
+    }
+    for(auto &entry : func_index){
+        Translate(entry.first, funcs[entry.second]);
+    }
+}
+
+void Interpreter::InitGlobal(koopa_raw_value_t init, size_t addr){
+    switch(init->kind.tag){
+        case KOOPA_RVT_INTEGER:
+            mem[addr] = init->kind.data.integer.value;
+            break;
+        case KOOPA_RVT_AGGREGATE: {
+            const auto &elems = init->kind.data.aggregate.elems;
+            for(size_t i = 0; i < elems.len; i++){
+                koopa_raw_value_t elem = (koopa_raw_value_t) elems.buffer[i];
+                InitGlobal(elem, addr);
+                addr += GetTypeSize(elem->ty) / 4;
+            }
+            break;
+        }
+        default:
+            //zeroinit：内存本来就是 0
+            break;
+    }
+}
+
+void Interpreter::Translate(koopa_raw_function_t func, Func &f){
+    f.name = func->name;
+    f.num_params = func->params.len;
+
+    //1. 编号：函数参数、块参数、有结果的指令
+    unordered_map<koopa_raw_value_t, int> slot;
+    unordered_map<koopa_raw_basic_block_t, int> block_index;
+    for(size_t i = 0; i < func->params.len; i++){
+        slot[(koopa_raw_value_t) func->params.buffer[i]] = f.num_slots++;
+    }
+    for(size_t b = 0; b < func->bbs.len; b++){
+        koopa_raw_basic_block_t bb = (koopa_raw_basic_block_t) func->bbs.buffer[b];
+        block_index[bb] = b;
+        for(size_t i = 0; i < bb->params.len; i++){
+            slot[(koopa_raw_value_t) bb->params.buffer[i]] = f.num_slots++;
+        }
+        for(size_t i = 0; i < bb->insts.len; i++){
+            koopa_raw_value_t inst = (koopa_raw_value_t) bb->insts.buffer[i];
+            if(inst->ty->tag == KOOPA_RTT_UNIT) continue;
+            slot[inst] = f.num_slots++;
+            if(inst->kind.tag == KOOPA_RVT_ALLOC){
+                f.allocs.push_back({slot[inst], f.frame_words});
+                f.frame_words += GetTypeSize(inst->ty->data.pointer.base) / 4;
+            }
+        }
+    }
+
+    auto operand = [&](koopa_raw_value_t v) -> Operand {
+        if(v->kind.tag == KOOPA_RVT_INTEGER) return {true, v->kind.data.integer.value};
+        auto g = global_addr.find(v);
+        if(g != global_addr.end()) return {true, g->second};
+        auto it = slot.find(v);
+        if(it == slot.end()){
+            cerr << "错误：解释器遇到未定义的值（函数 " << func->name << "）" << endl;
+            exit(1);
+        }
+        return {false, it->second};
+    };
+    auto operands = [&](const koopa_raw_slice_t &slice){
+        vector<Operand> res;
+        for(size_t i = 0; i < slice.len; i++){
+            res.push_back(operand((koopa_raw_value_t) slice.buffer[i]));
+        }
+        return res;
+    };
+
+    //2. 翻译指令
+    f.blocks.resize(func->bbs.len);
+    f.counts.assign(func->bbs.len, 0);
+    for(size_t b = 0; b < func->bbs.len; b++){
+        koopa_raw_basic_block_t bb = (koopa_raw_basic_block_t) func->bbs.buffer[b];
+        Block &block = f.blocks[b];
+        block.name = bb->name ? bb->name : "%bb" + to_string(b);
+        for(size_t i = 0; i < bb->params.len; i++){
+            block.params.push_back(slot[(koopa_raw_value_t) bb->params.buffer[i]]);
+        }
+        for(size_t i = 0; i < bb->insts.len; i++){
+            koopa_raw_value_t val = (koopa_raw_value_t) bb->insts.buffer[i];
+            const auto &kind = val->kind;
+            Inst inst;
+            auto it = slot.find(val);
+            inst.dst = it == slot.end() ? -1 : it->second;
+            switch(kind.tag){
+                case KOOPA_RVT_ALLOC:
+                    //地址在进入函数时就算好了
+                    continue;
+                case KOOPA_RVT_BINARY:
+                    inst.op = Op::BINARY;
+                    inst.bin_op = kind.data.binary.op;
+                    inst.a = operand(kind.data.binary.lhs);
+                    inst.b = operand(kind.data.binary.rhs);
+                    break;
+                case KOOPA_RVT_LOAD:
+                    inst.op = Op::LOAD;
+                    inst.a = operand(kind.data.load.src);
+                    break;
+                case KOOPA_RVT_STORE:
+                    inst.op = Op::STORE;
+                    inst.a = operand(kind.data.store.value);
+                    inst.b = operand(kind.data.store.dest);
+                    break;
+                case KOOPA_RVT_GET_ELEM_PTR:
+                    inst.op = Op::OFFSET;
+                    inst.a = operand(kind.data.get_elem_ptr.src);
+                    inst.b = operand(kind.data.get_elem_ptr.index);
+                    inst.scale = GetTypeSize(kind.data.get_elem_ptr.src->ty->data.pointer.base->data.array.base) / 4;
+                    break;
+                case KOOPA_RVT_GET_PTR:
+                    inst.op = Op::OFFSET;
+                    inst.a = operand(kind.data.get_ptr.src);
+                    inst.b = operand(kind.data.get_ptr.index);
+                    inst.scale = GetTypeSize(kind.data.get_ptr.src->ty->data.pointer.base) / 4;
+                    break;
+                case KOOPA_RVT_CALL: {
+                    inst.op = Op::CALL;
+                    inst.args = operands(kind.data.call.args);
+                    koopa_raw_function_t callee = kind.data.call.callee;
+                    auto fi = func_index.find(callee);
+                    if(fi != func_index.end()){
+                        inst.callee = fi->second;
+                        break;
+                    }
+                    bool found = false;
+                    for(const auto &builtin : kBuiltins){
+                        if(strcmp(callee->name, builtin.name) == 0){
+                            inst.callee = -(builtin.id + 1);
+                            found = true;
+                        }
+                    }
+                    if(!found){
+                        cerr << "错误：解释器不支持的外部函数 " << callee->name << endl;
+                        exit(1);
+                    }
+                    break;
+                }
+                case KOOPA_RVT_JUMP:
+                    inst.op = Op::JUMP;
+                    inst.true_edge.target = block_index[kind.data.jump.target];
+                    inst.true_edge.args = operands(kind.data.jump.args);
+                    break;
+                case KOOPA_RVT_BRANCH:
+                    inst.op = Op::BRANCH;
+                    inst.a = operand(kind.data.branch.cond);
+                    inst.true_edge.target = block_index[kind.data.branch.true_bb];
+                    inst.true_edge.args = operands(kind.data.branch.true_args);
+                    inst.false_edge.target = block_index[kind.data.branch.false_bb];
+                    inst.false_edge.args = operands(kind.data.branch.false_args);
+                    break;
+                case KOOPA_RVT_RETURN:
+                    inst.op = Op::RET;
+                    inst.a = kind.data.ret.value ? operand(kind.data.ret.value) : Operand{true, 0};
+                    break;
+                default:
+                    cerr << "错误：解释器不支持的指令类型 " << kind.tag << endl;
+                    exit(1);
+            }
+            block.insts.push_back(move(inst));
+        }
+    }
+}
+
+void Interpreter::EnsureMemory(size_t words){
+    if(words <= mem.size()) return;
+    if(words > kMaxMemoryWords){
+        cerr << "错误：解释执行时栈溢出" << endl;
+        exit(1);
+    }
+    mem.resize(max(words, min(mem.size() * 2, kMaxMemoryWords)));
+}
+
+int32_t Interpreter::CallBuiltin(Builtin which, const vector<int32_t> &args, FILE *out){
+    auto check = [&](size_t addr, size_t len){
+        if(addr + len > mem.size()){
+            cerr << "错误：数组访问越界" << endl;
+            exit(1);
+        }
+    };
+    switch(which){
+        case GETINT: {
+            int v = 0;
+            if(scanf("%d", &v) != 1) return 0;
+            return v;
+        }
+        case GETCH:
+            return getchar();
+        case GETARRAY: {
+            int n = 0;
+            if(scanf("%d", &n) != 1) return 0;
+            check(args[0], n);
+            for(int i = 0; i < n; i++){
+                if(scanf("%d", &mem[args[0] + i]) != 1) break;
+            }
+            return n;
+        }
+        case PUTINT:
+            fprintf(out, "%d", args[0]);
+            return 0;
+        case PUTCH:
+            fputc(args[0], out);
+            return 0;
+        case PUTARRAY:
+            check(args[1], args[0]);
+            fprintf(out, "%d:", args[0]);
+            for(int i = 0; i < args[0]; i++){
+                fprintf(out, " %d", mem[args[1] + i]);
+            }
+            fputc('\n', out);
+            return 0;
+        case STARTTIME:
+            timer_start = chrono::steady_clock::now();
+            return 0;
+        case STOPTIME:
+            timer_us += chrono::duration<double, micro>(chrono::steady_clock::now() - timer_start).count();
+            return 0;
+    }
+    return 0;
+}
+
+int Interpreter::Run(FILE *out){
+    if(main_func < 0){
+        cerr << "错误：程序中没有 main 函数" << endl;
+        exit(1);
+    }
+    vector<Frame> frames;
+    size_t sp = globals_end;
+    vector<int32_t> args, tmp;
+
+    //新建栈帧：参数放在最前面的槽位，alloc 的地址在这里算好
+    auto enter = [&](int fi, const vector<int32_t> &actuals, int ret_dst){
+        Func &f = funcs[fi];
+        size_t base = regs.size();
+        regs.resize(base + f.num_slots);
+        for(size_t i = 0; i < actuals.size(); i++){
+            regs[base + i] = actuals[i];
+        }
+        EnsureMemory(sp + f.frame_words);
+        for(auto &alloc : f.allocs){
+            regs[base + alloc.first] = sp + alloc.second;
+        }
+        frames.push_back({fi, 0, 0, base, sp, ret_dst});
+        sp += f.frame_words;
+        f.counts[0]++;
+    };
+    enter(main_func, {}, -1);
+
+    while(true){
+        Frame &fr = frames.back();
+        Func &f = funcs[fr.func];
+        const Inst &inst = f.blocks[fr.block].insts[fr.pc++];
+        int32_t *r = regs.data() + fr.base;
+        auto get = [&](const Operand &op){
+            return op.imm ? op.val : r[op.val];
+        };
+        auto addr = [&](const Operand &op){
+            size_t a = (uint32_t) get(op);
+            if(a >= mem.size()){
+                cerr << "错误：访问非法地址（函数 " << f.name << "）" << endl;
+                exit(1);
+            }
+            return a;
+        };
+        //先把实参全部取出来再写块参数，参数之间互相引用时不会读到新值
+        auto take_edge = [&](const Edge &edge){
+            tmp.clear();
+            for(const Operand &op : edge.args) tmp.push_back(get(op));
+            const Block &target = f.blocks[edge.target];
+            for(size_t i = 0; i < tmp.size(); i++){
+                r[target.params[i]] = tmp[i];
+            }
+            fr.block = edge.target;
+            fr.pc = 0;
+            f.counts[edge.target]++;
+        };
+
+        switch(inst.op){
+            case Op::BINARY: {
+                int32_t res;
+                if(!EvalBinary(inst.bin_op, get(inst.a), get(inst.b), res)){
+                    cerr << "错误：除以 0（函数 " << f.name << "）" << endl;
+                    exit(1);
+                }
+                r[inst.dst] = res;
+                break;
+            }
+            case Op::LOAD:
+                r[inst.dst] = mem[addr(inst.a)];
+                break;
+            case Op::STORE:
+                mem[addr(inst.b)] = get(inst.a);
+                break;
+            case Op::OFFSET:
+                r[inst.dst] = get(inst.a) + get(inst.b) * inst.scale;
+                break;
+            case Op::CALL: {
+                args.clear();
+                for(const Operand &op : inst.args) args.push_back(get(op));
+                if(inst.callee < 0){
+                    int32_t res = CallBuiltin((Builtin)(-inst.callee - 1), args, out);
+                    if(inst.dst >= 0) r[inst.dst] = res;
+                }else{
+                    //enter 会让 fr、r 失效，下一轮循环重新取
+                    enter(inst.callee, args, inst.dst);
+                }
+                break;
+            }
+            case Op::JUMP:
+                take_edge(inst.true_edge);
+                break;
+            case Op::BRANCH:
+                take_edge(get(inst.a) ? inst.true_edge : inst.false_edge);
+                break;
+            case Op::RET: {
+                int32_t res = get(inst.a);
+                int ret_dst = fr.ret_dst;
+                sp = fr.fp;
+                regs.resize(fr.base);
+                frames.pop_back();
+                if(frames.empty()){
+                    if(timer_us > 0){
+                        fprintf(stderr, "TOTAL: %.0fus\n", timer_us);
+                    }
+                    return res;
+                }
+                if(ret_dst >= 0) regs[frames.back().base + ret_dst] = res;
+                break;
+            }
+        }
+    }
+}
+
+void Interpreter::WriteBlockCounts(FILE *fp) const {
+    for(const Func &f : funcs){
+        for(size_t b = 0; b < f.blocks.size(); b++){
+            fprintf(fp, "%s %s %llu\n", f.name.c_str(), f.blocks[b].name.c_str(), (unsigned long long) f.counts[b]);
+        }
+    }
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include "koopa.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+//-interp：直接解释执行 Koopa raw program，不用生成汇编再找 RISC-V 环境运行
+//每个函数先翻译成紧凑的指令表：值编号成帧内槽位，常量直接放进操作数；所有槽位放在一个平坦数组里
+//内存是一个平坦的 i32 数组，指针就是数组下标（按 4 字节一个字），全局变量在前，栈帧依次往后
+//执行时统计每个基本块的执行次数，可以作为 profile 给优化使用
+class Interpreter {
+public:
+    explicit Interpreter(const koopa_raw_program_t &program);
+
+    //从 main 开始执行，程序的输出写到 out，返回 main 的返回值
+    int Run(FILE *out);
+    //每个基本块的执行次数，一行一个："函数名 基本块名 次数"
+    void WriteBlockCounts(FILE *fp) const;
+
+private:
+    //SysY 运行时库，直接在解释器里实现
+    enum Builtin { GETINT, GETCH, GETARRAY, PUTINT, PUTCH, PUTARRAY, STARTTIME, STOPTIME };
+
+    struct Operand {
+        bool imm;
+        int32_t val;    //imm 时是常量，否则是槽位
+    };
+    enum class Op { BINARY, LOAD, STORE, OFFSET, CALL, JUMP, BRANCH, RET };
+    struct Edge {
+        int target = -1;
+        vector<Operand> args;
+    };
+    struct Inst {
+        Op op;
+        koopa_raw_binary_op_t bin_op = KOOPA_RBO_ADD;
+        int dst = -1;           //结果槽位，没有结果时为 -1
+        Operand a{true, 0}, b{true, 0};
+        int scale = 1;          //OFFSET：dst = a + b * scale
+        int callee = 0;         //CALL：>= 0 是 funcs 下标，< 0 是 -(Builtin + 1)
+        vector<Operand> args;
+        Edge true_edge, false_edge;
+    };
+    struct Block {
+        string name;
+        vector<int> params;
+        vector<Inst> insts;
+    };
+    struct Func {
+        string name;
+        int num_params = 0;
+        int num_slots = 0;
+        int frame_words = 0;
+        vector<pair<int, int>> allocs;  //(槽位, 帧内偏移)
+        vector<Block> blocks;
+        vector<uint64_t> counts;
+    };
+    struct Frame {
+        int func;
+        int block;
+        size_t pc;
+        size_t base;        //槽位在 regs 中的起点
+        size_t fp;          //栈帧在 mem 中的起点
+        int ret_dst;        //返回值写到调用者的哪个槽位
+    };
+
+    vector<Func> funcs;
+    int main_func = -1;
+    vector<int32_t> mem;
+    size_t globals_end = 0;
+    vector<int32_t> regs;
+    unordered_map<koopa_raw_value_t, int32_t> global_addr;
+    unordered_map<koopa_raw_function_t, int> func_index;
+    chrono::steady_clock::time_point timer_start;
+    double timer_us = 0;    //starttime/stoptime 之间累计的时间
+
+    void InitGlobal(koopa_raw_value_t init, size_t addr);
+    void Translate(koopa_raw_function_t func, Func &f);
+    int32_t CallBuiltin(Builtin which, const vector<int32_t> &args, FILE *out);
+    void EnsureMemory(size_t words);
+};
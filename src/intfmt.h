@@ -0,0 +1,20 @@
+#pragma once
+#include <cstddef>
+
+//整数格式化的缓冲区长度上限：long long 最多 19 位数字加一个负号
+constexpr size_t kMaxIntChars = 20;
+
+//把 value 的十进制写进 out（至少 kMaxIntChars 字节），返回写入的字节数，不补 '\0'
+inline size_t FormatInt(char *out, long long value){
+    char tmp[kMaxIntChars];
+    size_t len = 0;
+    unsigned long long v = value < 0 ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+    do {
+        tmp[len++] = '0' + v % 10;
+        v /= 10;
+    } while (v != 0);
+    size_t n = 0;
+    if (value < 0) out[n++] = '-';
+    while (len > 0) out[n++] = tmp[--len];
+    return n;
+}
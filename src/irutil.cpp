@@ -0,0 +1,251 @@
+#include "irutil.h"
+#include <cassert>
+#include <unordered_set>
+using namespace std;
+
+static void ForEachInSlice(const koopa_raw_slice_t &slice, const function<void(koopa_raw_value_t &)> &fn){
+    for(size_t i = 0; i < slice.len; i++){
+        fn(reinterpret_cast<koopa_raw_value_t &>(slice.buffer[i]));
+    }
+}
+
+void ForEachOperandRef(koopa_raw_value_t val, const function<void(koopa_raw_value_t &)> &fn){
+    auto &kind = AsMutable(val)->kind;
+    switch(kind.tag){
+        case KOOPA_RVT_LOAD:
+            fn(kind.data.load.src);
+            break;
+        case KOOPA_RVT_STORE:
+            fn(kind.data.store.value);
+            fn(kind.data.store.dest);
+            break;
+        case KOOPA_RVT_GET_PTR:
+            fn(kind.data.get_ptr.src);
+            fn(kind.data.get_ptr.index);
+            break;
+        case KOOPA_RVT_GET_ELEM_PTR:
+            fn(kind.data.get_elem_ptr.src);
+            fn(kind.data.get_elem_ptr.index);
+            break;
+        case KOOPA_RVT_BINARY:
+            fn(kind.data.binary.lhs);
+            fn(kind.data.binary.rhs);
+            break;
+        case KOOPA_RVT_BRANCH:
+            fn(kind.data.branch.cond);
+            ForEachInSlice(kind.data.branch.true_args, fn);
+            ForEachInSlice(kind.data.branch.false_args, fn);
+            break;
+        case KOOPA_RVT_JUMP:
+            ForEachInSlice(kind.data.jump.args, fn);
+            break;
+        case KOOPA_RVT_CALL:
+            ForEachInSlice(kind.data.call.args, fn);
+            break;
+        case KOOPA_RVT_RETURN:
+            if(kind.data.ret.value){
+                fn(kind.data.ret.value);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void ForEachOperand(koopa_raw_value_t val, const function<void(koopa_raw_value_t)> &fn){
+    ForEachOperandRef(val, [&](koopa_raw_value_t &op){ fn(op); });
+}
+
+vector<koopa_raw_basic_block_t> GetSuccessors(koopa_raw_basic_block_t bb){
+    vector<koopa_raw_basic_block_t> succs;
+    if(bb->insts.len == 0) return succs;
+    koopa_raw_value_t term = (koopa_raw_value_t) bb->insts.buffer[bb->insts.len - 1];
+    if(term->kind.tag == KOOPA_RVT_BRANCH){
+        succs.push_back(term->kind.data.branch.true_bb);
+        if(term->kind.data.branch.false_bb != term->kind.data.branch.true_bb){
+            succs.push_back(term->kind.data.branch.false_bb);
+        }
+    }else if(term->kind.tag == KOOPA_RVT_JUMP){
+        succs.push_back(term->kind.data.jump.target);
+    }
+    return succs;
+}
+
+int GetTypeSize(koopa_raw_type_t ty){
+    switch(ty->tag){
+        case KOOPA_RTT_INT32:
+        case KOOPA_RTT_POINTER:
+            return 4;
+        case KOOPA_RTT_ARRAY:
+            return GetTypeSize(ty->data.array.base) * ty->data.array.len;
+        case KOOPA_RTT_UNIT:
+            return 0;
+        default:
+            assert(false && "未知类型大小");
+    }
+    return 0;
+}
+
+bool IsRegValue(koopa_raw_value_t val){
+    switch(val->kind.tag){
+        case KOOPA_RVT_FUNC_ARG_REF:
+        case KOOPA_RVT_BLOCK_ARG_REF:
+            return true;
+        case KOOPA_RVT_INTEGER:
+        case KOOPA_RVT_ZERO_INIT:
+        case KOOPA_RVT_UNDEF:
+        case KOOPA_RVT_AGGREGATE:
+        case KOOPA_RVT_ALLOC:
+        case KOOPA_RVT_GLOBAL_ALLOC:
+            return false;
+        default:
+            return val->ty->tag != KOOPA_RTT_UNIT;
+    }
+}
+
+void RemoveUnreachableBlocks(koopa_raw_function_t func){
+    if(func->bbs.len == 0) return;
+    unordered_set<koopa_raw_basic_block_t> reachable;
+    vector<koopa_raw_basic_block_t> work = {(koopa_raw_basic_block_t) func->bbs.buffer[0]};
+    reachable.insert(work[0]);
+    while(!work.empty()){
+        koopa_raw_basic_block_t bb = work.back();
+        work.pop_back();
+        for(auto succ : GetSuccessors(bb)){
+            if(reachable.insert(succ).second){
+                work.push_back(succ);
+            }
+        }
+    }
+    FilterSlice<koopa_raw_basic_block_t>(AsMutable(func)->bbs, [&](koopa_raw_basic_block_t bb){
+        return reachable.count(bb) > 0;
+    });
+}
+
+void ReplaceUses(koopa_raw_function_t func, const unordered_map<koopa_raw_value_t, koopa_raw_value_t> &replace){
+    if(replace.empty()) return;
+    auto resolve = [&](koopa_raw_value_t v){
+        auto it = replace.find(v);
+        while(it != replace.end()){
+            v = it->second;
+            it = replace.find(v);
+        }
+        return v;
+    };
+    for(size_t i = 0; i < func->bbs.len; i++){
+        koopa_raw_basic_block_t bb = (koopa_raw_basic_block_t) func->bbs.buffer[i];
+        for(size_t j = 0; j < bb->insts.len; j++){
+            ForEachOperandRef((koopa_raw_value_t) bb->insts.buffer[j], [&](koopa_raw_value_t &op){
+                op = resolve(op);
+            });
+        }
+    }
+}
+
+void RemoveBlockParams(koopa_raw_function_t func,
+                       const unordered_map<koopa_raw_basic_block_t, vector<bool>> &keep){
+    if(keep.empty()) return;
+    auto filter_args = [&](koopa_raw_slice_t &args, koopa_raw_basic_block_t target){
+        auto it = keep.find(target);
+        if(it == keep.end()) return;
+        size_t idx = 0;
+        FilterSlice<koopa_raw_value_t>(args, [&](koopa_raw_value_t){
+            return it->second[idx++];
+        });
+    };
+    for(size_t i = 0; i < func->bbs.len; i++){
+        koopa_raw_basic_block_t bb = (koopa_raw_basic_block_t) func->bbs.buffer[i];
+        if(bb->insts.len == 0) continue;
+        koopa_raw_value_t term = (koopa_raw_value_t) bb->insts.buffer[bb->insts.len - 1];
+        if(term->kind.tag == KOOPA_RVT_JUMP){
+            auto &jump = AsMutable(term)->kind.data.jump;
+            filter_args(jump.args, jump.target);
+        }else if(term->kind.tag == KOOPA_RVT_BRANCH){
+            auto &branch = AsMutable(term)->kind.data.branch;
+            filter_args(branch.true_args, branch.true_bb);
+            filter_args(branch.false_args, branch.false_bb);
+        }
+    }
+    for(auto &entry : keep){
+        auto &params = AsMutable(entry.first)->params;
+        size_t idx = 0;
+        FilterSlice<koopa_raw_value_t>(params, [&](koopa_raw_value_t){
+            return entry.second[idx++];
+        });
+        //留下来的参数重新编号
+        for(size_t i = 0; i < params.len; i++){
+            AsMutable((koopa_raw_value_t) params.buffer[i])->kind.data.block_arg_ref.index = i;
+        }
+    }
+}
+
+bool EvalBinary(koopa_raw_binary_op_t op, int32_t lhs, int32_t rhs, int32_t &res){
+    uint32_t l = lhs, r = rhs;
+    switch(op){
+        case KOOPA_RBO_NOT_EQ: res = lhs != rhs; break;
+        case KOOPA_RBO_EQ: res = lhs == rhs; break;
+        case KOOPA_RBO_GT: res = lhs > rhs; break;
+        case KOOPA_RBO_LT: res = lhs < rhs; break;
+        case KOOPA_RBO_GE: res = lhs >= rhs; break;
+        case KOOPA_RBO_LE: res = lhs <= rhs; break;
+        case KOOPA_RBO_ADD: res = (int32_t)(l + r); break;
+        case KOOPA_RBO_SUB: res = (int32_t)(l - r); break;
+        case KOOPA_RBO_MUL: res = (int32_t)(l * r); break;
+        case KOOPA_RBO_DIV:
+            if(rhs == 0) return false;
+            res = (lhs == INT32_MIN && rhs == -1) ? INT32_MIN : lhs / rhs;
+            break;
+        case KOOPA_RBO_MOD:
+            if(rhs == 0) return false;
+            res = (lhs == INT32_MIN && rhs == -1) ? 0 : lhs % rhs;
+            break;
+        case KOOPA_RBO_AND: res = lhs & rhs; break;
+        case KOOPA_RBO_OR: res = lhs | rhs; break;
+        case KOOPA_RBO_XOR: res = lhs ^ rhs; break;
+        case KOOPA_RBO_SHL: res = (int32_t)(l << (r & 31)); break;
+        case KOOPA_RBO_SHR: res = (int32_t)(l >> (r & 31)); break;
+        case KOOPA_RBO_SAR: res = lhs >> (r & 31); break;
+        default: return false;
+    }
+    return true;
+}
+
+koopa_raw_value_t PointerRoot(koopa_raw_value_t ptr){
+    while(true){
+        if(ptr->kind.tag == KOOPA_RVT_GET_ELEM_PTR){
+            ptr = ptr->kind.data.get_elem_ptr.src;
+        }else if(ptr->kind.tag == KOOPA_RVT_GET_PTR){
+            ptr = ptr->kind.data.get_ptr.src;
+        }else{
+            return ptr;
+        }
+    }
+}
+
+bool IsIdentified(koopa_raw_value_t root){
+    return root->kind.tag == KOOPA_RVT_ALLOC || root->kind.tag == KOOPA_RVT_GLOBAL_ALLOC;
+}
+
+//SysY 没有取地址，局部变量的地址只会以实参的形式传给被调函数，所以不确定的指针不会指向本函数的 alloc
+bool MayAlias(koopa_raw_value_t a, koopa_raw_value_t b){
+    if(a == b) return true;
+    if(IsIdentified(a) && IsIdentified(b)) return false;
+    return a->kind.tag != KOOPA_RVT_ALLOC && b->kind.tag != KOOPA_RVT_ALLOC;
+}
+
+unordered_set<koopa_raw_value_t> CollectEscapedRoots(koopa_raw_function_t func){
+    unordered_set<koopa_raw_value_t> escaped;
+    for(size_t b = 0; b < func->bbs.len; b++){
+        koopa_raw_basic_block_t bb = (koopa_raw_basic_block_t) func->bbs.buffer[b];
+        for(size_t i = 0; i < bb->insts.len; i++){
+            koopa_raw_value_t inst = (koopa_raw_value_t) bb->insts.buffer[i];
+            if(inst->kind.tag != KOOPA_RVT_CALL) continue;
+            const auto &args = inst->kind.data.call.args;
+            for(size_t j = 0; j < args.len; j++){
+                koopa_raw_value_t arg = (koopa_raw_value_t) args.buffer[j];
+                if(arg->ty->tag == KOOPA_RTT_POINTER) escaped.insert(PointerRoot(arg));
+            }
+        }
+    }
+    return escaped;
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include "koopa.h"
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+using namespace std;
+
+//Koopa raw IR 上各个 pass 共用的小工具
+
+//pass 需要原地修改 IR，这里统一去掉 const
+inline koopa_raw_value_data_t *AsMutable(koopa_raw_value_t val){
+    return const_cast<koopa_raw_value_data_t *>(val);
+}
+inline koopa_raw_basic_block_data_t *AsMutable(koopa_raw_basic_block_t bb){
+    return const_cast<koopa_raw_basic_block_data_t *>(bb);
+}
+inline koopa_raw_function_data_t *AsMutable(koopa_raw_function_t func){
+    return const_cast<koopa_raw_function_data_t *>(func);
+}
+
+//遍历一条指令的全部操作数（包括 jump/branch 携带的基本块参数）
+void ForEachOperand(koopa_raw_value_t val, const function<void(koopa_raw_value_t)> &fn);
+//同上，但回调拿到的是操作数字段的引用，可以直接改写
+void ForEachOperandRef(koopa_raw_value_t val, const function<void(koopa_raw_value_t &)> &fn);
+
+//原地删除 slice 中不满足 keep 的元素，只会缩短不会扩容
+template <typename T, typename F>
+void FilterSlice(koopa_raw_slice_t &slice, F keep){
+    size_t len = 0;
+    for(size_t i = 0; i < slice.len; i++){
+        if(keep((T) slice.buffer[i])){
+            slice.buffer[len++] = slice.buffer[i];
+        }
+    }
+    slice.len = len;
+}
+
+//删除从入口不可达的基本块
+void RemoveUnreachableBlocks(koopa_raw_function_t func);
+
+//把函数中对 key 的使用全部改成 value，替换链会被一直追到底
+void ReplaceUses(koopa_raw_function_t func, const unordered_map<koopa_raw_value_t, koopa_raw_value_t> &replace);
+
+//删除基本块参数：keep[bb][i] 为 false 的参数连同所有跳转上对应的实参一起删除
+void RemoveBlockParams(koopa_raw_function_t func,
+                       const unordered_map<koopa_raw_basic_block_t, vector<bool>> &keep);
+
+//按 RISC-V 的语义计算二元运算，除数为 0 时无法计算，返回 false
+bool EvalBinary(koopa_raw_binary_op_t op, int32_t lhs, int32_t rhs, int32_t &res);
+
+//指针最终指向的对象：alloc、全局变量，或者无法确定（参数、从内存中读出的指针）
+koopa_raw_value_t PointerRoot(koopa_raw_value_t ptr);
+//根对象是 alloc 或全局变量
+bool IsIdentified(koopa_raw_value_t root);
+//两个根对象是否可能是同一块内存
+bool MayAlias(koopa_raw_value_t a, koopa_raw_value_t b);
+//作为实参传给被调函数的对象的根，调用可能会写它们
+unordered_set<koopa_raw_value_t> CollectEscapedRoots(koopa_raw_function_t func);
+
+//基本块终结指令的后继
+vector<koopa_raw_basic_block_t> GetSuccessors(koopa_raw_basic_block_t bb);
+
+//类型所占字节数
+int GetTypeSize(koopa_raw_type_t ty);
+
+//这个值在后端是否需要一个寄存器（函数参数、块参数、有返回值的非 alloc 指令）
+bool IsRegValue(koopa_raw_value_t val);
@@ -0,0 +1,217 @@
+#include "koopatext.h"
+#include <cassert>
+using namespace std;
+
+//下标与 koopa_raw_binary_op_t 的取值一一对应
+static const char *const kBinaryOps[] = {
+    "ne", "eq", "gt", "lt", "ge", "le", "add", "sub", "mul", "div", "mod",
+    "and", "or", "xor", "shl", "shr", "sar",
+};
+
+void KoopaTextWriter::Write(const koopa_raw_program_t &program){
+    //库函数的声明放在最前面，然后是全局变量，最后是函数定义
+    bool has_decl = false;
+    for(size_t i = 0; i < program.funcs.len; i++){
+        koopa_raw_function_t func = (koopa_raw_function_t) program.funcs.buffer[i];
+        if(func->bbs.len == 0){
+            WriteDecl(func);
+            has_decl = true;
+        }
+    }
+    if(has_decl) out << "\n";
+    for(size_t i = 0; i < program.values.len; i++){
+        WriteGlobal((koopa_raw_value_t) program.values.buffer[i]);
+    }
+    if(program.values.len > 0) out << "\n";
+    for(size_t i = 0; i < program.funcs.len; i++){
+        koopa_raw_function_t func = (koopa_raw_function_t) program.funcs.buffer[i];
+        if(func->bbs.len > 0) WriteFunction(func);
+    }
+}
+
+void KoopaTextWriter::WriteType(koopa_raw_type_t ty){
+    switch(ty->tag){
+        case KOOPA_RTT_INT32:
+            out << "i32";
+            break;
+        case KOOPA_RTT_ARRAY:
+            out << "[";
+            WriteType(ty->data.array.base);
+            out << ", " << ty->data.array.len << "]";
+            break;
+        case KOOPA_RTT_POINTER:
+            out << "*";
+            WriteType(ty->data.pointer.base);
+            break;
+        default:
+            assert(false && "未支持的类型");
+    }
+}
+
+void KoopaTextWriter::WriteValue(koopa_raw_value_t val){
+    if(val->kind.tag == KOOPA_RVT_INTEGER){
+        out << val->kind.data.integer.value;
+    }else if(val->name){
+        out << val->name;
+    }else{
+        auto it = temps.find(val);
+        assert(it != temps.end() && "引用了未定义的值");
+        out << "%" << it->second;
+    }
+}
+
+void KoopaTextWriter::WriteInit(koopa_raw_value_t init){
+    switch(init->kind.tag){
+        case KOOPA_RVT_ZERO_INIT:
+            out << "zeroinit";
+            break;
+        case KOOPA_RVT_INTEGER:
+            out << init->kind.data.integer.value;
+            break;
+        case KOOPA_RVT_AGGREGATE: {
+            const koopa_raw_slice_t &elems = init->kind.data.aggregate.elems;
+            out << "{";
+            for(size_t i = 0; i < elems.len; i++){
+                if(i > 0) out << ", ";
+                WriteInit((koopa_raw_value_t) elems.buffer[i]);
+            }
+            out << "}";
+            break;
+        }
+        default:
+            assert(false && "未支持的初始值");
+    }
+}
+
+void KoopaTextWriter::WriteDecl(koopa_raw_function_t func){
+    const koopa_raw_slice_t &params = func->ty->data.function.params;
+    out << "decl " << func->name << "(";
+    for(size_t i = 0; i < params.len; i++){
+        if(i > 0) out << ", ";
+        WriteType((koopa_raw_type_t) params.buffer[i]);
+    }
+    out << ")";
+    koopa_raw_type_t ret = func->ty->data.function.ret;
+    if(ret->tag != KOOPA_RTT_UNIT){
+        out << ": ";
+        WriteType(ret);
+    }
+    out << "\n";
+}
+
+void KoopaTextWriter::WriteGlobal(koopa_raw_value_t global){
+    out << "global " << global->name << " = alloc ";
+    WriteType(global->ty->data.pointer.base);
+    out << ", ";
+    WriteInit(global->kind.data.global_alloc.init);
+    out << "\n";
+}
+
+void KoopaTextWriter::WriteFunction(koopa_raw_function_t func){
+    //先给所有没有名字、有结果的指令编号，引用时不用关心定义出现的先后
+    temps.clear();
+    int next = 0;
+    for(size_t i = 0; i < func->bbs.len; i++){
+        koopa_raw_basic_block_t bb = (koopa_raw_basic_block_t) func->bbs.buffer[i];
+        for(size_t j = 0; j < bb->insts.len; j++){
+            koopa_raw_value_t inst = (koopa_raw_value_t) bb->insts.buffer[j];
+            if(!inst->name && inst->ty->tag != KOOPA_RTT_UNIT){
+                temps[inst] = next++;
+            }
+        }
+    }
+
+    out << "fun " << func->name << "(";
+    for(size_t i = 0; i < func->params.len; i++){
+        koopa_raw_value_t param = (koopa_raw_value_t) func->params.buffer[i];
+        if(i > 0) out << ", ";
+        out << param->name << ": ";
+        WriteType(param->ty);
+    }
+    out << ")";
+    koopa_raw_type_t ret = func->ty->data.function.ret;
+    if(ret->tag != KOOPA_RTT_UNIT){
+        out << ": ";
+        WriteType(ret);
+    }
+    out << " {\n";
+    for(size_t i = 0; i < func->bbs.len; i++){
+        koopa_raw_basic_block_t bb = (koopa_raw_basic_block_t) func->bbs.buffer[i];
+        out << bb->name << ":\n";
+        for(size_t j = 0; j < bb->insts.len; j++){
+            WriteInst((koopa_raw_value_t) bb->insts.buffer[j]);
+        }
+    }
+    out << "}\n\n";
+}
+
+void KoopaTextWriter::WriteInst(koopa_raw_value_t inst){
+    const auto &kind = inst->kind;
+    out << "  ";
+    if(kind.tag != KOOPA_RVT_ALLOC && inst->ty->tag != KOOPA_RTT_UNIT){
+        WriteValue(inst);
+        out << " = ";
+    }
+    switch(kind.tag){
+        case KOOPA_RVT_ALLOC:
+            out << inst->name << " = alloc ";
+            WriteType(inst->ty->data.pointer.base);
+            break;
+        case KOOPA_RVT_LOAD:
+            out << "load ";
+            WriteValue(kind.data.load.src);
+            break;
+        case KOOPA_RVT_STORE:
+            out << "store ";
+            WriteValue(kind.data.store.value);
+            out << ", ";
+            WriteValue(kind.data.store.dest);
+            break;
+        case KOOPA_RVT_GET_PTR:
+            out << "getptr ";
+            WriteValue(kind.data.get_ptr.src);
+            out << ", ";
+            WriteValue(kind.data.get_ptr.index);
+            break;
+        case KOOPA_RVT_GET_ELEM_PTR:
+            out << "getelemptr ";
+            WriteValue(kind.data.get_elem_ptr.src);
+            out << ", ";
+            WriteValue(kind.data.get_elem_ptr.index);
+            break;
+        case KOOPA_RVT_BINARY:
+            out << kBinaryOps[kind.data.binary.op] << " ";
+            WriteValue(kind.data.binary.lhs);
+            out << ", ";
+            WriteValue(kind.data.binary.rhs);
+            break;
+        case KOOPA_RVT_BRANCH:
+            out << "br ";
+            WriteValue(kind.data.branch.cond);
+            out << ", " << kind.data.branch.true_bb->name << ", " << kind.data.branch.false_bb->name;
+            break;
+        case KOOPA_RVT_JUMP:
+            out << "jump " << kind.data.jump.target->name;
+            break;
+        case KOOPA_RVT_CALL: {
+            const koopa_raw_slice_t &args = kind.data.call.args;
+            out << "call " << kind.data.call.callee->name << "(";
+            for(size_t i = 0; i < args.len; i++){
+                if(i > 0) out << ", ";
+                WriteValue((koopa_raw_value_t) args.buffer[i]);
+            }
+            out << ")";
+            break;
+        }
+        case KOOPA_RVT_RETURN:
+            out << "ret";
+            if(kind.data.ret.value){
+                out << " ";
+                WriteValue(kind.data.ret.value);
+            }
+            break;
+        default:
+            assert(false && "未支持的指令");
+    }
+    out << "\n";
+}
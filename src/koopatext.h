@@ -0,0 +1,24 @@
+#pragma once
+#include "koopa.h"
+#include "rope.h"
+#include <unordered_map>
+using namespace std;
+
+//把内存中的 raw program 写成 Koopa 文本（-koopa 模式）
+//有名字的值（alloc、全局变量、参数）和基本块沿用自己的名字，其余指令的结果在每个函数内依次编号为 %0、%1……
+class KoopaTextWriter {
+public:
+    explicit KoopaTextWriter(Rope &out) : out(out) {}
+    void Write(const koopa_raw_program_t &program);
+private:
+    Rope &out;
+    unordered_map<koopa_raw_value_t, int> temps;
+
+    void WriteType(koopa_raw_type_t ty);
+    void WriteValue(koopa_raw_value_t val);
+    void WriteInit(koopa_raw_value_t init);
+    void WriteDecl(koopa_raw_function_t func);
+    void WriteGlobal(koopa_raw_value_t global);
+    void WriteFunction(koopa_raw_function_t func);
+    void WriteInst(koopa_raw_value_t inst);
+};
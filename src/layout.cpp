@@ -0,0 +1,117 @@
+#include "layout.h"
+#include "cfg.h"
+#include "irutil.h"
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+void BlockLayoutPass::Run(const koopa_raw_program_t &program){
+    for(size_t i = 0; i < program.funcs.len; i++){
+        koopa_raw_function_t func = (koopa_raw_function_t) program.funcs.buffer[i];
+        if(func->bbs.len == 0) continue;
+        RunOnFunction(func);
+    }
+}
+
+void BlockLayoutPass::RunOnFunction(koopa_raw_function_t func){
+    CFG cfg(func);
+    int n = cfg.Size();
+    if(n <= 2) return;
+
+    //原来的顺序，权重相同时按它来排，保证输出稳定
+    unordered_map<koopa_raw_basic_block_t, int> orig_pos;
+    for(size_t i = 0; i < func->bbs.len; i++){
+        orig_pos[(koopa_raw_basic_block_t) func->bbs.buffer[i]] = i;
+    }
+
+    //静态 profile：每深一层循环执行次数乘 8；分支按两个目标的频率之比分配
+    //每个块都有实际执行次数时直接用它
+    vector<int> depth = cfg.ComputeLoopDepth();
+    vector<double> freq(n);
+    bool profiled = profile != nullptr;
+    for(int i = 0; i < n && profiled; i++){
+        profiled = profile->Lookup(cfg.blocks[i], freq[i]);
+    }
+    for(int i = 0; i < n && !profiled; i++){
+        freq[i] = pow(8.0, min(depth[i], 6));
+    }
+    struct Edge {
+        double weight;
+        int from, to;
+    };
+    vector<Edge> edges;
+    for(int u = 0; u < n; u++){
+        double total = 0;
+        for(int v : cfg.succs[u]) total += freq[v];
+        for(int v : cfg.succs[u]){
+            if(v == u) continue;
+            //有实际次数时，唯一的出边或唯一的入边上的次数是确定的
+            double weight = total > 0 ? freq[u] * freq[v] / total : 0;
+            if(profiled && cfg.succs[u].size() == 1) weight = freq[u];
+            else if(profiled && cfg.preds[v].size() == 1) weight = freq[v];
+            edges.push_back({weight, u, v});
+        }
+    }
+    //权重相同时先连无条件跳转的边，落空能直接省掉一条 j（循环的回边优先于进入循环体的边）
+    stable_sort(edges.begin(), edges.end(), [&](const Edge &a, const Edge &b){
+        if(a.weight != b.weight) return a.weight > b.weight;
+        if(cfg.succs[a.from].size() != cfg.succs[b.from].size()) return cfg.succs[a.from].size() < cfg.succs[b.from].size();
+        return orig_pos[cfg.blocks[a.from]] < orig_pos[cfg.blocks[b.from]];
+    });
+
+    //从最重的边开始，把链尾和链头连起来；入口块必须是第一条链的链头
+    vector<vector<int>> chains(n);
+    vector<int> chain_of(n);
+    for(int i = 0; i < n; i++){
+        chains[i] = {i};
+        chain_of[i] = i;
+    }
+    for(const Edge &e : edges){
+        int cu = chain_of[e.from], cv = chain_of[e.to];
+        if(cu == cv || e.to == 0) continue;
+        if(chains[cu].back() != e.from || chains[cv].front() != e.to) continue;
+        for(int b : chains[cv]){
+            chain_of[b] = cu;
+            chains[cu].push_back(b);
+        }
+        chains[cv].clear();
+    }
+
+    //排链：每次选与已排好的块之间边权最大的链，没有联系时按原顺序
+    vector<double> score(n, -1);
+    vector<bool> placed(n, false);
+    vector<koopa_raw_basic_block_t> order;
+    int cur = chain_of[0];
+    while(cur >= 0){
+        placed[cur] = true;
+        for(int b : chains[cur]){
+            order.push_back(cfg.blocks[b]);
+        }
+        for(const Edge &e : edges){
+            if(chain_of[e.from] == cur){
+                int c = chain_of[e.to];
+                score[c] = max(score[c], e.weight);
+            }
+        }
+        cur = -1;
+        for(int c = 0; c < n; c++){
+            if(chains[c].empty() || placed[c]) continue;
+            if(cur < 0 || score[c] > score[cur] ||
+               (score[c] == score[cur] && orig_pos[cfg.blocks[chains[c][0]]] < orig_pos[cfg.blocks[chains[cur][0]]])){
+                cur = c;
+            }
+        }
+    }
+
+    //不可达的块不在 CFG 中，保持原来的相对顺序放在最后
+    for(size_t i = 0; i < func->bbs.len; i++){
+        koopa_raw_basic_block_t bb = (koopa_raw_basic_block_t) func->bbs.buffer[i];
+        if(cfg.index.count(bb) == 0) order.push_back(bb);
+    }
+    koopa_raw_slice_t &bbs = AsMutable(func)->bbs;
+    for(size_t i = 0; i < bbs.len; i++){
+        bbs.buffer[i] = order[i];
+    }
+}
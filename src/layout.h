@@ -0,0 +1,16 @@
+#pragma once
+#include "koopa.h"
+#include "profile.h"
+using namespace std;
+
+//基本块排布：按 Pettis-Hansen 的方法把最热的边连成链，让热的后继紧跟在跳转之后
+//有 -fprofile-use 的数据时用实际执行次数，否则用循环层数估计执行频率；后端的窥孔优化会删掉落空的 j 并反转分支
+class BlockLayoutPass {
+public:
+    explicit BlockLayoutPass(const BlockProfile *profile = nullptr) : profile(profile) {}
+    void Run(const koopa_raw_program_t &program);
+private:
+    const BlockProfile *profile;
+
+    void RunOnFunction(koopa_raw_function_t func);
+};
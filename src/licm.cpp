@@ -0,0 +1,207 @@
+#include "licm.h"
+#include "cfg.h"
+#include "irutil.h"
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+using namespace std;
+
+//地址一定合法：直接是变量，或者是下标都为常量且不越界的 getelemptr
+static bool AlwaysValid(koopa_raw_value_t ptr){
+    while(ptr->kind.tag == KOOPA_RVT_GET_ELEM_PTR){
+        const auto &gep = ptr->kind.data.get_elem_ptr;
+        if(gep.index->kind.tag != KOOPA_RVT_INTEGER) return false;
+        int idx = gep.index->kind.data.integer.value;
+        if(idx < 0 || idx >= (int) gep.src->ty->data.pointer.base->data.array.len) return false;
+        ptr = gep.src;
+    }
+    return IsIdentified(ptr);
+}
+
+void LICMPass::Run(const koopa_raw_program_t &program){
+    for(size_t i = 0; i < program.funcs.len; i++){
+        koopa_raw_function_t func = (koopa_raw_function_t) program.funcs.buffer[i];
+        if(func->bbs.len == 0) continue;
+        RunOnFunction(func);
+    }
+}
+
+//循环头在循环外只有一个前驱并且是无条件跳转时，这个前驱就是前置块
+//否则新建一个块：循环外的边都改为跳到它，它再带着同样的块参数跳到循环头
+bool LICMPass::InsertPreheaders(koopa_raw_function_t func){
+    CFG cfg(func);
+    vector<Loop> loops = cfg.FindLoops();
+    if(loops.empty()) return false;
+
+    vector<koopa_raw_basic_block_t> bbs;
+    for(size_t i = 0; i < func->bbs.len; i++){
+        bbs.push_back((koopa_raw_basic_block_t) func->bbs.buffer[i]);
+    }
+    bool changed = false;
+    for(const Loop &loop : loops){
+        koopa_raw_basic_block_t header = cfg.blocks[loop.header];
+        vector<int> outside;
+        for(int p : cfg.preds[loop.header]){
+            if(!binary_search(loop.blocks.begin(), loop.blocks.end(), p)) outside.push_back(p);
+        }
+        if(outside.size() == 1){
+            koopa_raw_basic_block_t pred = cfg.blocks[outside[0]];
+            koopa_raw_value_t term = (koopa_raw_value_t) pred->insts.buffer[pred->insts.len - 1];
+            if(term->kind.tag == KOOPA_RVT_JUMP) continue;
+        }
+
+        string name = string(header->name ? header->name : "%loop") + "_pre" + to_string(preheader_cnt++);
+        koopa_raw_basic_block_data_t *pre = arena.NewBlock(arena.NewName(name));
+        vector<koopa_raw_value_t> params;
+        for(size_t i = 0; i < header->params.len; i++){
+            koopa_raw_value_t p = (koopa_raw_value_t) header->params.buffer[i];
+            koopa_raw_value_data_t *param = arena.NewValue(p->ty, arena.NewName(name + "_" + to_string(i)), KOOPA_RVT_BLOCK_ARG_REF);
+            param->kind.data.block_arg_ref.index = i;
+            params.push_back(param);
+        }
+        pre->params = arena.NewSlice(params, KOOPA_RSIK_VALUE);
+        koopa_raw_value_data_t *jump = arena.NewValue(arena.UnitType(), nullptr, KOOPA_RVT_JUMP);
+        jump->kind.data.jump.target = header;
+        jump->kind.data.jump.args = arena.NewSlice(params, KOOPA_RSIK_VALUE);
+        pre->insts = arena.NewSlice(vector<koopa_raw_value_t>{jump}, KOOPA_RSIK_VALUE);
+
+        for(int p : outside){
+            koopa_raw_basic_block_t pred = cfg.blocks[p];
+            auto &kind = AsMutable((koopa_raw_value_t) pred->insts.buffer[pred->insts.len - 1])->kind;
+            if(kind.tag == KOOPA_RVT_JUMP){
+                kind.data.jump.target = pre;
+            }else if(kind.tag == KOOPA_RVT_BRANCH){
+                if(kind.data.branch.true_bb == header) kind.data.branch.true_bb = pre;
+                if(kind.data.branch.false_bb == header) kind.data.branch.false_bb = pre;
+            }
+        }
+        bbs.insert(find(bbs.begin(), bbs.end(), header), pre);
+        changed = true;
+
+        //进入循环的次数 = 循环头的次数 - 回边的次数
+        double count;
+        if(profile && profile->Lookup(header, count)){
+            for(int l : loop.latches){
+                double latch_count;
+                if(profile->Lookup(cfg.blocks[l], latch_count)) count -= latch_count;
+            }
+            profile->Set(pre, max(count, 0.0));
+        }
+    }
+    if(changed){
+        AsMutable(func)->bbs = arena.NewSlice(bbs, KOOPA_RSIK_BASIC_BLOCK);
+    }
+    return changed;
+}
+
+void LICMPass::RunOnFunction(koopa_raw_function_t func){
+    InsertPreheaders(func);
+    CFG cfg(func);
+    vector<Loop> loops = cfg.FindLoops();
+    if(loops.empty()) return;
+
+    int n = cfg.Size();
+    vector<vector<koopa_raw_value_t>> insts(n);
+    unordered_map<koopa_raw_value_t, int> def_block;
+    unordered_set<koopa_raw_value_t> escaped = CollectEscapedRoots(func);
+    for(int b = 0; b < n; b++){
+        koopa_raw_basic_block_t bb = cfg.blocks[b];
+        for(size_t i = 0; i < bb->params.len; i++){
+            def_block[(koopa_raw_value_t) bb->params.buffer[i]] = b;
+        }
+        for(size_t i = 0; i < bb->insts.len; i++){
+            koopa_raw_value_t inst = (koopa_raw_value_t) bb->insts.buffer[i];
+            def_block[inst] = b;
+            insts[b].push_back(inst);
+        }
+    }
+
+    bool changed = false;
+    //内层循环先处理，提到内层前置块里的指令还可以继续提到外层
+    for(auto loop = loops.rbegin(); loop != loops.rend(); ++loop){
+        vector<bool> in_loop(n, false);
+        for(int b : loop->blocks) in_loop[b] = true;
+        int pre = -1;
+        for(int p : cfg.preds[loop->header]){
+            if(!in_loop[p]) pre = p;
+        }
+
+        //循环里写了哪些对象、有没有调用，以及从哪些块离开循环
+        bool has_call = false;
+        vector<koopa_raw_value_t> store_roots;
+        vector<int> exiting;
+        for(int b : loop->blocks){
+            for(auto inst : insts[b]){
+                if(inst->kind.tag == KOOPA_RVT_STORE){
+                    store_roots.push_back(PointerRoot(inst->kind.data.store.dest));
+                }else if(inst->kind.tag == KOOPA_RVT_CALL){
+                    has_call = true;
+                }
+            }
+            for(int s : cfg.succs[b]){
+                if(!in_loop[s]){
+                    exiting.push_back(b);
+                    break;
+                }
+            }
+        }
+
+        auto invariant = [&](koopa_raw_value_t v){
+            if(v->kind.tag == KOOPA_RVT_ALLOC) return true;
+            auto it = def_block.find(v);
+            return it == def_block.end() || !in_loop[it->second];
+        };
+        auto not_written = [&](koopa_raw_value_t ptr){
+            koopa_raw_value_t root = PointerRoot(ptr);
+            if(has_call && (root->kind.tag != KOOPA_RVT_ALLOC || escaped.count(root))) return false;
+            for(auto r : store_roots){
+                if(MayAlias(r, root)) return false;
+            }
+            return true;
+        };
+        //提到前置块后无论循环是否执行到它都会执行，地址不一定合法时要求它本来每次都会执行
+        auto always_executed = [&](int b){
+            for(int e : exiting){
+                if(!cfg.Dominates(b, e)) return false;
+            }
+            return true;
+        };
+        auto hoistable = [&](koopa_raw_value_t inst, int b){
+            const auto &kind = inst->kind;
+            switch(kind.tag){
+                case KOOPA_RVT_BINARY:
+                    return invariant(kind.data.binary.lhs) && invariant(kind.data.binary.rhs);
+                case KOOPA_RVT_GET_ELEM_PTR:
+                    return invariant(kind.data.get_elem_ptr.src) && invariant(kind.data.get_elem_ptr.index);
+                case KOOPA_RVT_GET_PTR:
+                    return invariant(kind.data.get_ptr.src) && invariant(kind.data.get_ptr.index);
+                case KOOPA_RVT_LOAD:
+                    return invariant(kind.data.load.src) && not_written(kind.data.load.src) &&
+                           (AlwaysValid(kind.data.load.src) || always_executed(b));
+                default:
+                    return false;
+            }
+        };
+
+        //按逆后序遍历，操作数一定先于使用者被处理
+        for(int b : loop->blocks){
+            vector<koopa_raw_value_t> kept;
+            for(auto inst : insts[b]){
+                if(!hoistable(inst, b)){
+                    kept.push_back(inst);
+                    continue;
+                }
+                insts[pre].insert(insts[pre].end() - 1, inst);
+                def_block[inst] = pre;
+                changed = true;
+            }
+            insts[b] = move(kept);
+        }
+    }
+    if(!changed) return;
+    for(int b = 0; b < n; b++){
+        AsMutable(cfg.blocks[b])->insts = arena.NewSlice(insts[b], KOOPA_RSIK_VALUE);
+    }
+}
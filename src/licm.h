@@ -0,0 +1,21 @@
+#pragma once
+#include "koopa.h"
+#include "rawir.h"
+#include "profile.h"
+using namespace std;
+
+//循环不变量外提：先给每个循环准备唯一的前置块，再由内向外把不变的纯计算
+//（二元运算、getelemptr/getptr）以及循环中不会被写到的 load 移到前置块末尾
+class LICMPass {
+public:
+    //profile 不为空时给新建的前置块估计执行次数
+    explicit LICMPass(RawIRArena &arena, BlockProfile *profile = nullptr) : arena(arena), profile(profile) {}
+    void Run(const koopa_raw_program_t &program);
+private:
+    RawIRArena &arena;
+    BlockProfile *profile;
+    int preheader_cnt = 0;
+    void RunOnFunction(koopa_raw_function_t func);
+    //返回是否新建了前置块
+    bool InsertPreheaders(koopa_raw_function_t func);
+};
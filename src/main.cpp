@@ -1,28 +1,30 @@
 #include <cassert>
-#include <cstdio>
+#include <cstdlib>
 #include <iostream>
-#include <memory>
 #include <string>
-#include <fstream>
-#include "ast.h"
-#include "visit.h"
+#include "driver.h"
+#include "daemon.h"
+#include "cache.h"
 using namespace std;
 
-extern FILE *yyin;
-extern int yyparse(unique_ptr<BaseAST> &ast);
-//函数声明
-
 int main(int argc, const char *argv[]) {
-  assert(argc == 5);
+  assert(argc >= 2);
     // 初始化变量
     std::string mode;        
     std::string input_file;   
     std::string output_file;  
-    cout << "test" << endl; 
+    int jobs = 1;             // -j N：后端并行生成代码的线程数
+    std::string report_file;  // -time-report FILE：各阶段耗时和规模写成 JSON
+    std::string profile_gen;  // -fprofile-generate FILE：-interp 时把基本块计数写进 FILE
+    std::string profile_use;  // -fprofile-use FILE：-riscv 时按 FILE 里的计数做优化
+    std::string cache_dir;    // -cache DIR：按内容寻址的编译缓存
+    uint64_t cache_size = 256ull << 20;  // -cache-size MB：缓存总大小的上限
+    bool cache_stats = false; // -cache-stats：打印缓存的命中率后退出
+    std::string daemon_socket;  // -daemon SOCKET：常驻进程，在 SOCKET 上接收编译请求，-j 是并发编译数
      // 正确解析命令行参数：-koopa input -o output
     for (int i = 1; i < argc; i++) {
         std::string arg = argv[i];
-        if (arg == "-koopa" || arg == "-riscv") {  // 识别选项 -koopa
+        if (arg == "-koopa" || arg == "-riscv" || arg == "-interp") {  // 识别选项 -koopa
             mode = arg.substr(1);     // mode 赋值为 "koopa" 或 "riscv"（不带 -）
             // 下一个参数是输入文件
             if (i + 1 < argc) {
@@ -31,6 +33,50 @@ int main(int argc, const char *argv[]) {
                 std::cerr << "错误：-koopa 后必须指定输入文件！" << std::endl;
                 return 1;
             }
+        } else if (arg == "-j") {  // 识别选项 -j N
+            if (i + 1 < argc) {
+                jobs = atoi(argv[++i]);
+            }
+            if (jobs < 1) {
+                std::cerr << "错误：-j 后必须指定正整数线程数！" << std::endl;
+                return 1;
+            }
+        } else if (arg == "-time-report") {  // 识别选项 -time-report FILE
+            if (i + 1 < argc) {
+                report_file = argv[++i];
+            } else {
+                std::cerr << "错误：-time-report 后必须指定输出文件！" << std::endl;
+                return 1;
+            }
+        } else if (arg == "-fprofile-generate" || arg == "-fprofile-use") {  // 识别选项 -fprofile-* FILE
+            if (i + 1 >= argc) {
+                std::cerr << "错误：" << arg << " 后必须指定 profile 文件！" << std::endl;
+                return 1;
+            }
+            (arg == "-fprofile-generate" ? profile_gen : profile_use) = argv[++i];
+        } else if (arg == "-cache") {  // 识别选项 -cache DIR
+            if (i + 1 < argc) {
+                cache_dir = argv[++i];
+            } else {
+                std::cerr << "错误：-cache 后必须指定缓存目录！" << std::endl;
+                return 1;
+            }
+        } else if (arg == "-cache-size") {  // 识别选项 -cache-size MB
+            long long mb = i + 1 < argc ? atoll(argv[++i]) : 0;
+            if (mb < 1) {
+                std::cerr << "错误：-cache-size 后必须指定正整数（MB）！" << std::endl;
+                return 1;
+            }
+            cache_size = (uint64_t) mb << 20;
+        } else if (arg == "-cache-stats") {  // 识别选项 -cache-stats
+            cache_stats = true;
+        } else if (arg == "-daemon") {  // 识别选项 -daemon SOCKET
+            if (i + 1 < argc) {
+                daemon_socket = argv[++i];
+            } else {
+                std::cerr << "错误：-daemon 后必须指定套接字路径！" << std::endl;
+                return 1;
+            }
         } else if (arg == "-o") {  // 识别选项 -o
             // 下一个参数是输出文件
             if (i + 1 < argc) {
@@ -44,66 +90,41 @@ int main(int argc, const char *argv[]) {
             return 1;
         }
     }
+    if (cache_stats) {
+        if (cache_dir.empty()) {
+            std::cerr << "错误：-cache-stats 需要用 -cache 指定缓存目录！" << std::endl;
+            return 1;
+        }
+        CompileCache(cache_dir, cache_size).WriteStats(std::cout);
+        return 0;
+    }
+    if (!daemon_socket.empty()) {
+        // 请求里只有模式和文件，编译缓存的设置沿用启动时的命令行
+        CompileOptions defaults;
+        defaults.cache_dir = cache_dir;
+        defaults.cache_size = cache_size;
+        return RunDaemon(daemon_socket, jobs, defaults);
+    }
+    // 计数由解释器收集，优化只在生成汇编时用得上
+    if ((!profile_gen.empty() && mode != "interp") || (!profile_use.empty() && mode != "riscv")) {
+        std::cerr << "错误：-fprofile-generate 只能配合 -interp，-fprofile-use 只能配合 -riscv！" << std::endl;
+        return 1;
+    }
   
   // 打印解析结果（调试用）
   std::cout << "mode: " << mode << std::endl;
   std::cout << "input_file: " << input_file << std::endl;
   std::cout << "output_file: " << output_file << std::endl;
 
-  //打开输入文件
-  yyin = fopen(input_file.c_str(), "r");
-  assert(yyin);
-
-  unique_ptr<BaseAST> ast;
-  auto ret = yyparse(ast);
-  assert(!ret);
-  fclose(yyin);
-
-  if (ast) { // 加上这层保护！
-      cout << "AST 结构" << endl;
-  } else {
-      cerr << "Compiler Error: Parsing failed, AST is null!" << endl;
-      return 1; // 发生语法错误，返回非0状态码
-  }
-  cout << "test" << endl;
-  string koopa_ir = ast->GenKoopaIR();
-  cout << "test" << endl;
-  if(mode == "koopa"){
-      cout << "Koopa IR 代码" << endl;
-      cout << koopa_ir;
-      ofstream out(output_file);
-      assert(out.is_open());
-      out << koopa_ir;
-      out.close();
-    }else if(mode == "riscv"){
-      koopa_program_t program ;
-      koopa_error_code_t ret = koopa_parse_from_string(koopa_ir.c_str(),&program);
-      assert(ret == KOOPA_EC_SUCCESS);
-
-
-      koopa_raw_program_builder_t builder = koopa_new_raw_program_builder();
-      koopa_raw_program_t raw = koopa_build_raw_program(builder, program);
-      koopa_delete_program(program);
-
-
-      freopen(output_file.c_str(), "w", stdout);
-
-        // 2. 遍历 raw 结构，开始输出汇编
-      AsmGenerator gen;
-
-      gen.Generate(raw);
-
-        // 恢复 stdout 并清理
-      fclose(stdout);
-
-
-      //处理完成释放raw program builder占用的内存
-      koopa_delete_raw_program_builder(builder);
-    }else{
-      cout << "the output file is empty" << endl;
-    }
-  
-  
-  return 0;
+  CompileOptions opt;
+  opt.mode = mode;
+  opt.input_file = input_file;
+  opt.output_file = output_file;
+  opt.jobs = jobs;
+  opt.report_file = report_file;
+  opt.profile_gen = profile_gen;
+  opt.profile_use = profile_use;
+  opt.cache_dir = cache_dir;
+  opt.cache_size = cache_size;
+  return Compile(opt, cerr);
 }
-
@@ -0,0 +1,215 @@
+#include "mem2reg.h"
+#include "cfg.h"
+#include "irutil.h"
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+using namespace std;
+
+void Mem2RegPass::Run(const koopa_raw_program_t &program){
+    for(size_t i = 0; i < program.funcs.len; i++){
+        koopa_raw_function_t func = (koopa_raw_function_t) program.funcs.buffer[i];
+        if(func->bbs.len == 0) continue;
+        RunOnFunction(func);
+    }
+}
+
+void Mem2RegPass::RunOnFunction(koopa_raw_function_t func){
+    //不可达块里的 load 没法重命名，先删掉
+    RemoveUnreachableBlocks(func);
+
+    //1. 找出可以提升的 alloc：类型是 *i32，且只作为 load 的源或 store 的目标出现
+    unordered_map<koopa_raw_value_t, int> alloc_index;
+    vector<koopa_raw_value_t> allocs;
+    for(size_t i = 0; i < func->bbs.len; i++){
+        koopa_raw_basic_block_t bb = (koopa_raw_basic_block_t) func->bbs.buffer[i];
+        for(size_t j = 0; j < bb->insts.len; j++){
+            koopa_raw_value_t inst = (koopa_raw_value_t) bb->insts.buffer[j];
+            if(inst->kind.tag == KOOPA_RVT_ALLOC && inst->ty->data.pointer.base->tag == KOOPA_RTT_INT32){
+                alloc_index[inst] = allocs.size();
+                allocs.push_back(inst);
+            }
+        }
+    }
+    if(allocs.empty()) return;
+
+    vector<bool> promotable(allocs.size(), true);
+    for(size_t i = 0; i < func->bbs.len; i++){
+        koopa_raw_basic_block_t bb = (koopa_raw_basic_block_t) func->bbs.buffer[i];
+        for(size_t j = 0; j < bb->insts.len; j++){
+            koopa_raw_value_t inst = (koopa_raw_value_t) bb->insts.buffer[j];
+            bool is_load = inst->kind.tag == KOOPA_RVT_LOAD;
+            bool is_store = inst->kind.tag == KOOPA_RVT_STORE;
+            ForEachOperand(inst, [&](koopa_raw_value_t op){
+                auto it = alloc_index.find(op);
+                if(it == alloc_index.end()) return;
+                bool ok = (is_load && inst->kind.data.load.src == op) ||
+                          (is_store && inst->kind.data.store.dest == op && inst->kind.data.store.value != op);
+                if(!ok) promotable[it->second] = false;
+            });
+        }
+    }
+
+    CFG cfg(func);
+    int n = cfg.Size();
+
+    //2. 在迭代支配边界上插入基本块参数
+    vector<vector<bool>> def_blocks(allocs.size(), vector<bool>(n, false));
+    for(int b = 0; b < n; b++){
+        koopa_raw_basic_block_t bb = cfg.blocks[b];
+        for(size_t j = 0; j < bb->insts.len; j++){
+            koopa_raw_value_t inst = (koopa_raw_value_t) bb->insts.buffer[j];
+            if(inst->kind.tag != KOOPA_RVT_STORE) continue;
+            auto it = alloc_index.find(inst->kind.data.store.dest);
+            if(it != alloc_index.end() && promotable[it->second]){
+                def_blocks[it->second][b] = true;
+            }
+        }
+    }
+
+    vector<vector<int>> frontier = cfg.ComputeFrontier();
+    //new_params[b]：块 b 新增的参数，(alloc 编号, 参数值)
+    vector<vector<pair<int, koopa_raw_value_t>>> new_params(n);
+    int param_cnt = 0;
+    for(size_t a = 0; a < allocs.size(); a++){
+        if(!promotable[a]) continue;
+        vector<bool> has_param(n, false);
+        vector<int> work;
+        for(int b = 0; b < n; b++){
+            if(def_blocks[a][b]) work.push_back(b);
+        }
+        vector<bool> in_work = def_blocks[a];
+        while(!work.empty()){
+            int b = work.back();
+            work.pop_back();
+            for(int f : frontier[b]){
+                if(has_param[f]) continue;
+                has_param[f] = true;
+
+                koopa_raw_basic_block_t bb = cfg.blocks[f];
+                string alloc_name = allocs[a]->name ? allocs[a]->name + 1 : "v";
+                string name = "%" + alloc_name + "_phi_" + to_string(param_cnt++);
+                koopa_raw_value_data_t *param = arena.NewValue(allocs[a]->ty->data.pointer.base,
+                                                               arena.NewName(name), KOOPA_RVT_BLOCK_ARG_REF);
+                param->kind.data.block_arg_ref.index = bb->params.len + new_params[f].size();
+                new_params[f].push_back({(int)a, param});
+
+                if(!in_work[f]){
+                    in_work[f] = true;
+                    work.push_back(f);
+                }
+            }
+        }
+    }
+    for(int b = 0; b < n; b++){
+        if(new_params[b].empty()) continue;
+        koopa_raw_basic_block_t bb = cfg.blocks[b];
+        vector<koopa_raw_value_t> params;
+        for(size_t i = 0; i < bb->params.len; i++){
+            params.push_back((koopa_raw_value_t) bb->params.buffer[i]);
+        }
+        for(auto &p : new_params[b]){
+            params.push_back(p.second);
+        }
+        AsMutable(bb)->params = arena.NewSlice(params, KOOPA_RSIK_VALUE);
+    }
+
+    //3. 沿支配树重命名：load 替换成当前值，store 压入新值，跳转时把当前值作为实参传给后继
+    unordered_map<koopa_raw_value_t, koopa_raw_value_t> replace;
+    auto resolve = [&](koopa_raw_value_t v){
+        auto it = replace.find(v);
+        while(it != replace.end()){
+            v = it->second;
+            it = replace.find(v);
+        }
+        return v;
+    };
+    koopa_raw_value_t undef = arena.Integer(0);   //未初始化的局部变量按 0 处理
+    vector<vector<koopa_raw_value_t>> cur_val(allocs.size());
+    auto top = [&](int a){
+        return cur_val[a].empty() ? undef : cur_val[a].back();
+    };
+    unordered_set<koopa_raw_value_t> dead;
+
+    auto append_args = [&](koopa_raw_slice_t &args, koopa_raw_basic_block_t target){
+        auto &params = new_params[cfg.index[target]];
+        if(params.empty()) return;
+        vector<koopa_raw_value_t> vals;
+        for(size_t i = 0; i < args.len; i++){
+            vals.push_back((koopa_raw_value_t) args.buffer[i]);
+        }
+        for(auto &p : params){
+            vals.push_back(top(p.first));
+        }
+        args = arena.NewSlice(vals, KOOPA_RSIK_VALUE);
+    };
+
+    //显式栈模拟递归，pushed 记录每个块压栈的 alloc 以便回溯
+    vector<vector<int>> pushed(n);
+    vector<pair<int, bool>> stack = {{0, false}};
+    while(!stack.empty()){
+        auto [b, leaving] = stack.back();
+        stack.pop_back();
+        if(leaving){
+            for(int a : pushed[b]) cur_val[a].pop_back();
+            continue;
+        }
+
+        for(auto &p : new_params[b]){
+            cur_val[p.first].push_back(p.second);
+            pushed[b].push_back(p.first);
+        }
+        koopa_raw_basic_block_t bb = cfg.blocks[b];
+        for(size_t j = 0; j < bb->insts.len; j++){
+            koopa_raw_value_t inst = (koopa_raw_value_t) bb->insts.buffer[j];
+            if(inst->kind.tag == KOOPA_RVT_LOAD){
+                auto it = alloc_index.find(inst->kind.data.load.src);
+                if(it != alloc_index.end() && promotable[it->second]){
+                    replace[inst] = top(it->second);
+                    dead.insert(inst);
+                    continue;
+                }
+            }else if(inst->kind.tag == KOOPA_RVT_STORE){
+                auto it = alloc_index.find(inst->kind.data.store.dest);
+                if(it != alloc_index.end() && promotable[it->second]){
+                    cur_val[it->second].push_back(resolve(inst->kind.data.store.value));
+                    pushed[b].push_back(it->second);
+                    dead.insert(inst);
+                    continue;
+                }
+            }else if(inst->kind.tag == KOOPA_RVT_ALLOC){
+                auto it = alloc_index.find(inst);
+                if(it != alloc_index.end() && promotable[it->second]){
+                    dead.insert(inst);
+                    continue;
+                }
+            }
+
+            //被支配的使用点一定在定义之后处理，这里可以直接改写
+            ForEachOperandRef(inst, [&](koopa_raw_value_t &op){
+                op = resolve(op);
+            });
+            if(inst->kind.tag == KOOPA_RVT_JUMP){
+                auto &jump = AsMutable(inst)->kind.data.jump;
+                append_args(jump.args, jump.target);
+            }else if(inst->kind.tag == KOOPA_RVT_BRANCH){
+                auto &branch = AsMutable(inst)->kind.data.branch;
+                append_args(branch.true_args, branch.true_bb);
+                append_args(branch.false_args, branch.false_bb);
+            }
+        }
+
+        stack.push_back({b, true});
+        for(auto it = cfg.dom_children[b].rbegin(); it != cfg.dom_children[b].rend(); ++it){
+            stack.push_back({*it, false});
+        }
+    }
+
+    //4. 删除已经提升的 alloc / load / store
+    for(int b = 0; b < n; b++){
+        FilterSlice<koopa_raw_value_t>(AsMutable(cfg.blocks[b])->insts, [&](koopa_raw_value_t inst){
+            return dead.count(inst) == 0;
+        });
+    }
+}
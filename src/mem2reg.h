@@ -0,0 +1,15 @@
+#pragma once
+#include "koopa.h"
+#include "rawir.h"
+using namespace std;
+
+//把只被 load/store 访问的 alloc i32 提升成 SSA 值
+//需要合并的地方使用 Koopa 的基本块参数（相当于 phi）
+class Mem2RegPass {
+public:
+    explicit Mem2RegPass(RawIRArena &arena) : arena(arena) {}
+    void Run(const koopa_raw_program_t &program);
+private:
+    RawIRArena &arena;
+    void RunOnFunction(koopa_raw_function_t func);
+};
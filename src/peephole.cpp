@@ -0,0 +1,328 @@
+#include "peephole.h"
+#include "regalloc.h"
+#include <cctype>
+#include <cstdlib>
+#include <unordered_set>
+using namespace std;
+
+static bool IsBranch(const string &op){
+    return op == "beqz" || op == "bnez" || op == "beq" || op == "bne" ||
+           op == "blt" || op == "bge" || op == "bltu" || op == "bgeu";
+}
+
+//t0~t2 是后端的临时寄存器，只在生成单条 Koopa 指令的几行汇编内有效，不会跨越标签和跳转
+static bool IsScratch(const string &reg){
+    return reg == "t0" || reg == "t1" || reg == "t2";
+}
+
+//调用会破坏的寄存器
+static bool IsCallerSaved(const string &reg){
+    return reg == "ra" || (reg.size() == 2 && (reg[0] == 't' || reg[0] == 'a') && isdigit(reg[1]));
+}
+
+static bool IsReg(const string &s){
+    static const unordered_set<string> regs = [](){
+        unordered_set<string> names;
+        for(int i = 0; i < 32; i++) names.insert(RegAllocator::RegName(i));
+        return names;
+    }();
+    return regs.count(s) > 0;
+}
+
+static bool FitsImm12(long long v){
+    return v >= -2048 && v <= 2047;
+}
+
+static bool ParseInt(const string &s, long long &v){
+    if(s.empty()) return false;
+    char *end = nullptr;
+    v = strtoll(s.c_str(), &end, 10);
+    return *end == '\0';
+}
+
+//指令写入的寄存器，没有时返回空串
+static string Def(const AsmInst &inst){
+    if(inst.IsLabel() || inst.args.empty()) return "";
+    const string &op = inst.op;
+    if(op == "sw" || op == "j" || op == "call" || op == "ret" || IsBranch(op)) return "";
+    return inst.args[0];
+}
+
+//指令读取的寄存器，访存操作数取其基址寄存器
+static vector<string> Uses(const AsmInst &inst){
+    vector<string> uses;
+    if(inst.op == "call"){
+        for(int i = 0; i < 8; i++) uses.push_back("a" + to_string(i));
+        return uses;
+    }
+    if(inst.op == "ret"){
+        uses.push_back("a0");
+        uses.push_back("ra");
+        uses.push_back("sp");
+        return uses;
+    }
+    for(size_t k = Def(inst).empty() ? 0 : 1; k < inst.args.size(); k++){
+        const string &arg = inst.args[k];
+        size_t lp = arg.find('(');
+        if(lp != string::npos && arg.back() == ')'){
+            uses.push_back(arg.substr(lp + 1, arg.size() - lp - 2));
+        }else if(IsReg(arg)){
+            uses.push_back(arg);
+        }
+    }
+    return uses;
+}
+
+void PeepholePass::Run(vector<AsmInst> &insts){
+    using Rule = bool (PeepholePass::*)(size_t);
+    static const Rule rules[] = {
+        &PeepholePass::ForwardStoreLoad,
+        &PeepholePass::SimplifyZero,
+        &PeepholePass::FoldImmediate,
+        &PeepholePass::ForwardMove,
+        &PeepholePass::ThreadJump,
+        &PeepholePass::RemoveFallthrough,
+    };
+
+    this->insts = &insts;
+    removed.assign(insts.size(), false);
+    bool changed = true;
+    while(changed){
+        changed = false;
+        //同一轮扫描里只做标记不挪动元素，标签位置保持有效
+        label_pos.clear();
+        for(size_t i = 0; i < insts.size(); i++){
+            if(!removed[i] && insts[i].IsLabel()) label_pos[insts[i].label] = i;
+        }
+        for(size_t i = 0; i < insts.size(); i++){
+            if(removed[i] || insts[i].IsLabel()) continue;
+            for(Rule rule : rules){
+                if((this->*rule)(i)){
+                    changed = true;
+                    if(removed[i]) break;
+                }
+            }
+        }
+    }
+
+    size_t kept = 0;
+    for(size_t i = 0; i < insts.size(); i++){
+        if(removed[i]) continue;
+        if(kept != i) insts[kept] = move(insts[i]);
+        kept++;
+    }
+    insts.resize(kept);
+    this->insts = nullptr;
+}
+
+size_t PeepholePass::Next(size_t i) const {
+    size_t j = i + 1;
+    while(j < insts->size() && removed[j]) j++;
+    return j;
+}
+
+void PeepholePass::Remove(size_t i){
+    removed[i] = true;
+}
+
+//第 i 条指令之后 reg 的值是否不再被读取，只在当前基本块内向后看
+//临时寄存器不跨块；其他寄存器遇到标签或跳转时保守地认为仍然活跃
+bool PeepholePass::DeadAfter(size_t i, const string &reg) const {
+    bool scratch = IsScratch(reg);
+    for(size_t j = Next(i); j < insts->size(); j = Next(j)){
+        const AsmInst &inst = (*insts)[j];
+        if(inst.IsLabel()) return scratch;
+        for(const string &use : Uses(inst)){
+            if(use == reg) return false;
+        }
+        if(Def(inst) == reg || inst.op == "ret") return true;
+        if(inst.op == "call") return IsCallerSaved(reg);
+        if(inst.op == "j" || IsBranch(inst.op)) return scratch;
+    }
+    return true;
+}
+
+//label 处如果紧跟着 j，顺着跳转链找到最终目标
+string PeepholePass::ResolveJump(const string &label) const {
+    string cur = label;
+    for(int hops = 0; hops < 8; hops++){
+        auto it = label_pos.find(cur);
+        if(it == label_pos.end()) break;
+        size_t k = Next(it->second);
+        while(k < insts->size() && (*insts)[k].IsLabel()) k = Next(k);
+        if(k >= insts->size() || (*insts)[k].op != "j" || (*insts)[k].args[0] == cur) break;
+        cur = (*insts)[k].args[0];
+    }
+    return cur;
+}
+
+//sw r, M 后紧跟 lw r', M：直接用 r；lw r, M 后紧跟 sw r, M：store 是多余的
+bool PeepholePass::ForwardStoreLoad(size_t i){
+    AsmInst &a = (*insts)[i];
+    size_t n = Next(i);
+    if(n >= insts->size() || a.args.size() != 2) return false;
+    AsmInst &b = (*insts)[n];
+    if(b.args.size() != 2 || b.args[1] != a.args[1]) return false;
+    if(a.op == "sw" && b.op == "lw"){
+        if(b.args[0] == a.args[0]){
+            Remove(n);
+        }else{
+            b.op = "mv";
+            b.args[1] = a.args[0];
+        }
+        return true;
+    }
+    if(a.op == "lw" && b.op == "sw" && b.args[0] == a.args[0]){
+        //lw 覆盖了自己的基址寄存器时两次访问的地址不同
+        if(Uses(a)[0] == a.args[0]) return false;
+        Remove(n);
+        return true;
+    }
+    return false;
+}
+
+//和 x0 做运算退化为 mv；mv 后紧跟对同一寄存器的 seqz/snez 直接作用在源寄存器上
+bool PeepholePass::SimplifyZero(size_t i){
+    AsmInst &a = (*insts)[i];
+    const string &op = a.op;
+    if(a.args.size() == 3){
+        bool comm = op == "add" || op == "or" || op == "xor";
+        if((comm || op == "sub") && a.args[2] == "x0"){
+            a = AsmInst{"mv", {a.args[0], a.args[1]}, ""};
+            return true;
+        }
+        if(comm && a.args[1] == "x0"){
+            a = AsmInst{"mv", {a.args[0], a.args[2]}, ""};
+            return true;
+        }
+        if(op == "addi" && a.args[2] == "0"){
+            a = AsmInst{"mv", {a.args[0], a.args[1]}, ""};
+            return true;
+        }
+        return false;
+    }
+    if(op != "mv") return false;
+    if(a.args[0] == a.args[1]){
+        Remove(i);
+        return true;
+    }
+    size_t n = Next(i);
+    if(n >= insts->size()) return false;
+    AsmInst &b = (*insts)[n];
+    if((b.op == "seqz" || b.op == "snez") && b.args[0] == a.args[0] && b.args[1] == a.args[0]){
+        b.args[1] = a.args[1];
+        Remove(i);
+        return true;
+    }
+    return false;
+}
+
+//op rd, ...; mv rx, rd 且 rd 之后不再使用：直接算到 rx 里
+//小函数返回前的 mv a0, rd 和调用前准备实参的 mv 大多属于这种情况
+bool PeepholePass::ForwardMove(size_t i){
+    AsmInst &a = (*insts)[i];
+    string def = Def(a);
+    size_t n = Next(i);
+    if(def.empty() || def == "x0" || def == "sp" || n >= insts->size()) return false;
+    AsmInst &b = (*insts)[n];
+    if(b.op != "mv" || b.args[1] != def || b.args[0] == def || !DeadAfter(n, def)) return false;
+    a.args[0] = b.args[0];
+    Remove(n);
+    return true;
+}
+
+//li 到临时寄存器再参与运算时改用立即数形式的指令
+bool PeepholePass::FoldImmediate(size_t i){
+    struct ImmForm {
+        const char *op;
+        const char *imm_op;
+        bool commutative;
+    };
+    static const ImmForm forms[] = {
+        {"add", "addi", true}, {"and", "andi", true}, {"or", "ori", true}, {"xor", "xori", true},
+        {"slt", "slti", false}, {"sltu", "sltiu", false},
+        {"sll", "slli", false}, {"srl", "srli", false}, {"sra", "srai", false},
+    };
+
+    AsmInst &a = (*insts)[i];
+    long long imm;
+    if(a.op != "li" || !IsScratch(a.args[0]) || !ParseInt(a.args[1], imm)) return false;
+    const string tmp = a.args[0];
+    size_t n = Next(i);
+    if(n >= insts->size()) return false;
+    AsmInst &b = (*insts)[n];
+
+    if(b.op == "mv" && b.args[1] == tmp){
+        if(b.args[0] != tmp && !DeadAfter(n, tmp)) return false;
+        b = AsmInst{"li", {b.args[0], a.args[1]}, ""};
+        Remove(i);
+        return true;
+    }
+    if(b.IsLabel() || b.args.size() != 3) return false;
+    const string &rd = b.args[0], &rs1 = b.args[1], &rs2 = b.args[2];
+    if((rs1 == tmp) == (rs2 == tmp)) return false;
+
+    string imm_op, src;
+    long long value = imm;
+    for(const auto &f : forms){
+        if(b.op != f.op) continue;
+        if(rs2 == tmp){
+            imm_op = f.imm_op;
+            src = rs1;
+        }else if(f.commutative){
+            imm_op = f.imm_op;
+            src = rs2;
+        }
+        break;
+    }
+    if(b.op == "sub" && rs2 == tmp){
+        imm_op = "addi";
+        src = rs1;
+        value = -imm;
+    }else if(b.op == "sgt" && rs1 == tmp){
+        //imm > rs2 即 rs2 < imm
+        imm_op = "slti";
+        src = rs2;
+    }
+    if(imm_op.empty() || !FitsImm12(value)) return false;
+    if((imm_op == "slli" || imm_op == "srli" || imm_op == "srai") && (value < 0 || value > 31)) return false;
+    if(rd != tmp && !DeadAfter(n, tmp)) return false;
+
+    b = AsmInst{imm_op, {rd, src, to_string(value)}, ""};
+    Remove(i);
+    return true;
+}
+
+//跳到一个只有 j 的块时直接跳到最终目标
+bool PeepholePass::ThreadJump(size_t i){
+    AsmInst &a = (*insts)[i];
+    if(a.args.empty() || (a.op != "j" && !IsBranch(a.op))) return false;
+    string &target = a.args.back();
+    string final_target = ResolveJump(target);
+    if(final_target == target) return false;
+    target = final_target;
+    return true;
+}
+
+//j 到紧接着的标签直接删掉；bnez r, L1; j L2; L1: 改写成 beqz r, L2
+bool PeepholePass::RemoveFallthrough(size_t i){
+    AsmInst &a = (*insts)[i];
+    auto falls_into = [&](size_t from, const string &label){
+        for(size_t k = Next(from); k < insts->size() && (*insts)[k].IsLabel(); k = Next(k)){
+            if((*insts)[k].label == label) return true;
+        }
+        return false;
+    };
+    if(a.op == "j"){
+        if(!falls_into(i, a.args[0])) return false;
+        Remove(i);
+        return true;
+    }
+    if(a.op != "bnez" && a.op != "beqz") return false;
+    size_t n = Next(i);
+    if(n >= insts->size() || (*insts)[n].op != "j" || !falls_into(n, a.args[1])) return false;
+    a.op = a.op == "bnez" ? "beqz" : "bnez";
+    a.args[1] = (*insts)[n].args[0];
+    Remove(n);
+    return true;
+}
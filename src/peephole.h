@@ -0,0 +1,38 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <unordered_map>
+using namespace std;
+
+//一条汇编指令或者一个标签，后端先把函数体放进指令表，窥孔优化后再输出文本
+struct AsmInst {
+    string op;            //助记符，标签行为空
+    vector<string> args;  //操作数，访存的 "8(sp)" 作为一个操作数
+    string label;         //非空表示这一行是标签
+
+    bool IsLabel() const { return !label.empty(); }
+};
+
+//函数内的窥孔优化：store-load 转发、立即数形式、消除多余的 mv、跳转穿透、消除跳到下一行的跳转
+//规则在 peephole.cpp 的 rules 表里，反复扫描直到没有规则再生效
+class PeepholePass {
+public:
+    void Run(vector<AsmInst> &insts);
+
+private:
+    vector<AsmInst> *insts = nullptr;
+    vector<bool> removed;
+    unordered_map<string, size_t> label_pos;
+
+    size_t Next(size_t i) const;
+    void Remove(size_t i);
+    bool DeadAfter(size_t i, const string &reg) const;
+    string ResolveJump(const string &label) const;
+
+    bool ForwardStoreLoad(size_t i);
+    bool SimplifyZero(size_t i);
+    bool FoldImmediate(size_t i);
+    bool ForwardMove(size_t i);
+    bool ThreadJump(size_t i);
+    bool RemoveFallthrough(size_t i);
+};
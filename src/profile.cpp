@@ -0,0 +1,53 @@
+#include "profile.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+using namespace std;
+
+bool BlockProfile::Load(const string &path){
+    ifstream in(path);
+    if(!in) return false;
+    string line;
+    while(getline(in, line)){
+        istringstream is(line);
+        string func, block;
+        uint64_t count;
+        if(!(is >> func >> block >> count)) continue;
+        by_name[func][block] += count;
+    }
+    return true;
+}
+
+void BlockProfile::Attach(const koopa_raw_program_t &program){
+    for(size_t i = 0; i < program.funcs.len; i++){
+        koopa_raw_function_t func = (koopa_raw_function_t) program.funcs.buffer[i];
+        auto it = by_name.find(func->name);
+        if(it == by_name.end()) continue;
+        for(size_t j = 0; j < func->bbs.len; j++){
+            koopa_raw_basic_block_t bb = (koopa_raw_basic_block_t) func->bbs.buffer[j];
+            if(!bb->name) continue;
+            auto count = it->second.find(bb->name);
+            if(count != it->second.end()) Set(bb, count->second);
+        }
+    }
+}
+
+bool BlockProfile::Lookup(koopa_raw_basic_block_t bb, double &count) const {
+    auto it = counts.find(bb);
+    if(it == counts.end()) return false;
+    count = it->second;
+    return true;
+}
+
+void BlockProfile::Set(koopa_raw_basic_block_t bb, double count){
+    counts[bb] = count;
+    max_count = max(max_count, count);
+}
+
+vector<double> BlockProfile::FunctionCounts(koopa_raw_function_t func) const {
+    vector<double> res(func->bbs.len);
+    for(size_t i = 0; i < func->bbs.len; i++){
+        if(!Lookup((koopa_raw_basic_block_t) func->bbs.buffer[i], res[i])) return {};
+    }
+    return res;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include "koopa.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+//基本块执行次数的 profile：-interp -fprofile-generate 写出，-fprofile-use 读回
+//文件每行 "函数名 基本块名 次数"，名字取自未优化的 IR，同一份源码每次编译都相同
+//读回后先按名字挂到基本块上；之后新建基本块的 pass（内联、前置块）负责给新块估一个次数
+class BlockProfile {
+public:
+    //失败时返回 false
+    bool Load(const string &path);
+    //在任何优化之前调用，把次数按名字对应到 program 的基本块上
+    void Attach(const koopa_raw_program_t &program);
+
+    //bb 没有 profile 数据时返回 false
+    bool Lookup(koopa_raw_basic_block_t bb, double &count) const;
+    void Set(koopa_raw_basic_block_t bb, double count);
+    //整个程序里最热的基本块的次数，用来判断冷热
+    double MaxCount() const { return max_count; }
+    //函数的每个基本块都有数据时返回各块次数（按 bbs 的顺序），否则返回空
+    vector<double> FunctionCounts(koopa_raw_function_t func) const;
+
+private:
+    unordered_map<string, unordered_map<string, uint64_t>> by_name;
+    unordered_map<koopa_raw_basic_block_t, double> counts;
+    double max_count = 0;
+};
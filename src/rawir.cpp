@@ -0,0 +1,251 @@
+#include "rawir.h"
+#include <cassert>
+using namespace std;
+
+koopa_raw_value_data_t *RawIRArena::NewValue(koopa_raw_type_t ty, const char *name, koopa_raw_value_tag_t tag){
+    values.emplace_back();
+    koopa_raw_value_data_t *val = &values.back();
+    val->ty = ty;
+    val->name = name;
+    val->used_by = EmptySlice(KOOPA_RSIK_VALUE);
+    val->kind.tag = tag;
+    return val;
+}
+
+koopa_raw_basic_block_data_t *RawIRArena::NewBlock(const char *name){
+    blocks.emplace_back();
+    koopa_raw_basic_block_data_t *bb = &blocks.back();
+    bb->name = name;
+    bb->params = EmptySlice(KOOPA_RSIK_VALUE);
+    bb->used_by = EmptySlice(KOOPA_RSIK_VALUE);
+    bb->insts = EmptySlice(KOOPA_RSIK_VALUE);
+    return bb;
+}
+
+koopa_raw_function_data_t *RawIRArena::NewFunction(koopa_raw_type_t ty, const char *name){
+    funcs.emplace_back();
+    koopa_raw_function_data_t *func = &funcs.back();
+    func->ty = ty;
+    func->name = name;
+    func->params = EmptySlice(KOOPA_RSIK_VALUE);
+    func->bbs = EmptySlice(KOOPA_RSIK_BASIC_BLOCK);
+    return func;
+}
+
+const char *RawIRArena::NewName(const string &name){
+    names.push_back(name);
+    return names.back().c_str();
+}
+
+koopa_raw_type_t RawIRArena::Int32Type(){
+    if(!int32_ty){
+        types.emplace_back();
+        types.back().tag = KOOPA_RTT_INT32;
+        int32_ty = &types.back();
+    }
+    return int32_ty;
+}
+
+koopa_raw_type_t RawIRArena::UnitType(){
+    if(!unit_ty){
+        types.emplace_back();
+        types.back().tag = KOOPA_RTT_UNIT;
+        unit_ty = &types.back();
+    }
+    return unit_ty;
+}
+
+koopa_raw_type_t RawIRArena::PointerType(koopa_raw_type_t base){
+    auto it = ptr_cache.find(base);
+    if(it != ptr_cache.end()) return it->second;
+    types.emplace_back();
+    types.back().tag = KOOPA_RTT_POINTER;
+    types.back().data.pointer.base = base;
+    ptr_cache[base] = &types.back();
+    return &types.back();
+}
+
+koopa_raw_type_t RawIRArena::ArrayType(koopa_raw_type_t base, size_t len){
+    types.emplace_back();
+    types.back().tag = KOOPA_RTT_ARRAY;
+    types.back().data.array.base = base;
+    types.back().data.array.len = len;
+    return &types.back();
+}
+
+koopa_raw_type_t RawIRArena::FunctionType(const vector<koopa_raw_type_t> &params, koopa_raw_type_t ret){
+    types.emplace_back();
+    types.back().tag = KOOPA_RTT_FUNCTION;
+    types.back().data.function.params = NewSlice(params, KOOPA_RSIK_TYPE);
+    types.back().data.function.ret = ret;
+    return &types.back();
+}
+
+koopa_raw_value_t RawIRArena::Integer(int value){
+    auto it = int_cache.find(value);
+    if(it != int_cache.end()) return it->second;
+    koopa_raw_value_data_t *val = NewValue(Int32Type(), nullptr, KOOPA_RVT_INTEGER);
+    val->kind.data.integer.value = value;
+    int_cache[value] = val;
+    return val;
+}
+
+
+koopa_raw_value_data_t *RawIRBuilder::NewInst(koopa_raw_type_t ty, koopa_raw_value_tag_t tag){
+    koopa_raw_value_data_t *inst = arena.NewValue(ty, nullptr, tag);
+    cur_blocks.back().second.push_back(inst);
+    return inst;
+}
+
+koopa_raw_function_t RawIRBuilder::AddFuncDecl(const string &name, const vector<koopa_raw_type_t> &param_types, koopa_raw_type_t ret){
+    koopa_raw_function_data_t *func = arena.NewFunction(arena.FunctionType(param_types, ret), arena.NewName("@" + name));
+    funcs.push_back(func);
+    return func;
+}
+
+void RawIRBuilder::AddFuncDecls(const vector<koopa_raw_function_t> &decls){
+    funcs.insert(funcs.end(), decls.begin(), decls.end());
+}
+
+koopa_raw_function_t RawIRBuilder::BeginFunction(const string &name, const vector<string> &param_names, bool has_ret){
+    vector<koopa_raw_type_t> param_types(param_names.size(), arena.Int32Type());
+    koopa_raw_type_t ret = has_ret ? arena.Int32Type() : arena.UnitType();
+    cur_func = arena.NewFunction(arena.FunctionType(param_types, ret), arena.NewName("@" + name));
+    funcs.push_back(cur_func);
+
+    cur_allocs.clear();
+    cur_blocks.clear();
+
+    vector<koopa_raw_value_t> params;
+    for(size_t i = 0; i < param_names.size(); i++){
+        koopa_raw_value_data_t *param = arena.NewValue(arena.Int32Type(), arena.NewName("@" + param_names[i]), KOOPA_RVT_FUNC_ARG_REF);
+        param->kind.data.func_arg_ref.index = i;
+        params.push_back(param);
+    }
+    cur_func->params = arena.NewSlice(params, KOOPA_RSIK_VALUE);
+    StartBlock(NewBlock("%entry"));
+    return cur_func;
+}
+
+void RawIRBuilder::EndFunction(){
+    //alloc 统一放在入口块的最前面
+    vector<koopa_raw_basic_block_t> bbs;
+    for(size_t i = 0; i < cur_blocks.size(); i++){
+        auto &block = cur_blocks[i];
+        vector<koopa_raw_value_t> insts;
+        if(i == 0){
+            insts = cur_allocs;
+        }
+        insts.insert(insts.end(), block.second.begin(), block.second.end());
+        block.first->insts = arena.NewSlice(insts, KOOPA_RSIK_VALUE);
+        bbs.push_back(block.first);
+    }
+    cur_func->bbs = arena.NewSlice(bbs, KOOPA_RSIK_BASIC_BLOCK);
+    cur_func = nullptr;
+}
+
+koopa_raw_value_t RawIRBuilder::AddGlobalAlloc(const string &name, int len, const vector<int> &init){
+    koopa_raw_type_t ty = len < 0 ? arena.Int32Type() : arena.ArrayType(arena.Int32Type(), len);
+    koopa_raw_value_t init_val;
+    if(init.empty()){
+        init_val = arena.NewValue(ty, nullptr, KOOPA_RVT_ZERO_INIT);
+    }else if(len < 0){
+        init_val = arena.Integer(init[0]);
+    }else{
+        vector<koopa_raw_value_t> elems;
+        for(int v : init){
+            elems.push_back(arena.Integer(v));
+        }
+        koopa_raw_value_data_t *aggr = arena.NewValue(ty, nullptr, KOOPA_RVT_AGGREGATE);
+        aggr->kind.data.aggregate.elems = arena.NewSlice(elems, KOOPA_RSIK_VALUE);
+        init_val = aggr;
+    }
+    koopa_raw_value_data_t *global = arena.NewValue(arena.PointerType(ty), arena.NewName(name), KOOPA_RVT_GLOBAL_ALLOC);
+    global->kind.data.global_alloc.init = init_val;
+    global_values.push_back(global);
+    return global;
+}
+
+koopa_raw_value_t RawIRBuilder::AddLocalAlloc(const string &name, int len){
+    koopa_raw_type_t ty = len < 0 ? arena.Int32Type() : arena.ArrayType(arena.Int32Type(), len);
+    koopa_raw_value_data_t *alloc = arena.NewValue(arena.PointerType(ty), arena.NewName(name), KOOPA_RVT_ALLOC);
+    cur_allocs.push_back(alloc);
+    return alloc;
+}
+
+void RawIRBuilder::AddStore(koopa_raw_value_t val, koopa_raw_value_t ptr){
+    assert(val && ptr && "操作数为空");
+    koopa_raw_value_data_t *inst = NewInst(arena.UnitType(), KOOPA_RVT_STORE);
+    inst->kind.data.store.value = val;
+    inst->kind.data.store.dest = ptr;
+}
+
+koopa_raw_value_t RawIRBuilder::AddLoad(koopa_raw_value_t ptr){
+    assert(ptr && "操作数为空");
+    koopa_raw_value_data_t *inst = NewInst(ptr->ty->data.pointer.base, KOOPA_RVT_LOAD);
+    inst->kind.data.load.src = ptr;
+    return inst;
+}
+
+koopa_raw_value_t RawIRBuilder::AddGetElemPtr(koopa_raw_value_t ptr, koopa_raw_value_t idx){
+    assert(ptr && idx && "操作数为空");
+    koopa_raw_type_t elem_ty = ptr->ty->data.pointer.base->data.array.base;
+    koopa_raw_value_data_t *inst = NewInst(arena.PointerType(elem_ty), KOOPA_RVT_GET_ELEM_PTR);
+    inst->kind.data.get_elem_ptr.src = ptr;
+    inst->kind.data.get_elem_ptr.index = idx;
+    return inst;
+}
+
+koopa_raw_value_t RawIRBuilder::AddBinary(koopa_raw_binary_op_t op, koopa_raw_value_t lhs, koopa_raw_value_t rhs){
+    assert(lhs && rhs && "操作数为空");
+    koopa_raw_value_data_t *inst = NewInst(arena.Int32Type(), KOOPA_RVT_BINARY);
+    inst->kind.data.binary.op = op;
+    inst->kind.data.binary.lhs = lhs;
+    inst->kind.data.binary.rhs = rhs;
+    return inst;
+}
+
+koopa_raw_value_t RawIRBuilder::AddCall(koopa_raw_function_t func, const vector<koopa_raw_value_t> &args){
+    assert(func && "调用了未声明的函数");
+    koopa_raw_value_data_t *inst = NewInst(func->ty->data.function.ret, KOOPA_RVT_CALL);
+    inst->kind.data.call.callee = func;
+    inst->kind.data.call.args = arena.NewSlice(args, KOOPA_RSIK_VALUE);
+    return inst;
+}
+
+void RawIRBuilder::AddJump(koopa_raw_basic_block_t target){
+    koopa_raw_value_data_t *inst = NewInst(arena.UnitType(), KOOPA_RVT_JUMP);
+    inst->kind.data.jump.target = target;
+    inst->kind.data.jump.args = arena.EmptySlice(KOOPA_RSIK_VALUE);
+}
+
+void RawIRBuilder::AddBranch(koopa_raw_value_t cond, koopa_raw_basic_block_t true_bb, koopa_raw_basic_block_t false_bb){
+    assert(cond && "操作数为空");
+    koopa_raw_value_data_t *inst = NewInst(arena.UnitType(), KOOPA_RVT_BRANCH);
+    inst->kind.data.branch.cond = cond;
+    inst->kind.data.branch.true_bb = true_bb;
+    inst->kind.data.branch.false_bb = false_bb;
+    inst->kind.data.branch.true_args = arena.EmptySlice(KOOPA_RSIK_VALUE);
+    inst->kind.data.branch.false_args = arena.EmptySlice(KOOPA_RSIK_VALUE);
+}
+
+void RawIRBuilder::AddRet(koopa_raw_value_t val){
+    koopa_raw_value_data_t *inst = NewInst(arena.UnitType(), KOOPA_RVT_RETURN);
+    inst->kind.data.ret.value = val;
+}
+
+koopa_raw_basic_block_t RawIRBuilder::NewBlock(const string &name){
+    return arena.NewBlock(arena.NewName(name));
+}
+
+void RawIRBuilder::StartBlock(koopa_raw_basic_block_t bb){
+    //块里的指令在 EndFunction 时才一次性写进 insts，这里需要可写的指针
+    cur_blocks.push_back({const_cast<koopa_raw_basic_block_data_t *>(bb), {}});
+}
+
+koopa_raw_program_t RawIRBuilder::GetProgram(){
+    koopa_raw_program_t program;
+    program.values = arena.NewSlice(global_values, KOOPA_RSIK_VALUE);
+    program.funcs = arena.NewSlice(funcs, KOOPA_RSIK_FUNCTION);
+    return program;
+}
@@ -0,0 +1,106 @@
+#pragma once
+#include "koopa.h"
+#include <deque>
+#include <string>
+#include <vector>
+#include <unordered_map>
+using namespace std;
+
+//由我们自己创建的 Koopa raw IR 对象（值、基本块、类型、slice、名字）都放在这里
+//生命周期与一次编译相同，编译结束时整体释放
+class RawIRArena {
+public:
+    koopa_raw_value_data_t *NewValue(koopa_raw_type_t ty, const char *name, koopa_raw_value_tag_t tag);
+    koopa_raw_basic_block_data_t *NewBlock(const char *name);
+    koopa_raw_function_data_t *NewFunction(koopa_raw_type_t ty, const char *name);
+    const char *NewName(const string &name);
+
+    template <typename T>
+    koopa_raw_slice_t NewSlice(const vector<T> &items, koopa_raw_slice_item_kind_t kind){
+        koopa_raw_slice_t slice;
+        slice.kind = kind;
+        slice.len = items.size();
+        if(items.empty()){
+            slice.buffer = nullptr;
+        }else{
+            slices.emplace_back(items.begin(), items.end());
+            slice.buffer = slices.back().data();
+        }
+        return slice;
+    }
+    koopa_raw_slice_t EmptySlice(koopa_raw_slice_item_kind_t kind){
+        return NewSlice(vector<const void *>(), kind);
+    }
+
+    koopa_raw_type_t Int32Type();
+    koopa_raw_type_t UnitType();
+    koopa_raw_type_t PointerType(koopa_raw_type_t base);
+    koopa_raw_type_t ArrayType(koopa_raw_type_t base, size_t len);
+    koopa_raw_type_t FunctionType(const vector<koopa_raw_type_t> &params, koopa_raw_type_t ret);
+
+    //整数常量，相同的值共享一个对象
+    koopa_raw_value_t Integer(int value);
+
+    //已经分配的值和基本块个数（包括之后被 pass 删掉的），-time-report 用
+    size_t ValueCount() const { return values.size(); }
+    size_t BlockCount() const { return blocks.size(); }
+
+private:
+    deque<koopa_raw_value_data_t> values;
+    deque<koopa_raw_basic_block_data_t> blocks;
+    deque<koopa_raw_function_data_t> funcs;
+    deque<koopa_raw_type_kind_t> types;
+    deque<vector<const void *>> slices;
+    deque<string> names;
+    unordered_map<int, koopa_raw_value_t> int_cache;
+    koopa_raw_type_t int32_ty = nullptr;
+    koopa_raw_type_t unit_ty = nullptr;
+    unordered_map<koopa_raw_type_t, koopa_raw_type_t> ptr_cache;
+};
+
+//由 AST 直接构建内存中的 Koopa raw program，值、基本块和函数都直接用 raw 对象的指针引用
+//名字只用来给 alloc、参数和基本块命名（输出 Koopa 文本、按块名对应 profile），不参与查找
+class RawIRBuilder {
+public:
+    explicit RawIRBuilder(RawIRArena &arena) : arena(arena) {}
+
+    koopa_raw_value_t Integer(int value) { return arena.Integer(value); }
+
+    koopa_raw_function_t AddFuncDecl(const string &name, const vector<koopa_raw_type_t> &param_types, koopa_raw_type_t ret);
+    //登记已经建好的函数声明（库函数），不再重新创建
+    void AddFuncDecls(const vector<koopa_raw_function_t> &decls);
+    //参数通过返回的函数的 params 取得
+    koopa_raw_function_t BeginFunction(const string &name, const vector<string> &param_names, bool has_ret);
+    void EndFunction();
+
+    //len < 0 表示标量；init 为空表示 zeroinit
+    koopa_raw_value_t AddGlobalAlloc(const string &name, int len, const vector<int> &init);
+    koopa_raw_value_t AddLocalAlloc(const string &name, int len);
+
+    void AddStore(koopa_raw_value_t val, koopa_raw_value_t ptr);
+    koopa_raw_value_t AddLoad(koopa_raw_value_t ptr);
+    koopa_raw_value_t AddGetElemPtr(koopa_raw_value_t ptr, koopa_raw_value_t idx);
+    koopa_raw_value_t AddBinary(koopa_raw_binary_op_t op, koopa_raw_value_t lhs, koopa_raw_value_t rhs);
+    koopa_raw_value_t AddCall(koopa_raw_function_t func, const vector<koopa_raw_value_t> &args);
+
+    void AddJump(koopa_raw_basic_block_t target);
+    void AddBranch(koopa_raw_value_t cond, koopa_raw_basic_block_t true_bb, koopa_raw_basic_block_t false_bb);
+    //val 为空表示没有返回值
+    void AddRet(koopa_raw_value_t val);
+    //块可以先被跳转引用，之后再用 StartBlock 开始往里放指令
+    koopa_raw_basic_block_t NewBlock(const string &name);
+    void StartBlock(koopa_raw_basic_block_t bb);
+
+    koopa_raw_program_t GetProgram();
+
+private:
+    RawIRArena &arena;
+    vector<koopa_raw_value_t> global_values;
+    vector<koopa_raw_function_t> funcs;
+
+    koopa_raw_function_data_t *cur_func = nullptr;
+    vector<koopa_raw_value_t> cur_allocs;
+    vector<pair<koopa_raw_basic_block_data_t *, vector<koopa_raw_value_t>>> cur_blocks;
+
+    koopa_raw_value_data_t *NewInst(koopa_raw_type_t ty, koopa_raw_value_tag_t tag);
+};
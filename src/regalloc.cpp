@@ -0,0 +1,300 @@
+#include "regalloc.h"
+#include "irutil.h"
+#include <algorithm>
+#include <cassert>
+#include <climits>
+using namespace std;
+
+//可分配的寄存器，按优先顺序排列
+static const int kTempRegs[] = {28, 29, 30, 31};                          // t3-t6
+static const int kArgRegs[] = {10, 11, 12, 13, 14, 15, 16, 17};            // a0-a7
+static const int kSavedRegs[] = {9, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27}; // s1-s11
+
+//简单的定长位集合，用于活跃变量分析
+struct BitSet {
+    vector<uint64_t> words;
+    explicit BitSet(size_t n = 0) : words((n + 63) / 64, 0) {}
+    void Set(size_t i) { words[i / 64] |= (uint64_t)1 << (i % 64); }
+    void Reset(size_t i) { words[i / 64] &= ~((uint64_t)1 << (i % 64)); }
+    bool Test(size_t i) const { return (words[i / 64] >> (i % 64)) & 1; }
+};
+
+string RegAllocator::RegName(int reg){
+    static const char *names[] = {
+        "x0", "ra", "sp", "gp", "tp", "t0", "t1", "t2",
+        "s0", "s1", "a0", "a1", "a2", "a3", "a4", "a5",
+        "a6", "a7", "s2", "s3", "s4", "s5", "s6", "s7",
+        "s8", "s9", "s10", "s11", "t3", "t4", "t5", "t6"
+    };
+    assert(reg >= 0 && reg < 32);
+    return names[reg];
+}
+
+const ValueLoc &RegAllocator::GetLoc(koopa_raw_value_t val) const {
+    auto it = loc_map.find(val);
+    assert(it != loc_map.end() && "访问了未分配的值");
+    return it->second;
+}
+
+bool RegAllocator::HasLoc(koopa_raw_value_t val) const {
+    return loc_map.count(val) > 0;
+}
+
+vector<int> RegAllocator::GetCandidateRegs(const Interval &it, const vector<int> &call_pos) const {
+    //区间内部跨过了 call：只能放在 callee-saved 寄存器里
+    //区间在某个 call 处结束（作为实参）：不能放在 a 寄存器里，避免准备实参时被覆盖
+    bool cross_call = false;
+    bool used_by_call = false;
+    auto lb = upper_bound(call_pos.begin(), call_pos.end(), it.start);
+    for(auto c = lb; c != call_pos.end() && *c <= it.end; ++c){
+        if(*c < it.end){
+            cross_call = true;
+            break;
+        }
+        used_by_call = true;
+    }
+
+    vector<int> regs;
+    if(!cross_call){
+        //不跨 call 的参数优先留在传进来的 a 寄存器里，序言里就不用搬了
+        //只允许用自己的 a 寄存器，其余参数不会被搬进来；参数之间不冲突靠的是区间都覆盖整个序言
+        if(!used_by_call && it.arg_reg >= 0){
+            regs.push_back(it.arg_reg);
+        }
+        regs.insert(regs.end(), begin(kTempRegs), end(kTempRegs));
+        //其余参数在序言中从 a 寄存器搬出，不能再放进别的 a 寄存器
+        if(!used_by_call && !it.is_param){
+            regs.insert(regs.end(), begin(kArgRegs), end(kArgRegs));
+        }
+    }
+    regs.insert(regs.end(), begin(kSavedRegs), end(kSavedRegs));
+    return regs;
+}
+
+void RegAllocator::Allocate(const koopa_raw_function_t &func, const vector<double> *block_freq){
+    loc_map.clear();
+    spilled.clear();
+    used_callee_saved.clear();
+
+    //1. 给需要寄存器的值编号，并给每条指令一个线性位置（0 号位置是序言）
+    unordered_map<koopa_raw_value_t, int> index;
+    vector<koopa_raw_value_t> values;
+    auto add_value = [&](koopa_raw_value_t v){
+        if(index.count(v) == 0){
+            index[v] = values.size();
+            values.push_back(v);
+        }
+    };
+    for(size_t i = 0; i < func->params.len; i++){
+        add_value((koopa_raw_value_t) func->params.buffer[i]);
+    }
+
+    size_t bb_count = func->bbs.len;
+    unordered_map<koopa_raw_basic_block_t, int> bb_index;
+    vector<int> bb_start(bb_count), bb_end(bb_count);
+    vector<int> call_pos;
+    int pos = 1;
+    for(size_t i = 0; i < bb_count; i++){
+        koopa_raw_basic_block_t bb = (koopa_raw_basic_block_t) func->bbs.buffer[i];
+        bb_index[bb] = i;
+        bb_start[i] = pos;
+        for(size_t j = 0; j < bb->params.len; j++){
+            add_value((koopa_raw_value_t) bb->params.buffer[j]);
+        }
+        for(size_t j = 0; j < bb->insts.len; j++){
+            koopa_raw_value_t inst = (koopa_raw_value_t) bb->insts.buffer[j];
+            if(IsRegValue(inst)){
+                add_value(inst);
+            }
+            if(inst->kind.tag == KOOPA_RVT_CALL){
+                call_pos.push_back(pos);
+            }
+            pos++;
+        }
+        bb_end[i] = pos - 1;
+    }
+
+    //2. 每个基本块的 use/def 集合
+    size_t n = values.size();
+    vector<BitSet> use(bb_count, BitSet(n)), def(bb_count, BitSet(n));
+    for(size_t i = 0; i < bb_count; i++){
+        koopa_raw_basic_block_t bb = (koopa_raw_basic_block_t) func->bbs.buffer[i];
+        for(size_t j = 0; j < bb->params.len; j++){
+            def[i].Set(index[(koopa_raw_value_t) bb->params.buffer[j]]);
+        }
+        for(size_t j = 0; j < bb->insts.len; j++){
+            koopa_raw_value_t inst = (koopa_raw_value_t) bb->insts.buffer[j];
+            ForEachOperand(inst, [&](koopa_raw_value_t op){
+                auto it = index.find(op);
+                if(it != index.end() && !def[i].Test(it->second)){
+                    use[i].Set(it->second);
+                }
+            });
+            auto it = index.find(inst);
+            if(it != index.end()){
+                def[i].Set(it->second);
+            }
+        }
+    }
+
+    //3. 迭代求解活跃变量 live_in / live_out
+    vector<vector<int>> succs(bb_count);
+    for(size_t i = 0; i < bb_count; i++){
+        for(auto s : GetSuccessors((koopa_raw_basic_block_t) func->bbs.buffer[i])){
+            succs[i].push_back(bb_index[s]);
+        }
+    }
+    vector<BitSet> live_in(bb_count, BitSet(n)), live_out(bb_count, BitSet(n));
+    bool changed = true;
+    while(changed){
+        changed = false;
+        for(int i = (int)bb_count - 1; i >= 0; i--){
+            BitSet out(n);
+            for(int s : succs[i]){
+                for(size_t w = 0; w < out.words.size(); w++){
+                    out.words[w] |= live_in[s].words[w];
+                }
+            }
+            BitSet in(n);
+            for(size_t w = 0; w < in.words.size(); w++){
+                in.words[w] = use[i].words[w] | (out.words[w] & ~def[i].words[w]);
+            }
+            if(in.words != live_in[i].words || out.words != live_out[i].words){
+                live_in[i] = move(in);
+                live_out[i] = move(out);
+                changed = true;
+            }
+        }
+    }
+
+    //4. 根据定义、使用和跨块活跃信息构造每个值的活跃区间
+    vector<Interval> intervals(n);
+    for(size_t v = 0; v < n; v++){
+        intervals[v] = {values[v], INT_MAX, INT_MIN, values[v]->kind.tag == KOOPA_RVT_FUNC_ARG_REF};
+    }
+    auto extend = [&](int v, int p){
+        intervals[v].start = min(intervals[v].start, p);
+        intervals[v].end = max(intervals[v].end, p);
+    };
+    //序言依次搬运所有参数，搬完之前每个参数都还占着自己的位置：区间至少延伸到第一条指令
+    //否则没用到的参数区间是 [0, 0]，立刻释放，它的寄存器会分给别的参数，序言里后搬的会覆盖先搬的
+    for(size_t i = 0; i < func->params.len; i++){
+        int v = index[(koopa_raw_value_t) func->params.buffer[i]];
+        extend(v, 0);
+        extend(v, 1);
+        if(i < 8) intervals[v].arg_reg = kArgRegs[i];
+    }
+    pos = 1;
+    for(size_t i = 0; i < bb_count; i++){
+        koopa_raw_basic_block_t bb = (koopa_raw_basic_block_t) func->bbs.buffer[i];
+        for(size_t j = 0; j < bb->params.len; j++){
+            extend(index[(koopa_raw_value_t) bb->params.buffer[j]], bb_start[i]);
+        }
+        for(size_t j = 0; j < bb->insts.len; j++){
+            koopa_raw_value_t inst = (koopa_raw_value_t) bb->insts.buffer[j];
+            double freq = block_freq ? (*block_freq)[i] : 0;
+            ForEachOperand(inst, [&](koopa_raw_value_t op){
+                auto it = index.find(op);
+                if(it == index.end()) return;
+                extend(it->second, pos);
+                intervals[it->second].weight += freq;
+            });
+            auto it = index.find(inst);
+            if(it != index.end()){
+                extend(it->second, pos);
+                intervals[it->second].weight += freq;
+            }
+
+            //跳转时会写目标块的参数寄存器，参数的区间要覆盖这个位置
+            auto cover_params = [&](koopa_raw_basic_block_t target){
+                for(size_t k = 0; k < target->params.len; k++){
+                    extend(index[(koopa_raw_value_t) target->params.buffer[k]], pos);
+                }
+            };
+            if(inst->kind.tag == KOOPA_RVT_JUMP){
+                cover_params(inst->kind.data.jump.target);
+            }else if(inst->kind.tag == KOOPA_RVT_BRANCH){
+                cover_params(inst->kind.data.branch.true_bb);
+                cover_params(inst->kind.data.branch.false_bb);
+            }
+            pos++;
+        }
+        for(size_t v = 0; v < n; v++){
+            if(live_in[i].Test(v)) extend(v, bb_start[i]);
+            if(live_out[i].Test(v)) extend(v, bb_end[i]);
+        }
+    }
+
+    //5. 线性扫描
+    vector<Interval *> order;
+    for(auto &it : intervals){
+        order.push_back(&it);
+    }
+    sort(order.begin(), order.end(), [](const Interval *a, const Interval *b){
+        return a->start != b->start ? a->start < b->start : a->end < b->end;
+    });
+
+    bool reg_free[32];
+    fill(begin(reg_free), end(reg_free), true);
+    vector<Interval *> active;
+
+    for(Interval *cur : order){
+        //释放已经结束的区间
+        for(auto it = active.begin(); it != active.end();){
+            if((*it)->end <= cur->start){
+                reg_free[(*it)->reg] = true;
+                it = active.erase(it);
+            }else{
+                ++it;
+            }
+        }
+
+        vector<int> candidates = GetCandidateRegs(*cur, call_pos);
+        for(int r : candidates){
+            if(reg_free[r]){
+                cur->reg = r;
+                break;
+            }
+        }
+
+        if(cur->reg < 0){
+            //没有空闲寄存器：有 profile 时溢出实际访问次数最少的区间，否则溢出结束得最晚的那个
+            Interval *victim = nullptr;
+            for(Interval *a : active){
+                if(find(candidates.begin(), candidates.end(), a->reg) == candidates.end()) continue;
+                if(block_freq){
+                    if(!victim || a->weight < victim->weight) victim = a;
+                }else if(!victim || a->end > victim->end){
+                    victim = a;
+                }
+            }
+            bool better = victim && (block_freq ? victim->weight < cur->weight : victim->end > cur->end);
+            if(better){
+                cur->reg = victim->reg;
+                victim->reg = -1;
+                active.erase(find(active.begin(), active.end(), victim));
+            }
+        }
+
+        if(cur->reg >= 0){
+            reg_free[cur->reg] = false;
+            active.push_back(cur);
+        }
+    }
+
+    for(auto &it : intervals){
+        loc_map[it.val].reg = it.reg;
+        if(it.reg < 0){
+            spilled.push_back(it.val);
+        }
+    }
+    bool saved_used[32] = {false};
+    for(auto &it : intervals){
+        if(it.reg >= 0 && find(begin(kSavedRegs), end(kSavedRegs), it.reg) != end(kSavedRegs)){
+            saved_used[it.reg] = true;
+        }
+    }
+    for(int r : kSavedRegs){
+        if(saved_used[r]) used_callee_saved.push_back(r);
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include "koopa.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+using namespace std;
+
+//值在后端的位置：要么在某个寄存器里，要么被溢出到栈上
+struct ValueLoc {
+    int reg = -1;        //RISC-V 寄存器编号 x0~x31，-1 表示被溢出
+    bool InReg() const { return reg >= 0; }
+};
+
+//基于活跃区间的线性扫描寄存器分配
+//t0~t2 保留给后端做临时寄存器，其余 t3~t6 / a0~a7 / s1~s11 参与分配
+class RegAllocator {
+public:
+    //block_freq 是各基本块（按 bbs 的顺序）的执行次数，有 profile 时用来挑溢出代价最小的区间
+    void Allocate(const koopa_raw_function_t &func, const vector<double> *block_freq = nullptr);
+
+    const ValueLoc &GetLoc(koopa_raw_value_t val) const;
+    bool HasLoc(koopa_raw_value_t val) const;
+    //被溢出的值，后端需要为它们分配栈槽
+    const vector<koopa_raw_value_t> &GetSpilled() const { return spilled; }
+    //用到的 callee-saved 寄存器，需要在序言中保存
+    const vector<int> &GetUsedCalleeSaved() const { return used_callee_saved; }
+
+    static string RegName(int reg);
+
+private:
+    struct Interval {
+        koopa_raw_value_t val;
+        int start;
+        int end;
+        bool is_param;
+        int reg = -1;
+        int arg_reg = -1;   //前 8 个参数传进来时所在的 a 寄存器
+        double weight = 0;  //定义和使用所在块的执行次数之和
+    };
+
+    unordered_map<koopa_raw_value_t, ValueLoc> loc_map;
+    vector<koopa_raw_value_t> spilled;
+    vector<int> used_callee_saved;
+
+    vector<int> GetCandidateRegs(const Interval &it, const vector<int> &call_pos) const;
+};
@@ -0,0 +1,70 @@
+#include "rope.h"
+#include "intfmt.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+using namespace std;
+
+void Rope::Append(const char *data, size_t len){
+    size += len;
+    if(!chunks.empty()){
+        Chunk &last = chunks.back();
+        size_t n = min(len, last.cap - last.len);
+        memcpy(last.data.get() + last.len, data, n);
+        last.len += n;
+        data += n;
+        len -= n;
+    }
+    if(len == 0) return;
+    //块的大小按几何级数增长，小函数不会浪费大块内存
+    size_t cap = chunks.empty() ? kMinChunk : min(chunks.back().cap * 2, kMaxChunk);
+    cap = max(cap, len);
+    Chunk chunk{unique_ptr<char[]>(new char[cap]), len, cap};
+    memcpy(chunk.data.get(), data, len);
+    chunks.push_back(move(chunk));
+}
+
+void Rope::AppendInt(long long value){
+    char tmp[kMaxIntChars];
+    Append(tmp, FormatInt(tmp, value));
+}
+
+void Rope::Splice(Rope &other){
+    for(auto &chunk : other.chunks){
+        chunks.push_back(move(chunk));
+    }
+    size += other.size;
+    other.chunks.clear();
+    other.size = 0;
+}
+
+void Rope::Clear(){
+    chunks.clear();
+    size = 0;
+}
+
+void Rope::WriteTo(ostream &os) const {
+    for(const auto &chunk : chunks){
+        os.write(chunk.data.get(), chunk.len);
+    }
+}
+
+bool Rope::WriteToFile(const string &path) const {
+    FILE *fp = fopen(path.c_str(), "wb");
+    if(!fp) return false;
+    bool ok = true;
+    for(const auto &chunk : chunks){
+        ok = ok && fwrite(chunk.data.get(), 1, chunk.len, fp) == chunk.len;
+    }
+    ok = fclose(fp) == 0 && ok;
+    return ok;
+}
+
+string Rope::Str() const {
+    string res;
+    res.reserve(size);
+    for(const auto &chunk : chunks){
+        res.append(chunk.data.get(), chunk.len);
+    }
+    return res;
+}
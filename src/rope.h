@@ -0,0 +1,65 @@
+#pragma once
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+using namespace std;
+
+//分块的文本缓冲：追加时直接写进最后一块，写满了就开新块，已经写入的内容不会再被搬动
+//两个 Rope 拼接只转移块的所有权，不复制字节
+class Rope {
+public:
+    Rope() = default;
+    Rope(Rope &&) = default;
+    Rope &operator=(Rope &&) = default;
+
+    Rope &operator<<(string_view str){
+        Append(str.data(), str.size());
+        return *this;
+    }
+    Rope &operator<<(const char *str){
+        return *this << string_view(str);
+    }
+    Rope &operator<<(const string &str){
+        Append(str.data(), str.size());
+        return *this;
+    }
+    Rope &operator<<(char c){
+        Append(&c, 1);
+        return *this;
+    }
+    template <typename T, typename = enable_if_t<is_integral_v<T> && !is_same_v<T, char> && !is_same_v<T, bool>>>
+    Rope &operator<<(T value){
+        AppendInt(static_cast<long long>(value));
+        return *this;
+    }
+
+    //把 other 的全部内容接到末尾，other 变为空
+    void Splice(Rope &other);
+
+    size_t Size() const { return size; }
+    bool Empty() const { return size == 0; }
+    void Clear();
+
+    void WriteTo(ostream &os) const;
+    //失败时返回 false
+    bool WriteToFile(const string &path) const;
+    string Str() const;
+
+private:
+    struct Chunk {
+        unique_ptr<char[]> data;
+        size_t len;
+        size_t cap;
+    };
+    static constexpr size_t kMinChunk = 256;
+    static constexpr size_t kMaxChunk = 64 * 1024;
+
+    vector<Chunk> chunks;
+    size_t size = 0;
+
+    void Append(const char *data, size_t len);
+    void AppendInt(long long value);
+};
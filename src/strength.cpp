@@ -0,0 +1,331 @@
+#include "strength.h"
+#include "cfg.h"
+#include "irutil.h"
+#include <map>
+#include <cstdio>
+#include <string>
+using namespace std;
+
+//v 是否为 2 的幂 2^k（1 <= k <= 30），是则返回 k，否则返回 -1
+static int Log2(int64_t v){
+    for(int k = 1; k <= 30; k++){
+        if(v == ((int64_t)1 << k)) return k;
+    }
+    return -1;
+}
+
+static bool IsConst(koopa_raw_value_t v){
+    return v->kind.tag == KOOPA_RVT_INTEGER;
+}
+
+void StrengthReducePass::Run(const koopa_raw_program_t &program){
+    for(size_t i = 0; i < program.funcs.len; i++){
+        koopa_raw_function_t func = (koopa_raw_function_t) program.funcs.buffer[i];
+        if(func->bbs.len == 0) continue;
+        RunOnFunction(func);
+    }
+}
+
+koopa_raw_value_t StrengthReducePass::NewBinary(koopa_raw_binary_op_t op, koopa_raw_value_t lhs, koopa_raw_value_t rhs){
+    koopa_raw_value_data_t *val = arena.NewValue(arena.Int32Type(), nullptr, KOOPA_RVT_BINARY);
+    val->kind.data.binary.op = op;
+    val->kind.data.binary.lhs = lhs;
+    val->kind.data.binary.rhs = rhs;
+    return val;
+}
+
+void StrengthReducePass::RunOnFunction(koopa_raw_function_t func){
+    CFG cfg(func);
+    vector<Loop> loops = cfg.FindLoops();
+    if(!loops.empty()){
+        int n = cfg.Size();
+        vector<vector<koopa_raw_value_t>> insts(n);
+        unordered_map<koopa_raw_value_t, int> def_block;
+        for(int b = 0; b < n; b++){
+            koopa_raw_basic_block_t bb = cfg.blocks[b];
+            for(size_t i = 0; i < bb->params.len; i++){
+                def_block[(koopa_raw_value_t) bb->params.buffer[i]] = b;
+            }
+            for(size_t i = 0; i < bb->insts.len; i++){
+                koopa_raw_value_t inst = (koopa_raw_value_t) bb->insts.buffer[i];
+                def_block[inst] = b;
+                insts[b].push_back(inst);
+            }
+        }
+        //内层循环先处理，它新建的前置块指令在外层循环里还可以继续削弱
+        for(auto loop = loops.rbegin(); loop != loops.rend(); ++loop){
+            auto replace = ReduceLoop(cfg, *loop, insts, def_block);
+            if(replace.empty()) continue;
+            for(int b = 0; b < n; b++){
+                AsMutable(cfg.blocks[b])->insts = arena.NewSlice(insts[b], KOOPA_RSIK_VALUE);
+            }
+            ReplaceUses(func, replace);
+        }
+    }
+    ReduceConstOps(func);
+}
+
+unordered_map<koopa_raw_value_t, koopa_raw_value_t> StrengthReducePass::ReduceLoop(
+        const CFG &cfg, const Loop &loop, vector<vector<koopa_raw_value_t>> &insts,
+        unordered_map<koopa_raw_value_t, int> &def_block){
+    unordered_map<koopa_raw_value_t, koopa_raw_value_t> replace;
+    int n = cfg.Size();
+    vector<bool> in_loop(n, false);
+    for(int b : loop.blocks) in_loop[b] = true;
+
+    //需要唯一的前置块（LICM 已经建好）并且所有入边都是 jump，才能给循环头加参数
+    int pre = -1;
+    for(int p : cfg.preds[loop.header]){
+        if(in_loop[p]) continue;
+        if(pre >= 0) return replace;
+        pre = p;
+    }
+    koopa_raw_basic_block_t header = cfg.blocks[loop.header];
+    auto jump_of = [&](int b) -> koopa_raw_value_data_t * {
+        koopa_raw_value_t term = insts[b].back();
+        if(term->kind.tag != KOOPA_RVT_JUMP || term->kind.data.jump.target != header) return nullptr;
+        return AsMutable(term);
+    };
+    if(pre < 0 || !jump_of(pre)) return replace;
+    for(int l : loop.latches){
+        if(!jump_of(l)) return replace;
+    }
+
+    auto invariant = [&](koopa_raw_value_t v){
+        if(v->kind.tag == KOOPA_RVT_ALLOC) return true;
+        auto it = def_block.find(v);
+        return it == def_block.end() || !in_loop[it->second];
+    };
+    auto emit_pre = [&](koopa_raw_value_t v){
+        insts[pre].insert(insts[pre].end() - 1, v);
+        def_block[v] = pre;
+        return v;
+    };
+    //两个值都是常量时直接算出结果，否则在前置块里生成指令
+    auto fold = [&](koopa_raw_binary_op_t op, koopa_raw_value_t lhs, koopa_raw_value_t rhs){
+        int32_t res;
+        auto is = [](koopa_raw_value_t v, int c){ return IsConst(v) && v->kind.data.integer.value == c; };
+        if(op == KOOPA_RBO_MUL && (is(lhs, 0) || is(rhs, 0))) return arena.Integer(0);
+        if((op == KOOPA_RBO_MUL && is(lhs, 1)) || (op == KOOPA_RBO_ADD && is(lhs, 0))) return rhs;
+        if((op == KOOPA_RBO_MUL && is(rhs, 1)) || (op == KOOPA_RBO_ADD && is(rhs, 0))) return lhs;
+        if(IsConst(lhs) && IsConst(rhs) &&
+           EvalBinary(op, lhs->kind.data.integer.value, rhs->kind.data.integer.value, res)){
+            return arena.Integer(res);
+        }
+        return emit_pre(NewBinary(op, lhs, rhs));
+    };
+
+    //基本归纳变量：循环头参数 phi，所有回边传回的都是同一个 phi + step，step 在循环中不变
+    struct IV {
+        koopa_raw_value_t phi, init, step;
+    };
+    vector<IV> ivs;
+    auto find_iv = [&](koopa_raw_value_t v) -> const IV * {
+        for(const IV &iv : ivs){
+            if(iv.phi == v) return &iv;
+        }
+        return nullptr;
+    };
+    for(size_t k = 0; k < header->params.len; k++){
+        koopa_raw_value_t phi = (koopa_raw_value_t) header->params.buffer[k];
+        koopa_raw_value_t next = (koopa_raw_value_t) jump_of(loop.latches[0])->kind.data.jump.args.buffer[k];
+        bool same = true;
+        for(int l : loop.latches){
+            if(jump_of(l)->kind.data.jump.args.buffer[k] != next) same = false;
+        }
+        if(!same || next->kind.tag != KOOPA_RVT_BINARY || next->kind.data.binary.op != KOOPA_RBO_ADD) continue;
+        const auto &add = next->kind.data.binary;
+        koopa_raw_value_t step = nullptr;
+        if(add.lhs == phi && invariant(add.rhs)) step = add.rhs;
+        if(add.rhs == phi && invariant(add.lhs)) step = add.lhs;
+        if(!step) continue;
+        ivs.push_back({phi, (koopa_raw_value_t) jump_of(pre)->kind.data.jump.args.buffer[k], step});
+    }
+    if(ivs.empty()) return replace;
+
+    //给循环头加一个参数：前置块传入初值，每条回边在跳转前算出下一次的值
+    auto add_param = [&](koopa_raw_type_t ty, koopa_raw_value_t init,
+                         const function<koopa_raw_value_t(koopa_raw_value_t)> &make_next){
+        string name = "%iv_" + to_string(iv_cnt++);
+        koopa_raw_value_data_t *param = arena.NewValue(ty, arena.NewName(name), KOOPA_RVT_BLOCK_ARG_REF);
+        param->kind.data.block_arg_ref.index = header->params.len;
+        def_block[param] = loop.header;
+        auto append = [&](koopa_raw_slice_t &slice, koopa_raw_value_t v){
+            vector<const void *> items(slice.buffer, slice.buffer + slice.len);
+            items.push_back(v);
+            slice = arena.NewSlice(items, KOOPA_RSIK_VALUE);
+        };
+        append(AsMutable(header)->params, param);
+        append(jump_of(pre)->kind.data.jump.args, init);
+        for(int l : loop.latches){
+            koopa_raw_value_t next = make_next(param);
+            insts[l].insert(insts[l].end() - 1, next);
+            def_block[next] = l;
+            append(jump_of(l)->kind.data.jump.args, next);
+        }
+        return param;
+    };
+
+    //先收集再改写：add_param 会往回边所在的块里插指令
+    vector<koopa_raw_value_t> candidates;
+    for(int b : loop.blocks){
+        for(auto inst : insts[b]){
+            auto tag = inst->kind.tag;
+            if(tag == KOOPA_RVT_BINARY || tag == KOOPA_RVT_GET_ELEM_PTR || tag == KOOPA_RVT_GET_PTR){
+                candidates.push_back(inst);
+            }
+        }
+    }
+
+    //i * k（k 不变）变成 m，m 从 init * k 开始每次加 step * k
+    map<pair<koopa_raw_value_t, koopa_raw_value_t>, koopa_raw_value_t> mul_iv;
+    for(auto inst : candidates){
+        if(inst->kind.tag != KOOPA_RVT_BINARY) continue;
+        const auto &bin = inst->kind.data.binary;
+        const IV *iv = nullptr;
+        koopa_raw_value_t factor = nullptr;
+        if(bin.op == KOOPA_RBO_MUL){
+            if(find_iv(bin.lhs) && invariant(bin.rhs)){
+                iv = find_iv(bin.lhs);
+                factor = bin.rhs;
+            }else if(find_iv(bin.rhs) && invariant(bin.lhs)){
+                iv = find_iv(bin.rhs);
+                factor = bin.lhs;
+            }
+        }else if(bin.op == KOOPA_RBO_SHL && IsConst(bin.rhs)){
+            int sh = bin.rhs->kind.data.integer.value;
+            if(find_iv(bin.lhs) && sh >= 0 && sh < 31){
+                iv = find_iv(bin.lhs);
+                factor = arena.Integer(1 << sh);
+            }
+        }
+        if(!factor) continue;
+        //下面会往 ivs 里追加，先把要用的字段拷出来
+        IV base = *iv;
+        auto key = make_pair(base.phi, factor);
+        if(!mul_iv.count(key)){
+            koopa_raw_value_t init = fold(KOOPA_RBO_MUL, base.init, factor);
+            koopa_raw_value_t step = fold(KOOPA_RBO_MUL, base.step, factor);
+            koopa_raw_value_t param = add_param(arena.Int32Type(), init, [&](koopa_raw_value_t p){
+                return NewBinary(KOOPA_RBO_ADD, p, step);
+            });
+            mul_iv[key] = param;
+            //新变量本身也是归纳变量，下面的指针削弱可以继续用
+            ivs.push_back({param, init, step});
+        }
+        replace[inst] = mul_iv[key];
+    }
+
+    //getelemptr/getptr base, i + off（base、off 不变，i 的步长是常量）变成每次前进 step 个元素的指针
+    auto resolve = [&](koopa_raw_value_t v){
+        auto it = replace.find(v);
+        return it == replace.end() ? v : it->second;
+    };
+    map<pair<koopa_raw_value_t, koopa_raw_value_t>, koopa_raw_value_t> ptr_iv;
+    for(auto inst : candidates){
+        auto tag = inst->kind.tag;
+        if(tag != KOOPA_RVT_GET_ELEM_PTR && tag != KOOPA_RVT_GET_PTR) continue;
+        koopa_raw_value_t src = tag == KOOPA_RVT_GET_ELEM_PTR ? inst->kind.data.get_elem_ptr.src : inst->kind.data.get_ptr.src;
+        koopa_raw_value_t index = resolve(tag == KOOPA_RVT_GET_ELEM_PTR ? inst->kind.data.get_elem_ptr.index
+                                                                        : inst->kind.data.get_ptr.index);
+        if(!invariant(src)) continue;
+        const IV *iv = find_iv(index);
+        koopa_raw_value_t offset = nullptr;
+        if(!iv && index->kind.tag == KOOPA_RVT_BINARY && index->kind.data.binary.op == KOOPA_RBO_ADD){
+            const auto &add = index->kind.data.binary;
+            koopa_raw_value_t l = resolve(add.lhs), r = resolve(add.rhs);
+            if(find_iv(l) && invariant(r)){
+                iv = find_iv(l);
+                offset = r;
+            }else if(find_iv(r) && invariant(l)){
+                iv = find_iv(r);
+                offset = l;
+            }
+        }
+        if(!iv || !IsConst(iv->step)) continue;
+        auto key = make_pair(src, index);
+        if(!ptr_iv.count(key)){
+            koopa_raw_value_t start = offset ? fold(KOOPA_RBO_ADD, iv->init, offset) : iv->init;
+            koopa_raw_value_data_t *init = arena.NewValue(inst->ty, nullptr, tag);
+            if(tag == KOOPA_RVT_GET_ELEM_PTR){
+                init->kind.data.get_elem_ptr.src = src;
+                init->kind.data.get_elem_ptr.index = start;
+            }else{
+                init->kind.data.get_ptr.src = src;
+                init->kind.data.get_ptr.index = start;
+            }
+            emit_pre(init);
+            koopa_raw_value_t step = iv->step;
+            ptr_iv[key] = add_param(inst->ty, init, [&](koopa_raw_value_t p){
+                koopa_raw_value_data_t *next = arena.NewValue(inst->ty, nullptr, KOOPA_RVT_GET_PTR);
+                next->kind.data.get_ptr.src = p;
+                next->kind.data.get_ptr.index = step;
+                return (koopa_raw_value_t) next;
+            });
+        }
+        replace[inst] = ptr_iv[key];
+    }
+    return replace;
+}
+
+//乘除以常数改写成移位和加减，原指令就地改成序列的最后一条，已有的使用不受影响
+void StrengthReducePass::ReduceConstOps(koopa_raw_function_t func){
+    for(size_t b = 0; b < func->bbs.len; b++){
+        koopa_raw_basic_block_t bb = (koopa_raw_basic_block_t) func->bbs.buffer[b];
+        vector<koopa_raw_value_t> out;
+        bool changed = false;
+        for(size_t i = 0; i < bb->insts.len; i++){
+            koopa_raw_value_t inst = (koopa_raw_value_t) bb->insts.buffer[i];
+            if(inst->kind.tag != KOOPA_RVT_BINARY){
+                out.push_back(inst);
+                continue;
+            }
+            auto &bin = AsMutable(inst)->kind.data.binary;
+            if(bin.op == KOOPA_RBO_MUL && IsConst(bin.lhs) && !IsConst(bin.rhs)){
+                swap(bin.lhs, bin.rhs);
+            }
+            if(!IsConst(bin.rhs) || IsConst(bin.lhs)){
+                out.push_back(inst);
+                continue;
+            }
+            koopa_raw_value_t x = bin.lhs;
+            int64_t c = bin.rhs->kind.data.integer.value;
+            auto emit = [&](koopa_raw_binary_op_t op, koopa_raw_value_t l, koopa_raw_value_t r){
+                koopa_raw_value_t v = NewBinary(op, l, r);
+                out.push_back(v);
+                return v;
+            };
+            //向零取整的偏移：x 为负时加上 2^k - 1
+            auto round_bias = [&](int k){
+                koopa_raw_value_t sign = k == 1 ? x : emit(KOOPA_RBO_SAR, x, arena.Integer(31));
+                koopa_raw_value_t bias = emit(KOOPA_RBO_SHR, sign, arena.Integer(32 - k));
+                return emit(KOOPA_RBO_ADD, x, bias);
+            };
+            int k;
+            if(bin.op == KOOPA_RBO_MUL && (k = Log2(c)) > 0){
+                bin = {KOOPA_RBO_SHL, x, arena.Integer(k)};
+            }else if(bin.op == KOOPA_RBO_MUL && c > 2 && (k = Log2(c - 1)) > 0){
+                bin = {KOOPA_RBO_ADD, emit(KOOPA_RBO_SHL, x, arena.Integer(k)), x};
+            }else if(bin.op == KOOPA_RBO_MUL && (k = Log2(c + 1)) > 1){
+                bin = {KOOPA_RBO_SUB, emit(KOOPA_RBO_SHL, x, arena.Integer(k)), x};
+            }else if(bin.op == KOOPA_RBO_DIV && (k = Log2(c)) > 0){
+                bin = {KOOPA_RBO_SAR, round_bias(k), arena.Integer(k)};
+            }else if(bin.op == KOOPA_RBO_DIV && (k = Log2(-c)) > 0){
+                koopa_raw_value_t q = emit(KOOPA_RBO_SAR, round_bias(k), arena.Integer(k));
+                bin = {KOOPA_RBO_SUB, arena.Integer(0), q};
+            }else if(bin.op == KOOPA_RBO_MOD && ((k = Log2(c)) > 0 || (k = Log2(-c)) > 0)){
+                //余数与被除数同号：x - ((x + bias) & -2^k)
+                koopa_raw_value_t rounded = emit(KOOPA_RBO_AND, round_bias(k), arena.Integer(-(1 << k)));
+                bin = {KOOPA_RBO_SUB, x, rounded};
+            }else{
+                out.push_back(inst);
+                continue;
+            }
+            out.push_back(inst);
+            changed = true;
+        }
+        if(changed){
+            AsMutable(bb)->insts = arena.NewSlice(out, KOOPA_RSIK_VALUE);
+        }
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include "koopa.h"
+#include "rawir.h"
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+struct Loop;
+class CFG;
+
+//强度削弱
+//1. 循环里的归纳变量：i * k 变成每次迭代加 k 的新归纳变量，getelemptr 数组, i 变成每次迭代前进的指针
+//2. 乘除常数：2 的幂用移位，2^k±1 用移位加减，有符号除法/取模按向零取整修正
+//   其它常数的除法在后端用 mulh 魔数乘法完成（Koopa IR 没有取高位的乘法）
+class StrengthReducePass {
+public:
+    explicit StrengthReducePass(RawIRArena &arena) : arena(arena) {}
+    void Run(const koopa_raw_program_t &program);
+private:
+    RawIRArena &arena;
+    int iv_cnt = 0;
+
+    void RunOnFunction(koopa_raw_function_t func);
+    //返回替换表：被削弱的指令 -> 新的归纳变量
+    unordered_map<koopa_raw_value_t, koopa_raw_value_t> ReduceLoop(const CFG &cfg, const Loop &loop,
+                                                                   vector<vector<koopa_raw_value_t>> &insts,
+                                                                   unordered_map<koopa_raw_value_t, int> &def_block);
+    void ReduceConstOps(koopa_raw_function_t func);
+    koopa_raw_value_t NewBinary(koopa_raw_binary_op_t op, koopa_raw_value_t lhs, koopa_raw_value_t rhs);
+};
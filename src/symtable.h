@@ -1,8 +1,13 @@
 #pragma once
 #include <string> 
+#include <string_view>
 #include <vector>
+#include <deque>
+#include <algorithm>
 #include <unordered_map>
 #include <iostream>
+#include "rawir.h"
+#include "arena.h"
 using namespace std;
 enum class SymbolType{
     VARIABLE,
@@ -15,66 +20,149 @@ struct SymbolEntry
 {
     SymbolType type;
     int int_val;
-    string var_name;
+    koopa_raw_value_t ptr = nullptr;      //变量和数组常量：它的 alloc / global alloc
+    koopa_raw_function_t func = nullptr;  //函数
     /* data */
 };
 
+//标识符驻留：词法分析时把每个标识符映射成一个从 0 开始的整数 id
+//之后的符号表操作只比较 id，不再对字符串做哈希
+using SymbolId = int;
+
+class IdentTable {
+    private:
+        Arena &arena;
+        unordered_map<string_view, SymbolId> ids;
+        vector<const string *> names;   //字符串本身存放在 arena 中
+    public:
+    explicit IdentTable(Arena &arena) : arena(arena) {}
+    //从 base 已有的标识符开始编号，base 的字符串必须比这张表活得久
+    IdentTable(Arena &arena, const IdentTable &base) : arena(arena), ids(base.ids), names(base.names) {}
+
+    SymbolId Intern(string_view name){
+        auto it = ids.find(name);
+        if (it != ids.end()) {
+            return it->second;
+        }
+        //ids 本身已经去重，这里只需在 arena 里存一份拷贝，不必再经过 Arena::Intern 的哈希表
+        const string *str = arena.New<string>(name);
+        SymbolId id = names.size();
+        names.push_back(str);
+        ids.emplace(string_view(*str), id);
+        return id;
+    }
+
+    const string& Name(SymbolId id) const {
+        return *names[id];
+    }
+
+    int Size() const {
+        return names.size();
+    }
+};
+
+//作用域符号表：所有作用域共用一张以 id 为下标的表，外层的同名符号压在影子栈里
+//查找只需一次下标访问；进出作用域只移动栈顶，不分配新的哈希表
 class SymbolTable {
     private:
-        vector<unordered_map<string, SymbolEntry>> scopes;
+        struct Binding {
+            SymbolId id;
+            SymbolEntry entry;
+            int depth;
+            int shadowed;     //被遮蔽的外层绑定在 bindings 中的下标，-1 表示没有
+        };
+        const IdentTable &names;
+        vector<int> current;          //每个 id 当前可见的绑定，-1 表示未定义
+        deque<Binding> bindings;      //影子栈，deque 保证 Lookup 返回的指针在后续 Insert 后仍然有效
+        vector<int> scope_start;      //每个作用域在 bindings 中的起始位置
+        ostream *diag = &cerr;
     public:
-    SymbolTable(){
-        scopes.emplace_back(); // 添加全局作用域
+    explicit SymbolTable(const IdentTable &names) : names(names) {
+        scope_start.push_back(0); // 添加全局作用域
+    }
+
+    //错误信息写到这次编译的诊断流
+    void SetDiag(ostream *out){
+        diag = out;
     }
 
     void EnterScope(){
-        scopes.push_back({});
+        scope_start.push_back(bindings.size());
     }
 
     void ExitScope(){
-        if (scopes.size() > 1) {
-            scopes.pop_back();
+        if (scope_start.size() > 1) {
+            int start = scope_start.back();
+            scope_start.pop_back();
+            while ((int)bindings.size() > start) {
+                const Binding &b = bindings.back();
+                current[b.id] = b.shadowed;
+                bindings.pop_back();
+            }
         } else {
-            cerr << "Error: Cannot exit global scope!" << endl;
+            *diag << "Error: Cannot exit global scope!" << endl;
         }
     }
 
-    bool Insert(const string& name, const SymbolEntry& entry){
-        if (scopes.back().count(name) > 0) {
-            cerr << "Error: Redefinition of symbol '" << name << "' in the same scope!" << endl;
+    bool Insert(SymbolId id, const SymbolEntry& entry){
+        if (id >= (int)current.size()) {
+            current.resize(max(id + 1, names.Size()), -1);
+        }
+        int depth = scope_start.size() - 1;
+        int prev = current[id];
+        if (prev >= 0 && bindings[prev].depth == depth) {
+            *diag << "Error: Redefinition of symbol '" << names.Name(id) << "' in the same scope!" << endl;
             return false;
-        } else {
-            scopes.back()[name] = entry;
         }
+        current[id] = bindings.size();
+        bindings.push_back({id, entry, depth, prev});
         return true;
     }
 
-    SymbolEntry* Lookup(const string& name){
-        for (auto it = scopes.rbegin(); it != scopes.rend(); ++it) {
-            auto found = it->find(name);
-            if (found != it->end()) {
-                return &found->second;
-            }
+    SymbolEntry* Lookup(SymbolId id){
+        if (id < 0 || id >= (int)current.size() || current[id] < 0) {
+            return nullptr; // 未找到
         }
-        return nullptr; // 未找到
+        return &bindings[current[id]].entry;
     }
 };
 
 
+//生成 Koopa IR：在内存中构建 raw program，值、基本块和函数都用 raw 对象的指针传递
+//-koopa 模式最后再由 KoopaTextWriter 把整个 program 写成文本
 class KoopaIRBuilder{
 private:
     int tmp_cnt = 0;
-    string alloc_buffer = "";
-    string inst_buffer = "";
-    string global_buffer = "";
     bool is_block_closed = false;
+    RawIRBuilder *raw = nullptr;
+    koopa_raw_function_t cur_func = nullptr;
+    ostream *diag = &cerr;
     struct loopInfo{
-        string entry_label;
-        string end_label;
+        koopa_raw_basic_block_t entry;
+        koopa_raw_basic_block_t end;
     };
     vector<loopInfo> loop_stack;
+
+
+    //当前块已经结束时不能再追加指令
+    bool CheckBlockOpen(){
+        if(is_block_closed){
+            *diag << "Error: Cannot add instruction to a closed block!" << endl;
+            return false;
+        }
+        return true;
+    }
+
 public:
-    void Pushloop(const string& entry, const string& end){
+    void UseRawIR(RawIRBuilder *raw_builder){
+        raw = raw_builder;
+    }
+
+    void SetDiag(ostream *out){
+        diag = out;
+    }
+
+    void Pushloop(koopa_raw_basic_block_t entry, koopa_raw_basic_block_t end){
         loop_stack.push_back({entry, end});
     }
 
@@ -82,32 +170,30 @@ public:
         if(!loop_stack.empty()){
             loop_stack.pop_back();
         }else {
-            cerr << "Error: Loop stack is already empty!" << endl;
+            *diag << "Error: Loop stack is already empty!" << endl;
         }
     }
 
-    string GetCurrentLoopEntry() const {
+    koopa_raw_basic_block_t GetCurrentLoopEntry() const {
         if(!loop_stack.empty()){
-            return loop_stack.back().entry_label;
+            return loop_stack.back().entry;
         }else {
-            cerr << "Error: Loop stack is empty!" << endl;
-            return "";
+            *diag << "Error: Loop stack is empty!" << endl;
+            return nullptr;
         }
     }
     
-    string GetCurrentLoopEnd() const {
+    koopa_raw_basic_block_t GetCurrentLoopEnd() const {
         if(!loop_stack.empty()){
-            return loop_stack.back().end_label;
+            return loop_stack.back().end;
         }else {
-            cerr << "Error: Loop stack is empty!" << endl;
-            return "";
+            *diag << "Error: Loop stack is empty!" << endl;
+            return nullptr;
         }
     }
 
     void Reset(){
         tmp_cnt = 0;
-        alloc_buffer = "";
-        inst_buffer = "";
         is_block_closed = false;
     }
 
@@ -115,82 +201,114 @@ public:
         return tmp_cnt++;
     }
 
-    string GetTmpVar(){
-        return "%" + to_string(GetUniqueId());
+    koopa_raw_value_t Integer(int value){
+        return raw->Integer(value);
     }
 
-    void AddGlobalDecl(const string& decl){
-        global_buffer += decl + "\n\n";
+    //预先建好的库函数声明
+    void AddLibraryDecls(const vector<koopa_raw_function_t>& decls){
+        raw->AddFuncDecls(decls);
     }
 
-    void AddAlloc(const string& inst){
-        alloc_buffer += "  " + inst + "\n";
+    koopa_raw_function_t BeginFunction(const string& name, const vector<string>& param_names, bool has_ret){
+        Reset();
+        cur_func = raw->BeginFunction(name, param_names, has_ret);
+        return cur_func;
     }
 
-    void AddInst(const string& inst){
-        if(is_block_closed){
-            cerr << "Error: Cannot add instruction to a closed block!" << endl;
+    //当前函数的第 i 个形参
+    koopa_raw_value_t GetParam(size_t i) const {
+        return (koopa_raw_value_t) cur_func->params.buffer[i];
+    }
+
+    void EndFunction(){
+        if(!is_block_closed){
+            *diag << "Error: Cannot build function with an open block!" << endl;
             return;
         }
-        inst_buffer += "  " + inst + "\n";
+        raw->EndFunction();
+        cur_func = nullptr;
+    }
+
+    //len < 0 表示标量，init 为空表示 zeroinit
+    koopa_raw_value_t AddGlobalAlloc(const string& name, int len, const vector<int>& init){
+        return raw->AddGlobalAlloc(name, len, init);
+    }
+
+    koopa_raw_value_t AddLocalAlloc(const string& name, int len){
+        return raw->AddLocalAlloc(name, len);
+    }
+
+    //块已经结束时指令不会生成，返回空指针；之后的指令也在这个已结束的块里，同样不会用到它
+    void AddStore(koopa_raw_value_t val, koopa_raw_value_t ptr){
+        if(!CheckBlockOpen()) return;
+        raw->AddStore(val, ptr);
+    }
+
+    koopa_raw_value_t AddLoad(koopa_raw_value_t ptr){
+        if(!CheckBlockOpen()) return nullptr;
+        return raw->AddLoad(ptr);
+    }
+
+    koopa_raw_value_t AddGetElemPtr(koopa_raw_value_t ptr, koopa_raw_value_t idx){
+        if(!CheckBlockOpen()) return nullptr;
+        return raw->AddGetElemPtr(ptr, idx);
+    }
+
+    koopa_raw_value_t AddBinary(koopa_raw_binary_op_t op, koopa_raw_value_t lhs, koopa_raw_value_t rhs){
+        if(!CheckBlockOpen()) return nullptr;
+        return raw->AddBinary(op, lhs, rhs);
+    }
+
+    koopa_raw_value_t AddCall(koopa_raw_function_t func, const vector<koopa_raw_value_t>& args){
+        if(!CheckBlockOpen()) return nullptr;
+        return raw->AddCall(func, args);
+    }
+
+    //基本块先创建出来供跳转引用，之后再用 StartNewBlock 开始
+    koopa_raw_basic_block_t NewBlock(const string& label){
+        return raw->NewBlock(label);
     }
 
     //终结指令
-    void EndWithJump(const string& target){
+    void EndWithJump(koopa_raw_basic_block_t target){
         if(is_block_closed){
-            cerr << "Error: Block is already closed!" << endl;
+            *diag << "Error: Block is already closed!" << endl;
             return;
         }
-        inst_buffer += "  jump " + target + "\n";
+        raw->AddJump(target);
         is_block_closed = true;
     }
 
-    void EndWithBranch(const string& cond, const string& true_label, const string& false_label){
+    void EndWithBranch(koopa_raw_value_t cond, koopa_raw_basic_block_t true_bb, koopa_raw_basic_block_t false_bb){
         if(is_block_closed){
-            cerr << "Error: Block is already closed!" << endl;
+            *diag << "Error: Block is already closed!" << endl;
             return;
         }
-        inst_buffer += "  br " + cond + ", " + true_label + ", " + false_label + "\n";
+        raw->AddBranch(cond, true_bb, false_bb);
         is_block_closed = true;
     }
 
-    //终结指令return
-    void EndWithRet(const string& lable){
-        inst_buffer += "  ret " + lable + "\n";
+    //终结指令return，val 为空表示没有返回值
+    void EndWithRet(koopa_raw_value_t val){
+        if(is_block_closed){
+            *diag << "Error: Block is already closed!" << endl;
+            return;
+        }
+        raw->AddRet(val);
         is_block_closed = true;
     }
 
-    void StartNewBlock(const string& label){
+    void StartNewBlock(koopa_raw_basic_block_t bb){
         if(!is_block_closed){
-            cerr << "Error: Previous block is not closed yet!" << endl;
+            *diag << "Error: Previous block is not closed yet!" << endl;
             return;
         }
-        inst_buffer += label + ":\n";
+        raw->StartBlock(bb);
         is_block_closed = false;
     }
 
-    string BuildFunction(const string& signature){
-        if(!is_block_closed){
-            cerr << "Error: Cannot build function with an open block!" << endl;
-            return "";
-        }
-
-        string final_ir = signature + " {\n";
-        final_ir += "%entry:\n";
-        final_ir += alloc_buffer;
-        final_ir += inst_buffer;
-        final_ir += "\n\n";
-        final_ir += "}\n";
-        return final_ir;
-
-    }
-
-    string GetProgramIR() const{
-        return global_buffer;
-    }
-
-
     bool IsBlockClosed() const {
         return is_block_closed;
     }
-};
\ No newline at end of file
+};
@@ -2,6 +2,7 @@
   #include <memory>
   #include <string>
   #include "ast.h"
+  typedef void *yyscan_t;
 }
 
 %{
@@ -11,25 +12,31 @@
 #include <string>
 #include "ast.h"
 
-int yylex();
-void yyerror(std::unique_ptr<BaseAST> &ast, const char *s);
-
 using namespace std;
 
 %}
 
-%parse-param { std::unique_ptr<BaseAST> &ast }
+%code {
+int yylex(YYSTYPE *yylval, yyscan_t scanner);
+void yyerror(BaseAST *&ast, yyscan_t scanner, const char *s);
+}
+
+// 可重入的分析器：词法状态都在 scanner 里，-daemon 下多个线程可以同时分析不同的文件
+%define api.pure full
+%lex-param { yyscan_t scanner }
+%parse-param { BaseAST *&ast } { yyscan_t scanner }
 
 
 %union {
-  std::string *str_val;
+  const std::string *str_val;
+  SymbolId ident_id;
   int int_val;
   BaseAST* ast_val;
 }
 
 %token INT RETURN LE GE EQ NEQ LAND LOR 
 CONST IF ELSE  WHILE Break Continue VOID
-%token <str_val> IDENT 
+%token <ident_id> IDENT 
 %token <int_val> INT_CONST
 
 
@@ -48,28 +55,28 @@ CompUnit Program ConstExplist Explist
 %%
 
 Program : CompUnit{
-  ast = unique_ptr<BaseAST>($1);
+  ast = $1;
 };
 
 CompUnit
   : Decl{
-    auto ast = new CompUnitAST();
-    ast->global_defs.push_back(unique_ptr<BaseAST>($1));
+    auto ast = cur_ctx->ast_arena.New<CompUnitAST>();
+    ast->global_defs.push_back($1);
     $$ = ast;
   }
   |FuncDef {
-      auto ast = new CompUnitAST();
-      ast->global_defs.push_back(unique_ptr<BaseAST>($1));
+      auto ast = cur_ctx->ast_arena.New<CompUnitAST>();
+      ast->global_defs.push_back($1);
       $$ = ast;    
   }
   | CompUnit Decl{
     auto ast = static_cast<CompUnitAST*>($1);
-    ast->global_defs.push_back(unique_ptr<BaseAST>($2));
+    ast->global_defs.push_back($2);
     $$ = ast;
   }
   | CompUnit FuncDef{
     auto ast = static_cast<CompUnitAST*>($1);
-    ast->global_defs.push_back(unique_ptr<BaseAST>($2));
+    ast->global_defs.push_back($2);
     $$ = ast;
   }
   ;
@@ -77,13 +84,13 @@ CompUnit
 
 Decl
   : ConstDecl{
-    auto ast = new DeclAST();
-    ast->const_decl = unique_ptr<BaseAST>($1);
+    auto ast = cur_ctx->ast_arena.New<DeclAST>();
+    ast->const_decl = $1;
     $$ = ast;
   }
   | VarDecl{
-    auto ast = new DeclAST();
-    ast->var_decl = unique_ptr<BaseAST>($1);
+    auto ast = cur_ctx->ast_arena.New<DeclAST>();
+    ast->var_decl = $1;
     $$ = ast;
   }
   ;
@@ -91,45 +98,45 @@ Decl
 ConstDecl
   : CONST INT ConstDefList ';'{
     auto ast = static_cast<ConstDeclAST*>($3);
-    auto btype_ast = new BTypeAST(); 
-    ast->b_type = unique_ptr<BaseAST>(btype_ast);
+    auto btype_ast = cur_ctx->ast_arena.New<BTypeAST>(); 
+    ast->b_type = btype_ast;
     $$ = ast;
   }
   ;
 
 ConstDefList
   : ConstDef {
-    auto ast = new ConstDeclAST();
-    ast->const_defs.push_back(unique_ptr<BaseAST>($1));
+    auto ast = cur_ctx->ast_arena.New<ConstDeclAST>();
+    ast->const_defs.push_back($1);
     $$ = ast;
   }
   | ConstDefList ',' ConstDef {
     auto ast = static_cast<ConstDeclAST*>($1);
-    ast->const_defs.push_back(unique_ptr<BaseAST>($3));
+    ast->const_defs.push_back($3);
     $$ = ast;
   }
   ;
 
 ConstDef : IDENT '=' ConstInitVal{
-  auto ast = new ConstDefAST();
-  ast->ident = *$1;
-  ast->const_init_val = unique_ptr<BaseAST>($3);
+  auto ast = cur_ctx->ast_arena.New<ConstDefAST>();
+  ast->ident = $1;
+  ast->const_init_val = $3;
   $$ = ast;
 }| IDENT '[' ConstExp ']' '=' ConstInitVal{
-  auto ast = new ConstDefAST();
-  ast->ident = *$1;
-  ast->array_len = unique_ptr<BaseAST>($3);
-  ast->const_init_val = unique_ptr<BaseAST>($6);
+  auto ast = cur_ctx->ast_arena.New<ConstDefAST>();
+  ast->ident = $1;
+  ast->array_len = $3;
+  ast->const_init_val = $6;
   $$ = ast;
 };
 
 
 ConstInitVal: ConstExp{
-  auto ast = new ConstInitValAST();
-  ast->const_exp = unique_ptr<BaseAST>($1);
+  auto ast = cur_ctx->ast_arena.New<ConstInitValAST>();
+  ast->const_exp = $1;
   $$ = ast;
 }| '{' '}'{
-  auto ast = new ConstInitValAST();
+  auto ast = cur_ctx->ast_arena.New<ConstInitValAST>();
   ast->is_array = true;
   $$ = ast;
 }| '{'   ConstExplist  '}'{
@@ -139,66 +146,66 @@ ConstInitVal: ConstExp{
 };
 
 ConstExplist: ConstInitVal{
-  auto ast = new ConstInitValAST();
-  ast->init_list.push_back(unique_ptr<BaseAST>($1));
+  auto ast = cur_ctx->ast_arena.New<ConstInitValAST>();
+  ast->init_list.push_back($1);
   $$ = ast;
 }| ConstExplist ',' ConstInitVal{
   auto ast = static_cast<ConstInitValAST*>($1);
-  ast->init_list.push_back(unique_ptr<BaseAST>($3));
+  ast->init_list.push_back($3);
   $$ = ast;
 }
 
 VarDecl
   : INT VarDefList ';'{
     auto ast = static_cast<VarDeclAST*>($2);
-    auto btype_ast = new BTypeAST();
-    ast->b_type = unique_ptr<BaseAST>(btype_ast);
+    auto btype_ast = cur_ctx->ast_arena.New<BTypeAST>();
+    ast->b_type = btype_ast;
     $$ = ast;
   };
 
 VarDefList : VarDef {
-    auto ast = new VarDeclAST();
-    ast->var_defs.push_back(unique_ptr<BaseAST>($1));
+    auto ast = cur_ctx->ast_arena.New<VarDeclAST>();
+    ast->var_defs.push_back($1);
     $$ = ast;
   }
   | VarDefList ',' VarDef {
     auto ast = static_cast<VarDeclAST*>($1);
-    ast->var_defs.push_back(unique_ptr<BaseAST>($3));
+    ast->var_defs.push_back($3);
     $$ = ast;
   };
 
 VarDef: IDENT{
-  auto ast = new VarDefAST();
-  ast->ident = *$1;
+  auto ast = cur_ctx->ast_arena.New<VarDefAST>();
+  ast->ident = $1;
   $$ = ast;
 } | IDENT '=' InitVal{
-  auto ast = new VarDefAST();
-  ast->ident = *$1;
-  ast->init_val = unique_ptr<BaseAST>($3);
+  auto ast = cur_ctx->ast_arena.New<VarDefAST>();
+  ast->ident = $1;
+  ast->init_val = $3;
   $$ = ast;
 }| IDENT '['  ConstExp ']'{
-  auto ast = new VarDefAST();
-  ast->ident = *$1;
-  ast->array_len = unique_ptr<BaseAST>($3);
+  auto ast = cur_ctx->ast_arena.New<VarDefAST>();
+  ast->ident = $1;
+  ast->array_len = $3;
   $$ = ast;
 
 }| IDENT '[' ConstExp ']' '=' InitVal{
-  auto ast = new VarDefAST();
-  ast->ident = *$1;
-  ast->array_len = unique_ptr<BaseAST>($3);
-  ast->init_val = unique_ptr<BaseAST>($6);
+  auto ast = cur_ctx->ast_arena.New<VarDefAST>();
+  ast->ident = $1;
+  ast->array_len = $3;
+  ast->init_val = $6;
   $$ = ast;
 };
 
 
 
 InitVal: Exp{
-  auto ast = new InitValAST();
+  auto ast = cur_ctx->ast_arena.New<InitValAST>();
   ast->is_array = false;
-  ast->exp = unique_ptr<BaseAST>($1);
+  ast->exp = $1;
   $$ = ast;
 }| '{' '}'{
-  auto ast = new InitValAST();
+  auto ast = cur_ctx->ast_arena.New<InitValAST>();
   ast->is_array = true;
   $$ = ast;
 }| '{'   Explist '}'{
@@ -209,70 +216,70 @@ InitVal: Exp{
 
 Explist : Explist ',' Exp{
   auto ast = static_cast<InitValAST*>($1);
-  ast->init_list.push_back(unique_ptr<BaseAST>($3));
+  ast->init_list.push_back($3);
   $$ = ast;
 }| Exp{
-  auto ast = new InitValAST();
-  ast->init_list.push_back(unique_ptr<BaseAST>($1));
+  auto ast = cur_ctx->ast_arena.New<InitValAST>();
+  ast->init_list.push_back($1);
   $$ = ast;
 
 };
 
 FuncDef
   : INT IDENT '(' ')' Block {
-    auto ast = new FuncDefAST();
-    auto type_ast = new FuncTypeAST(); type_ast->type = "int";
-    ast->func_type = unique_ptr<BaseAST>(type_ast);
-    ast->ident = *unique_ptr<string>($2);
-    ast->block = unique_ptr<BaseAST>($5);
+    auto ast = cur_ctx->ast_arena.New<FuncDefAST>();
+    auto type_ast = cur_ctx->ast_arena.New<FuncTypeAST>(); type_ast->type = "int";
+    ast->func_type = type_ast;
+    ast->ident = $2;
+    ast->block = $5;
     $$ = ast;
   }
   | VOID IDENT '(' ')' Block {
-    auto ast = new FuncDefAST();
-    auto type_ast = new FuncTypeAST(); type_ast->type = "void";
-    ast->func_type = unique_ptr<BaseAST>(type_ast);
-    ast->ident = *unique_ptr<string>($2);
-    ast->block = unique_ptr<BaseAST>($5);
+    auto ast = cur_ctx->ast_arena.New<FuncDefAST>();
+    auto type_ast = cur_ctx->ast_arena.New<FuncTypeAST>(); type_ast->type = "void";
+    ast->func_type = type_ast;
+    ast->ident = $2;
+    ast->block = $5;
     $$ = ast;
   }
   | INT IDENT '(' FuncFParams ')' Block {
-    auto ast = new FuncDefAST();
-    auto type_ast = new FuncTypeAST(); type_ast->type = "int";
-    ast->func_type = unique_ptr<BaseAST>(type_ast);
-    ast->ident = *$2;
-    ast->func_params = unique_ptr<BaseAST>($4);
-    ast->block = unique_ptr<BaseAST>($6);
+    auto ast = cur_ctx->ast_arena.New<FuncDefAST>();
+    auto type_ast = cur_ctx->ast_arena.New<FuncTypeAST>(); type_ast->type = "int";
+    ast->func_type = type_ast;
+    ast->ident = $2;
+    ast->func_params = $4;
+    ast->block = $6;
     $$ = ast;
   }
   | VOID IDENT '(' FuncFParams ')' Block {
-    auto ast = new FuncDefAST();
-    auto type_ast = new FuncTypeAST(); type_ast->type = "void";
-    ast->func_type = unique_ptr<BaseAST>(type_ast);
-    ast->ident = *$2;
-    ast->func_params = unique_ptr<BaseAST>($4);
-    ast->block = unique_ptr<BaseAST>($6);
+    auto ast = cur_ctx->ast_arena.New<FuncDefAST>();
+    auto type_ast = cur_ctx->ast_arena.New<FuncTypeAST>(); type_ast->type = "void";
+    ast->func_type = type_ast;
+    ast->ident = $2;
+    ast->func_params = $4;
+    ast->block = $6;
     $$ = ast;
   }
   ;
 
   
 FuncFParams: FuncFParam{
-  auto ast = new FuncFParamsAST();
-  ast->params.push_back(unique_ptr<BaseAST>($1));
+  auto ast = cur_ctx->ast_arena.New<FuncFParamsAST>();
+  ast->params.push_back($1);
   $$ = ast;
 }
 | FuncFParams ',' FuncFParam{
   auto ast = static_cast<FuncFParamsAST*>($1);
-  ast->params.push_back(unique_ptr<BaseAST>($3));
+  ast->params.push_back($3);
   $$ = ast;
 };
 
 FuncFParam
   : INT IDENT {
-    auto ast = new FuncFParamAST();
-    auto btype_ast = new BTypeAST();
-    ast->b_type = unique_ptr<BaseAST>(btype_ast);
-    ast->ident = *$2;
+    auto ast = cur_ctx->ast_arena.New<FuncFParamAST>();
+    auto btype_ast = cur_ctx->ast_arena.New<BTypeAST>();
+    ast->b_type = btype_ast;
+    ast->ident = $2;
     $$ = ast;
   };
 
@@ -282,28 +289,28 @@ Block: '{' BlockItemList '}' {
   $$ = $2;
 }
 | '{' '}'{
-  $$ = new BlockAST();
+  $$ = cur_ctx->ast_arena.New<BlockAST>();
 };
 
 BlockItemList: BlockItem {
-    auto ast = new BlockAST();
-    ast->block_items.push_back(unique_ptr<BaseAST>($1));
+    auto ast = cur_ctx->ast_arena.New<BlockAST>();
+    ast->block_items.push_back($1);
     $$ = ast;
   }
   | BlockItemList BlockItem {
     auto ast = static_cast<BlockAST*>($1);
-    ast->block_items.push_back(unique_ptr<BaseAST>($2));
+    ast->block_items.push_back($2);
     $$ = ast;
   };
 
 BlockItem: Decl{
-  auto ast = new BlockItemAST();
-  ast->decl = unique_ptr<BaseAST>($1);
+  auto ast = cur_ctx->ast_arena.New<BlockItemAST>();
+  ast->decl = $1;
   $$ = ast;
 }
 | Stmt {
-  auto ast = new BlockItemAST();
-  ast->stmt = unique_ptr<BaseAST>($1);
+  auto ast = cur_ctx->ast_arena.New<BlockItemAST>();
+  ast->stmt = $1;
   $$ = ast;
 };
 
@@ -311,67 +318,67 @@ BlockItem: Decl{
 Stmt
   : LVal '=' Exp ';' {
       // 匹配: LVal = Exp;
-      auto ast = new StmtAST();
-      ast->lval = unique_ptr<BaseAST>($1);
-      ast->exp = unique_ptr<BaseAST>($3);
+      auto ast = cur_ctx->ast_arena.New<StmtAST>();
+      ast->lval = $1;
+      ast->exp = $3;
       $$ = ast;
   }
   | Exp ';' {
       // 匹配: Exp;
-      auto ast = new StmtAST();
-      ast->exp = unique_ptr<BaseAST>($1);
+      auto ast = cur_ctx->ast_arena.New<StmtAST>();
+      ast->exp = $1;
       $$ = ast;
   }
   | ';' {
       // 匹配: ; (空语句)
-      $$ = new StmtAST(); // 内部所有指针全为空，is_return 也是 false
+      $$ = cur_ctx->ast_arena.New<StmtAST>(); // 内部所有指针全为空，is_return 也是 false
   }
   | Block {
       // 匹配: Block
-      auto ast = new StmtAST();
-      ast->block = unique_ptr<BaseAST>($1);
+      auto ast = cur_ctx->ast_arena.New<StmtAST>();
+      ast->block = $1;
       $$ = ast;
   }
   | RETURN Exp ';' {
       // 匹配: return Exp;
-      auto ast = new StmtAST();
+      auto ast = cur_ctx->ast_arena.New<StmtAST>();
       ast->is_return = true;
-      ast->exp = unique_ptr<BaseAST>($2);
+      ast->exp = $2;
       $$ = ast;
   }
   | RETURN ';' {
       // 匹配: return;
-      auto ast = new StmtAST();
+      auto ast = cur_ctx->ast_arena.New<StmtAST>();
       ast->is_return = true;
       $$ = ast;
   }
   | IF '(' Exp ')' Stmt{
-      auto ast = new StmtAST();
+      auto ast = cur_ctx->ast_arena.New<StmtAST>();
       ast->is_if = true;
-      ast->cond = unique_ptr<BaseAST>($3);
-      ast->then_stmt = unique_ptr<BaseAST>($5);
+      ast->cond = $3;
+      ast->then_stmt = $5;
       $$ = ast;
   }
   | IF '(' Exp ')' Stmt ELSE Stmt{
-      auto ast = new StmtAST();
+      auto ast = cur_ctx->ast_arena.New<StmtAST>();
       ast->is_if = true;
-      ast->cond = unique_ptr<BaseAST>($3);
-      ast->then_stmt = unique_ptr<BaseAST>($5);
-      ast->else_stmt = unique_ptr<BaseAST>($7);
+      ast->cond = $3;
+      ast->then_stmt = $5;
+      ast->else_stmt = $7;
       $$ = ast;
   }
   | Whileblock{
-    auto ast = new StmtAST();
-    ast->while_exp = unique_ptr<BaseAST>($1);
+    auto ast = cur_ctx->ast_arena.New<StmtAST>();
+    ast->while_exp = $1;
     $$ = ast;
   }
   | Break{
-    auto ast = new StmtAST();
+    auto ast = cur_ctx->ast_arena.New<StmtAST>();
     ast->is_break = true;
     $$ = ast;
   }
   | Continue{
-    auto ast = new StmtAST();
+    auto ast = cur_ctx->ast_arena.New<StmtAST>();
     ast->is_continue = true;
     $$ = ast;
   };
@@ -379,44 +386,44 @@ Stmt
 
 Exp
   : LOrExp {
-    auto ast = new ExpAST();
-    ast->lor_exp = unique_ptr<BaseAST>($1);
+    auto ast = cur_ctx->ast_arena.New<ExpAST>();
+    ast->lor_exp = $1;
     $$ = ast;
   }
   ;
 
 
 LVal : IDENT {
-  auto ast = new LValAST();
-  ast->ident = *$1;
+  auto ast = cur_ctx->ast_arena.New<LValAST>();
+  ast->ident = $1;
   $$ = ast;
 }| IDENT '[' Exp ']'{
-  auto ast = new LValAST();
-  ast->ident = *$1;
-  ast->array_idx = unique_ptr<BaseAST>($3);
+  auto ast = cur_ctx->ast_arena.New<LValAST>();
+  ast->ident = $1;
+  ast->array_idx = $3;
   $$ = ast;
 };
 
 
 PrimaryExp
   : '(' Exp ')' {
-    auto ast = new PrimaryExpAST();
-    ast->exp = unique_ptr<BaseAST>($2);
+    auto ast = cur_ctx->ast_arena.New<PrimaryExpAST>();
+    ast->exp = $2;
     $$ = ast;
   }
   | Number {
-    auto ast = new PrimaryExpAST();
-    ast->number = unique_ptr<BaseAST>($1);
+    auto ast = cur_ctx->ast_arena.New<PrimaryExpAST>();
+    ast->number = $1;
     $$ = ast;
   }| LVal {
-    auto ast = new PrimaryExpAST();
-    ast->LVal = unique_ptr<BaseAST>($1);
+    auto ast = cur_ctx->ast_arena.New<PrimaryExpAST>();
+    ast->LVal = $1;
     $$ = ast;
   };
 
 Number
   : INT_CONST {
-    auto ast = new NumberAST();
+    auto ast = cur_ctx->ast_arena.New<NumberAST>();
     ast->value = $1;
     $$ = ast;
   }
@@ -425,24 +432,24 @@ Number
 
 UnaryExp
   : PrimaryExp {
-    auto ast = new UnaryExpAST();
-    ast->primary_exp = unique_ptr<BaseAST>($1);
+    auto ast = cur_ctx->ast_arena.New<UnaryExpAST>();
+    ast->primary_exp = $1;
     $$ = ast;
   }
   | UnaryOp UnaryExp{
-    auto ast = new UnaryExpAST();
+    auto ast = cur_ctx->ast_arena.New<UnaryExpAST>();
     ast->op = $1;
-    ast->unary_exp = unique_ptr<BaseAST>($2);
+    ast->unary_exp = $2;
     $$ = ast;
   }
   |IDENT '(' ')' {
-    auto ast = new UnaryExpAST();
-    ast->ident = *$1;
+    auto ast = cur_ctx->ast_arena.New<UnaryExpAST>();
+    ast->ident = $1;
     $$ = ast;
   }| IDENT '(' FuncRParams ')'{
-    auto ast = new UnaryExpAST();
-    ast->ident = *$1;
-    ast->func_call = unique_ptr<BaseAST>($3);
+    auto ast = cur_ctx->ast_arena.New<UnaryExpAST>();
+    ast->ident = $1;
+    ast->func_call = $3;
     $$ = ast;
   }
   ;
@@ -454,13 +461,13 @@ UnaryOp
  ;
 
  FuncRParams: Exp{
-  auto ast = new FuncRParamsAST();
-  ast->exps.push_back(unique_ptr<BaseAST>($1));
+  auto ast = cur_ctx->ast_arena.New<FuncRParamsAST>();
+  ast->exps.push_back($1);
   $$ = ast;
 }
 | FuncRParams ',' Exp{
   auto ast = static_cast<FuncRParamsAST*>($1);
-  ast->exps.push_back(unique_ptr<BaseAST>($3));
+  ast->exps.push_back($3);
   $$ = ast;
 };
 
@@ -478,126 +485,127 @@ MulOp
   
 MulExp 
   : UnaryExp {
-    auto ast = new MulExpAST();
-    ast->unary_exp = unique_ptr<BaseAST>($1);
+    auto ast = cur_ctx->ast_arena.New<MulExpAST>();
+    ast->unary_exp = $1;
     $$ = ast;
   }
   | MulExp MulOp UnaryExp{
-    auto ast = new MulExpAST();
-    ast->mul_exp = unique_ptr<BaseAST>($1);
+    auto ast = cur_ctx->ast_arena.New<MulExpAST>();
+    ast->mul_exp = $1;
     ast->op = $2;
-    ast->unary_exp = unique_ptr<BaseAST>($3);
+    ast->unary_exp = $3;
     $$ = ast;
   }
   ;
 
 AddExp
   : MulExp {
-    auto ast = new AddExpAST();
-    ast->mul_exp = unique_ptr<BaseAST>($1);
+    auto ast = cur_ctx->ast_arena.New<AddExpAST>();
+    ast->mul_exp = $1;
     $$ = ast;
   }
   | AddExp AddOp MulExp{
-    auto ast = new AddExpAST();
-    ast->add_exp = unique_ptr<BaseAST>($1);
+    auto ast = cur_ctx->ast_arena.New<AddExpAST>();
+    ast->add_exp = $1;
     ast->op = $2;
-    ast->mul_exp = unique_ptr<BaseAST>($3);
+    ast->mul_exp = $3;
     $$ = ast;
   }
   ;
 
 RelOp
-  : '<' { $$ = new std::string("<"); }
-  | '>' { $$ = new std::string(">"); }
-  | LE  { $$ = new std::string("<="); }
-  | GE  { $$ = new std::string(">="); }
+  : '<' { $$ = cur_ctx->ast_arena.Intern("<"); }
+  | '>' { $$ = cur_ctx->ast_arena.Intern(">"); }
+  | LE  { $$ = cur_ctx->ast_arena.Intern("<="); }
+  | GE  { $$ = cur_ctx->ast_arena.Intern(">="); }
   ;
 
 EqOp
-  : EQ  { $$ = new std::string("=="); }
-  | NEQ { $$ = new std::string("!="); }
+  : EQ  { $$ = cur_ctx->ast_arena.Intern("=="); }
+  | NEQ { $$ = cur_ctx->ast_arena.Intern("!="); }
   ;
 
 
 RelExp
   : AddExp {
-    auto ast = new RelExp();
-    ast->add_exp = unique_ptr<BaseAST>($1);
+    auto ast = cur_ctx->ast_arena.New<RelExp>();
+    ast->add_exp = $1;
     $$ = ast;
   }
   | RelExp RelOp AddExp {
-    auto ast = new RelExp();
-    ast->rel_exp = unique_ptr<BaseAST>($1);
-    ast->op = *unique_ptr<string>($2);     
-    ast->add_exp = unique_ptr<BaseAST>($3);
+    auto ast = cur_ctx->ast_arena.New<RelExp>();
+    ast->rel_exp = $1;
+    ast->op = *$2;     
+    ast->add_exp = $3;
     $$ = ast;
   }
   ;
 
 EqExp
   : RelExp {
-    auto ast = new EqExp();
-    ast->rel_exp = unique_ptr<BaseAST>($1);
+    auto ast = cur_ctx->ast_arena.New<EqExp>();
+    ast->rel_exp = $1;
     $$ = ast;
   }
   | EqExp EqOp RelExp {
-    auto ast = new EqExp();
-    ast->eq_exp = unique_ptr<BaseAST>($1);
-    ast->op = *unique_ptr<string>($2);      
-    ast->rel_exp = unique_ptr<BaseAST>($3);
+    auto ast = cur_ctx->ast_arena.New<EqExp>();
+    ast->eq_exp = $1;
+    ast->op = *$2;      
+    ast->rel_exp = $3;
     $$ = ast;
   }
   ;
 
 LAndExp
   : EqExp {
-    auto ast = new LAndExp();
-    ast->eq_exp = unique_ptr<BaseAST>($1);
+    auto ast = cur_ctx->ast_arena.New<LAndExp>();
+    ast->eq_exp = $1;
     $$ = ast;
   }
   | LAndExp LAND EqExp {
-    auto ast = new LAndExp();
-    ast->land_exp = unique_ptr<BaseAST>($1);
-    ast->eq_exp = unique_ptr<BaseAST>($3);
+    auto ast = cur_ctx->ast_arena.New<LAndExp>();
+    ast->land_exp = $1;
+    ast->eq_exp = $3;
     $$ = ast;
   }
   ;
 
 LOrExp
   : LAndExp {
-    auto ast = new LOrExp();
-    ast->land_exp = unique_ptr<BaseAST>($1);
+    auto ast = cur_ctx->ast_arena.New<LOrExp>();
+    ast->land_exp = $1;
     $$ = ast;
   }
   | LOrExp LOR LAndExp {
-    auto ast = new LOrExp();
-    ast->lor_exp = unique_ptr<BaseAST>($1);
-    ast->land_exp = unique_ptr<BaseAST>($3);
+    auto ast = cur_ctx->ast_arena.New<LOrExp>();
+    ast->lor_exp = $1;
+    ast->land_exp = $3;
     $$ = ast;
   }
   ;
 
 
 ConstExp : Exp{
-  auto ast = new ConstExpAST();
-  ast->exp = unique_ptr<BaseAST>($1);
+  auto ast = cur_ctx->ast_arena.New<ConstExpAST>();
+  ast->exp = $1;
   $$ = ast;
 };
 
 
 
 Whileblock: WHILE '(' Exp ')' Stmt{
-  auto ast = new WhileAST();
-  ast->cond = unique_ptr<BaseAST>($3);
-  ast->stmt = unique_ptr<BaseAST>($5);
+  auto ast = cur_ctx->ast_arena.New<WhileAST>();
+  ast->cond = $3;
+  ast->stmt = $5;
   $$ = ast;
 }
 
 %%
 
-void yyerror(unique_ptr<BaseAST> &ast, const char *s) {
-  extern int yylineno;  // 引入 flex 维护的行号
-  extern char *yytext;  // 引入 flex 当前解析的字符串
-  cerr << "error: " << s << " at line " << yylineno 
-       << " near token '" << yytext << "'" << endl;
+int yyget_lineno(yyscan_t scanner);     // flex 维护的行号
+char *yyget_text(yyscan_t scanner);     // flex 当前解析的字符串
+
+void yyerror(BaseAST *&ast, yyscan_t scanner, const char *s) {
+  *cur_ctx->diag << "error: " << s << " at line " << yyget_lineno(scanner)
+       << " near token '" << yyget_text(scanner) << "'" << endl;
 }
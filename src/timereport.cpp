@@ -0,0 +1,95 @@
+#include "timereport.h"
+#include <cstdio>
+#include <sys/resource.h>
+using namespace std;
+
+//进程到目前为止的峰值 RSS，单位 KB
+static long PeakRSS(){
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+    return usage.ru_maxrss;
+}
+
+static double ElapsedMs(chrono::steady_clock::time_point from, chrono::steady_clock::time_point to){
+    return chrono::duration<double, milli>(to - from).count();
+}
+
+static void WriteString(FILE *fp, const string &str){
+    fputc('"', fp);
+    for(char c : str){
+        if(c == '"' || c == '\\'){
+            fputc('\\', fp);
+            fputc(c, fp);
+        }else if((unsigned char)c < 0x20){
+            fprintf(fp, "\\u%04x", c);
+        }else{
+            fputc(c, fp);
+        }
+    }
+    fputc('"', fp);
+}
+
+TimeReport::TimeReport() : start(Clock::now()), stage_start(start) {}
+
+void TimeReport::Begin(const string &stage){
+    Stage s;
+    s.name = stage;
+    stages.push_back(s);
+    stage_rss_kb = PeakRSS();
+    stage_start = Clock::now();
+}
+
+void TimeReport::End(){
+    Stage &s = stages.back();
+    s.wall_ms = ElapsedMs(stage_start, Clock::now());
+    s.peak_rss_delta_kb = PeakRSS() - stage_rss_kb;
+}
+
+void TimeReport::Count(const string &name, long long value){
+    stages.back().counters.push_back({name, value});
+}
+
+void TimeReport::SetInfo(const string &key, const string &value){
+    info.push_back({key, value});
+}
+
+bool TimeReport::WriteJSON(const string &path) const {
+    FILE *fp = fopen(path.c_str(), "w");
+    if(!fp) return false;
+    fprintf(fp, "{\n");
+    for(const auto &kv : info){
+        fprintf(fp, "  ");
+        WriteString(fp, kv.first);
+        fprintf(fp, ": ");
+        WriteString(fp, kv.second);
+        fprintf(fp, ",\n");
+    }
+    fprintf(fp, "  \"total_ms\": %.3f,\n", ElapsedMs(start, Clock::now()));
+    fprintf(fp, "  \"peak_rss_kb\": %ld,\n", PeakRSS());
+    fprintf(fp, "  \"stages\": [");
+    for(size_t i = 0; i < stages.size(); i++){
+        const Stage &s = stages[i];
+        fprintf(fp, "%s\n    {\"name\": ", i == 0 ? "" : ",");
+        WriteString(fp, s.name);
+        fprintf(fp, ", \"wall_ms\": %.3f, \"peak_rss_delta_kb\": %ld, \"counters\": {", s.wall_ms, s.peak_rss_delta_kb);
+        for(size_t j = 0; j < s.counters.size(); j++){
+            fprintf(fp, "%s", j == 0 ? "" : ", ");
+            WriteString(fp, s.counters[j].first);
+            fprintf(fp, ": %lld", s.counters[j].second);
+        }
+        fprintf(fp, "}}");
+    }
+    fprintf(fp, "\n  ]\n}\n");
+    return fclose(fp) == 0;
+}
+
+void CountProgram(const koopa_raw_program_t &program, long long &insts, long long &blocks){
+    insts = blocks = 0;
+    for(size_t i = 0; i < program.funcs.len; i++){
+        koopa_raw_function_t func = (koopa_raw_function_t) program.funcs.buffer[i];
+        blocks += func->bbs.len;
+        for(size_t j = 0; j < func->bbs.len; j++){
+            insts += ((koopa_raw_basic_block_t) func->bbs.buffer[j])->insts.len;
+        }
+    }
+}
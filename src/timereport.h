@@ -0,0 +1,41 @@
+#pragma once
+#include "koopa.h"
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+using namespace std;
+
+//-time-report：记录编译各阶段的耗时、峰值 RSS 的增量和规模计数，最后以 JSON 写入文件
+//阶段按 Begin/End 成对使用，计数附加在最近结束的阶段上
+class TimeReport {
+public:
+    TimeReport();
+
+    void Begin(const string &stage);
+    void End();
+    //AST 结点数、IR 指令数、汇编行数等
+    void Count(const string &name, long long value);
+    //顶层的附加信息，比如输入文件和模式
+    void SetInfo(const string &key, const string &value);
+
+    //失败时返回 false
+    bool WriteJSON(const string &path) const;
+
+private:
+    struct Stage {
+        string name;
+        double wall_ms = 0;
+        long peak_rss_delta_kb = 0;
+        vector<pair<string, long long>> counters;
+    };
+    using Clock = chrono::steady_clock;
+
+    Clock::time_point start, stage_start;
+    long stage_rss_kb = 0;
+    vector<Stage> stages;
+    vector<pair<string, string>> info;
+};
+
+//raw program 中还在使用的指令数和基本块数
+void CountProgram(const koopa_raw_program_t &program, long long &insts, long long &blocks);
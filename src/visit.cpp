@@ -1,40 +1,159 @@
 #include "visit.h"
+#include "irutil.h"
+#include "workpool.h"
+#include "peephole.h"
+#include <functional>
 #include <iostream>
 #include <string>
 #include <cassert>
 #include <unordered_map>
 using namespace std;
 
-AsmGenerator::AsmGenerator() = default;
-void AsmGenerator::Generate(const koopa_raw_program_t &program){
-    Visit(program);
+AsmGenerator::AsmGenerator(AsmWriter &out, const BlockProfile *profile) : out(out), profile(profile) {}
+
+void AsmGenerator::Emit(const string &op, vector<string> args){
+    body.push_back(AsmInst{op, move(args), ""});
 }
 
+void AsmGenerator::EmitLabel(const string &label){
+    body.push_back(AsmInst{"", {}, label});
+}
 
-void AsmGenerator::load_value(koopa_raw_value_t val,const string&reg,int sp_offset){
+//把指令表写成文本
+static void WriteInsts(AsmWriter &out, const vector<AsmInst> &insts){
+    for(const auto &inst : insts){
+        if(inst.IsLabel()){
+            out << inst.label << ":" << '\n';
+            continue;
+        }
+        out << '\t' << inst.op;
+        for(size_t i = 0; i < inst.args.size(); i++){
+            out << (i == 0 ? " " : ", ") << inst.args[i];
+        }
+        out << '\n';
+    }
+}
+void AsmGenerator::Generate(const koopa_raw_program_t &program, int jobs){
+    if(jobs <= 1){
+        Visit(program);
+        return;
+    }
+    //全局变量仍然串行输出，函数之间互不依赖，每个函数用独立的生成器写到自己的缓冲区
+    Visit(program.values);
+    size_t func_cnt = program.funcs.len;
+    vector<AsmWriter> func_out;
+    func_out.reserve(func_cnt);
+    vector<function<void()>> tasks;
+    for(size_t i = 0; i < func_cnt; i++){
+        func_out.emplace_back(0);
+        koopa_raw_function_t func = (koopa_raw_function_t) program.funcs.buffer[i];
+        AsmWriter *buf = &func_out.back();
+        tasks.push_back([this, func, buf](){
+            AsmGenerator gen(*buf, profile);
+            gen.Visit(func);
+        });
+    }
+    WorkStealingPool pool(jobs);
+    pool.Run(tasks);
+    //按源程序中的顺序拼接，输出与串行时完全相同
+    for(const auto &buf : func_out){
+        out.Append(buf);
+    }
+}
+
+
+//访存指令：偏移超出 12 位立即数范围时借助 t2 计算地址
+void AsmGenerator::EmitMemOp(const string &op, const string &reg, int offset, const string &base){
+    if(offset >= -2048 && offset <= 2047){
+        Emit(op, {reg, to_string(offset) + "(" + base + ")"});
+    }else{
+        Emit("li", {"t2", to_string(offset)});
+        Emit("add", {"t2", base, "t2"});
+        Emit(op, {reg, "0(t2)"});
+    }
+}
+
+void AsmGenerator::EmitAddSp(int delta){
+    if(delta >= -2048 && delta <= 2047){
+        Emit("addi", {"sp", "sp", to_string(delta)});
+    }else{
+        Emit("li", {"t2", to_string(delta)});
+        Emit("add", {"sp", "sp", "t2"});
+    }
+}
+
+//返回保存着 val 的寄存器名；常量和被溢出的值先装入 scratch
+string AsmGenerator::GetValueReg(koopa_raw_value_t val, const string &scratch, int sp_offset){
     if(val->kind.tag == KOOPA_RVT_INTEGER){
-       cout << "\tli " << reg << ", " << val->kind.data.integer.value << endl;
-    }else {
-        //此时是从栈上来的值
-        assert(stack_map.find(val) != stack_map.end() && "访问了未分配的值");
-       int offset = stack_map[val] + sp_offset;
-        cout << "\tlw " << reg << ", " << offset << "(sp)" << endl;
+        if(val->kind.data.integer.value == 0){
+            return "x0";
+        }
+        Emit("li", {scratch, to_string(val->kind.data.integer.value)});
+        return scratch;
+    }
+    if(val->kind.tag == KOOPA_RVT_ALLOC || val->kind.tag == KOOPA_RVT_GLOBAL_ALLOC){
+        return GetAddressReg(val, scratch, sp_offset);
+    }
+    const ValueLoc &loc = reg_alloc.GetLoc(val);
+    if(loc.InReg()){
+        return RegAllocator::RegName(loc.reg);
+    }
+    //此时是从栈上来的值
+    assert(stack_map.find(val) != stack_map.end() && "访问了未分配的值");
+    EmitMemOp("lw", scratch, stack_map[val] + sp_offset, "sp");
+    return scratch;
+}
+
+void AsmGenerator::load_value(koopa_raw_value_t val,const string&reg,int sp_offset){
+    string src = GetValueReg(val, reg, sp_offset);
+    if(src != reg){
+        Emit("mv", {reg, src});
+    }
+}
+
+//指令结果要写入的寄存器：被溢出的值先算到 t0，再由 WriteBack 存回栈上
+string AsmGenerator::GetDstReg(koopa_raw_value_t val){
+    const ValueLoc &loc = reg_alloc.GetLoc(val);
+    return loc.InReg() ? RegAllocator::RegName(loc.reg) : "t0";
+}
+
+void AsmGenerator::WriteBack(koopa_raw_value_t val, const string &reg){
+    if(!reg_alloc.GetLoc(val).InReg()){
+        EmitMemOp("sw", reg, stack_map[val], "sp");
+    }
+}
+
+//取得指针所指向的地址
+string AsmGenerator::GetAddressReg(koopa_raw_value_t ptr, const string &scratch, int sp_offset){
+    if(ptr->kind.tag == KOOPA_RVT_GLOBAL_ALLOC){
+        Emit("la", {scratch, ptr->name + 1});
+        return scratch;
+    }
+    if(ptr->kind.tag == KOOPA_RVT_ALLOC){
+        int offset = stack_map[ptr] + sp_offset;
+        if(offset >= -2048 && offset <= 2047){
+            Emit("addi", {scratch, "sp", to_string(offset)});
+        }else{
+            Emit("li", {scratch, to_string(offset)});
+            Emit("add", {scratch, "sp", scratch});
+        }
+        return scratch;
     }
+    return GetValueReg(ptr, scratch, sp_offset);
 }
 
 
 string AsmGenerator::GetBasicBlockLabel(koopa_raw_basic_block_t bb) {
     if (!bb || !bb->name) {
         // 万一遇到没有名字的匿名基本块，生成一个唯一编号
-        static int anon_count = 0;
-        return ".L_" + current_func_name + "_anon_" + std::to_string(anon_count++);
+        return ".L_" + current_func_name + "_anon_" + std::to_string(anon_label_cnt++);
     }
-    
+
     std::string name = bb->name;
     if (!name.empty() && name[0] == '%') {
         name = name.substr(1);  // 去掉 '%'
     }
-    
+
     // 拼接成局部标签： .L_函数名_块名
     return ".L_" + current_func_name + "_" + name;
 }
@@ -52,10 +171,9 @@ bool AsmGenerator::HasCallINFunc(const koopa_raw_function_t &func){
     return false;
 }
 int AsmGenerator::AllocStackSpace(int size){
-    
+
     int offset = current_stack_offset;
     current_stack_offset += size;
-    //cout << "alloc " << current_stack_offset << endl;
     return offset;
 }
 
@@ -88,85 +206,69 @@ void AsmGenerator::Visit(const koopa_raw_function_t & func){
     if(func->bbs.len == 0) return;
     string name = func->name + 1;
     current_func_name = name;
-    cout << "\t.text" << endl;
-    cout << "\t.globl " << name << endl;
-    cout << name << ":" << endl;
+    edge_label_cnt = 0;
+    anon_label_cnt = 0;
+    out << "\t.text" << '\n';
+    out << "\t.globl " << name << '\n';
+    out << name << ":" << '\n';
+
 
+    body.clear();
 
-    //栈分配空间
+    //先做寄存器分配，再为栈上的对象分配空间
+    vector<double> block_freq;
+    if(profile) block_freq = profile->FunctionCounts(func);
+    reg_alloc.Allocate(func, block_freq.empty() ? nullptr : &block_freq);
     stack_map.clear();
+    saved_regs.clear();
     current_stack_offset = 0;//此时的current_stack offset 是为了之后的栈对齐
-    use_fp = false;
-    fp_offset = 0;
 
 
     cur_func_need_save_ra = HasCallINFunc(func);
     cur_func_ra_offset = -1;
 
-
-    bool need_fp = (func->params.len > 8); 
-
     //预留此时的ra位置
     if (cur_func_need_save_ra) {
         cur_func_ra_offset = AllocStackSpace(4);
     }
 
-    //如果此时需要栈帧的预留s0的位置
-    if(need_fp){
-        use_fp = true;
-        fp_offset = AllocStackSpace(4);
+    //用到的 callee-saved 寄存器
+    for(int reg : reg_alloc.GetUsedCalleeSaved()){
+        saved_regs.push_back({reg, AllocStackSpace(4)});
     }
-    //为此时的参数分配空间
-    for(size_t i = 0; i < func->params.len; i++){
-        koopa_raw_value_t param = (koopa_raw_value_t) func->params.buffer[i];
-        stack_map[param] = AllocStackSpace(4);
-    }
-
-
 
+    //alloc 出来的局部变量 / 数组
     for(size_t i = 0; i < func->bbs.len; i++){
         koopa_raw_basic_block_t bb = (koopa_raw_basic_block_t) func->bbs.buffer[i];
         for(size_t j = 0; j < bb->insts.len ;j++){
             koopa_raw_value_t insts = (koopa_raw_value_t) bb->insts.buffer[j];
-            if(insts->ty->tag != KOOPA_RTT_UNIT){
-                stack_map[insts] = AllocStackSpace(4);
+            if(insts->kind.tag == KOOPA_RVT_ALLOC){
+                stack_map[insts] = AllocStackSpace(GetTypeSize(insts->ty->data.pointer.base));
             }
         }
     }
+
+    //寄存器不够时被溢出的值
+    for(koopa_raw_value_t val : reg_alloc.GetSpilled()){
+        stack_map[val] = AllocStackSpace(4);
+    }
     //计算对其的栈指针
 
     current_stack_frame_size = ((current_stack_offset + 15) / 16) * 16;
     if(current_stack_frame_size > 0){
         //分配栈空间
-        cout << "\taddi sp, sp, -" << current_stack_frame_size << endl;
+        EmitAddSp(-current_stack_frame_size);
     }
 
     if (cur_func_need_save_ra) {
-        cout << "\tsw ra, " << cur_func_ra_offset << "(sp)" << endl;
+        EmitMemOp("sw", "ra", cur_func_ra_offset, "sp");
     }
 
-
-    if(use_fp){
-        cout << "\tsw s0, " << fp_offset << "(sp)" << endl;
-        cout << "\taddi s0, sp, " << current_stack_frame_size << endl;
+    for(auto &saved : saved_regs){
+        EmitMemOp("sw", RegAllocator::RegName(saved.first), saved.second, "sp");
     }
 
-    size_t reg_param_count = (func->params.len > 8) ? 8 : func->params.len;
-
-
-    for (size_t i = 0; i < reg_param_count; i++) {
-        int offset = stack_map[(koopa_raw_value_t)func->params.buffer[i]];
-        cout << "\tsw a" << i << ", " << offset << "(sp)" << endl;
-    }
-    
-    // 第9个及以后：从Caller的栈加载，保存到自己的栈
-    for (size_t i = 8; i < func->params.len; i++) {
-        int my_offset = stack_map[(koopa_raw_value_t)func->params.buffer[i]];
-        int caller_offset = (i - 8) * 4;  // 在Caller栈中的位置：0, 4, 8, ...
-        
-        cout << "\tlw t0, " << caller_offset << "(s0)" << endl;
-        cout << "\tsw t0, " << my_offset << "(sp)" << endl;
-    }
+    SaveParamToStack(func);
 
     //栈空间分配完毕开始执行block解析
     for(size_t i = 0; i < func->bbs.len; i++){
@@ -175,6 +277,51 @@ void AsmGenerator::Visit(const koopa_raw_function_t & func){
         Visit(bb);
     }
 
+    PeepholePass().Run(body);
+    WriteInsts(out, body);
+}
+
+//把参数从 a0~a7 / 调用者的栈上搬到分配好的位置
+void AsmGenerator::SaveParamToStack(const koopa_raw_function_t &func){
+    for (size_t i = 0; i < func->params.len; i++) {
+        koopa_raw_value_t param = (koopa_raw_value_t)func->params.buffer[i];
+        const ValueLoc &loc = reg_alloc.GetLoc(param);
+        if (i < 8) {
+            string arg_reg = "a" + to_string(i);
+            if (loc.InReg()) {
+                //留在原来的 a 寄存器里时不需要搬运
+                if (RegAllocator::RegName(loc.reg) != arg_reg) {
+                    Emit("mv", {RegAllocator::RegName(loc.reg), arg_reg});
+                }
+            } else {
+                EmitMemOp("sw", arg_reg, stack_map[param], "sp");
+            }
+        } else {
+            // 第9个及以后：在Caller栈中的位置紧挨着我们的栈帧
+            int caller_offset = current_stack_frame_size + (i - 8) * 4;
+            string dst = GetDstReg(param);
+            EmitMemOp("lw", dst, caller_offset, "sp");
+            WriteBack(param, dst);
+        }
+    }
+}
+
+void AsmGenerator::EmitEpilogue(){
+    for(auto &saved : saved_regs){
+        EmitMemOp("lw", RegAllocator::RegName(saved.first), saved.second, "sp");
+    }
+
+    if(cur_func_need_save_ra){
+        EmitMemOp("lw", "ra", cur_func_ra_offset, "sp");
+    }
+
+    // 恢复栈指针 (与函数开头的分配对称)
+    if (current_stack_frame_size > 0) {
+        EmitAddSp(current_stack_frame_size);
+    }
+
+    // 生成 ret 指令
+    Emit("ret");
 }
 
 
@@ -182,7 +329,7 @@ void AsmGenerator::Visit(const koopa_raw_function_t & func){
 void AsmGenerator::Visit(const koopa_raw_basic_block_t &bb){
     string label = GetBasicBlockLabel(bb);
     if (!label.empty()) {
-        cout << label << ":" << endl;
+        EmitLabel(label);
     }
     for(size_t i = 0; i < bb->insts.len ;i++){
         assert(bb->insts.kind == KOOPA_RSIK_VALUE);
@@ -199,7 +346,6 @@ void AsmGenerator::Visit(const koopa_raw_value_t &val){
     //这里只是简单打印一下指令的tag，实际使用中可以根据tag来区分不同类型的指令进行处理
     switch(kind.tag){
         case KOOPA_RVT_INTEGER:
-            //Visit(kind.data.integer);
             break;
         case KOOPA_RVT_RETURN:
             Visit(kind.data.ret);
@@ -213,6 +359,12 @@ void AsmGenerator::Visit(const koopa_raw_value_t &val){
         case KOOPA_RVT_STORE:
             Visit(val, kind.data.store);
             break;
+        case KOOPA_RVT_GET_ELEM_PTR:
+            Visit(val, kind.data.get_elem_ptr);
+            break;
+        case KOOPA_RVT_GET_PTR:
+            Visit(val, kind.data.get_ptr);
+            break;
 
         case KOOPA_RVT_ALLOC:
             break;
@@ -234,179 +386,362 @@ void AsmGenerator::Visit(const koopa_raw_value_t &val){
 }
 
 
-/*
-void Visit(const koopa_raw_integer_t &integer){
-     cout << "\tli a0, " << integer.value << endl;
-}
-*/
-
-
-
 void AsmGenerator::Visit(const koopa_raw_return_t &ret){
     // 返回值需要被放入 a0 寄存器
     if(ret.value != nullptr){
         load_value(ret.value, "a0",0);
     }
-    
-    if(cur_func_need_save_ra){
-        cout << "\tlw ra, " << cur_func_ra_offset << "(sp)" << endl; 
-    }
+    EmitEpilogue();
+}
 
-    // 恢复栈指针 (与函数开头的分配对称)
-    if (current_stack_frame_size > 0) {
-        cout << "\taddi sp, sp, " << current_stack_frame_size << endl;
-    }
-    
-    // 生成 ret 指令
-    cout << "\tret" << endl;
+//有符号除以常数 d（|d| >= 2）的魔数：n / d = (mulh(n, magic) [+/- n]) >> shift，再对负数商加 1
+//算法见 Hacker's Delight 10-1
+static void DivMagic(int32_t d, int32_t &magic, int &shift){
+    const uint32_t two31 = 0x80000000u;
+    uint32_t ad = d < 0 ? -(uint32_t)d : d;
+    uint32_t t = two31 + ((uint32_t)d >> 31);
+    uint32_t anc = t - 1 - t % ad;
+    int p = 31;
+    uint32_t q1 = two31 / anc, r1 = two31 - q1 * anc;
+    uint32_t q2 = two31 / ad, r2 = two31 - q2 * ad;
+    uint32_t delta;
+    do{
+        p++;
+        q1 *= 2; r1 *= 2;
+        if(r1 >= anc){ q1++; r1 -= anc; }
+        q2 *= 2; r2 *= 2;
+        if(r2 >= ad){ q2++; r2 -= ad; }
+        delta = ad - r2;
+    }while(q1 < delta || (q1 == delta && r1 == 0));
+    magic = (int32_t)(q2 + 1);
+    if(d < 0) magic = -magic;
+    shift = p - 32;
+}
+
+//除以常数时用 mulh 代替 div，商写到 dst；中间结果只用 t1/t2，lhs 在写 dst 之前不会被改写
+void AsmGenerator::EmitConstDiv(const string &dst, const string &lhs, int32_t d){
+    int32_t magic;
+    int shift;
+    DivMagic(d, magic, shift);
+    Emit("li", {"t1", to_string(magic)});
+    Emit("mulh", {"t1", lhs, "t1"});
+    if(d > 0 && magic < 0) Emit("add", {"t1", "t1", lhs});
+    if(d < 0 && magic > 0) Emit("sub", {"t1", "t1", lhs});
+    if(shift > 0) Emit("srai", {"t1", "t1", to_string(shift)});
+    Emit("srli", {"t2", "t1", "31"});
+    Emit("add", {dst, "t1", "t2"});
 }
 
 void AsmGenerator::Visit(const koopa_raw_value_t &val, const koopa_raw_binary_t &binary){
-    //先加载到我的寄存器中
-    load_value(binary.lhs, "t0",0);
-    load_value(binary.rhs, "t1",0);
+    //操作数已经在寄存器里的直接使用，常量和溢出的值装入 t0/t1
+    string lhs = GetValueReg(binary.lhs, "t0");
+    bool is_div = binary.op == KOOPA_RBO_DIV || binary.op == KOOPA_RBO_MOD;
+    if(is_div && binary.rhs->kind.tag == KOOPA_RVT_INTEGER){
+        int32_t d = binary.rhs->kind.data.integer.value;
+        if(d != 0 && d != 1 && d != -1){
+            string dst = GetDstReg(val);
+            if(binary.op == KOOPA_RBO_DIV){
+                EmitConstDiv(dst, lhs, d);
+            }else{
+                //n % d = n - n / d * d
+                EmitConstDiv("t1", lhs, d);
+                Emit("li", {"t2", to_string(d)});
+                Emit("mul", {"t1", "t1", "t2"});
+                Emit("sub", {dst, lhs, "t1"});
+            }
+            WriteBack(val, dst);
+            return;
+        }
+    }
+    string rhs = GetValueReg(binary.rhs, "t1");
+    string dst = GetDstReg(val);
 
     //根据不同的操作符来生成不同的指令
     switch(binary.op){
   // 算术运算
-        case KOOPA_RBO_ADD: cout << "\tadd t0, t0, t1" << endl; break;
-        case KOOPA_RBO_SUB: cout << "\tsub t0, t0, t1" << endl; break;
-        case KOOPA_RBO_MUL: cout << "\tmul t0, t0, t1" << endl; break;
-        case KOOPA_RBO_DIV: cout << "\tdiv t0, t0, t1" << endl; break;
-        case KOOPA_RBO_MOD: cout << "\trem t0, t0, t1" << endl; break;
-        
+        case KOOPA_RBO_ADD: Emit("add", {dst, lhs, rhs}); break;
+        case KOOPA_RBO_SUB: Emit("sub", {dst, lhs, rhs}); break;
+        case KOOPA_RBO_MUL: Emit("mul", {dst, lhs, rhs}); break;
+        case KOOPA_RBO_DIV: Emit("div", {dst, lhs, rhs}); break;
+        case KOOPA_RBO_MOD: Emit("rem", {dst, lhs, rhs}); break;
+
         // 逻辑/位运算
-        case KOOPA_RBO_AND: cout << "\tand t0, t0, t1" << endl; break;
-        case KOOPA_RBO_OR:  cout << "\tor t0, t0, t1" << endl; break;
-        case KOOPA_RBO_XOR: cout << "\txor t0, t0, t1" << endl; break;
-        case KOOPA_RBO_SHL: cout << "\tsll t0, t0, t1" << endl; break;
-        case KOOPA_RBO_SHR: cout << "\tsrl t0, t0, t1" << endl; break;
-        case KOOPA_RBO_SAR: cout << "\tsra t0, t0, t1" << endl; break;
+        case KOOPA_RBO_AND: Emit("and", {dst, lhs, rhs}); break;
+        case KOOPA_RBO_OR:  Emit("or", {dst, lhs, rhs}); break;
+        case KOOPA_RBO_XOR: Emit("xor", {dst, lhs, rhs}); break;
+        case KOOPA_RBO_SHL: Emit("sll", {dst, lhs, rhs}); break;
+        case KOOPA_RBO_SHR: Emit("srl", {dst, lhs, rhs}); break;
+        case KOOPA_RBO_SAR: Emit("sra", {dst, lhs, rhs}); break;
 
         // 比较运算 (RISC-V 没有直接的 <=, >= 等，需要组合指令)
-        case KOOPA_RBO_EQ: 
-            cout << "\txor t0, t0, t1" << endl;
-            cout << "\tseqz t0, t0" << endl; 
+        case KOOPA_RBO_EQ:
+            Emit("xor", {dst, lhs, rhs});
+            Emit("seqz", {dst, dst});
             break;
-        case KOOPA_RBO_NOT_EQ: 
-            cout << "\txor t0, t0, t1" << endl;
-            cout << "\tsnez t0, t0" << endl; 
+        case KOOPA_RBO_NOT_EQ:
+            Emit("xor", {dst, lhs, rhs});
+            Emit("snez", {dst, dst});
             break;
-        case KOOPA_RBO_LT: cout << "\tslt t0, t0, t1" << endl; break;
-        case KOOPA_RBO_GT: cout << "\tsgt t0, t0, t1" << endl; break;
+        case KOOPA_RBO_LT: Emit("slt", {dst, lhs, rhs}); break;
+        case KOOPA_RBO_GT: Emit("sgt", {dst, lhs, rhs}); break;
         case KOOPA_RBO_LE: // <= 等价于 !(> )
-            cout << "\tsgt t0, t0, t1" << endl;
-            cout << "\txori t0, t0, 1" << endl; 
+            Emit("sgt", {dst, lhs, rhs});
+            Emit("xori", {dst, dst, "1"});
             break;
         case KOOPA_RBO_GE: // >= 等价于 !(< )
-            cout << "\tslt t0, t0, t1" << endl;
-            cout << "\txori t0, t0, 1" << endl; 
+            Emit("slt", {dst, lhs, rhs});
+            Emit("xori", {dst, dst, "1"});
             break;
         default:
             assert(false && "未实现的二元操作");
     }
-    //把t0中的结果保存到对应的栈中
-    int offset = stack_map[val];
-    cout << "\tsw t0, " << offset << "(sp)" << endl;
+    //结果被溢出时存回栈上
+    WriteBack(val, dst);
 }
 
 
 void AsmGenerator::Visit(const koopa_raw_value_t &val, const koopa_raw_load_t &load){
-   if (load.src->kind.tag == KOOPA_RVT_GLOBAL_ALLOC) {
-        string name = load.src->name + 1; // 去掉 '@'
-        cout << "\tla t0, " << name << endl;  // 将全局变量的绝对地址加载到 t0
-        cout << "\tlw t0, 0(t0)" << endl;     // 从该地址读取数据存入 t0
+    string dst = GetDstReg(val);
+    if (load.src->kind.tag == KOOPA_RVT_ALLOC) {
+        // 栈上的局部变量
+        EmitMemOp("lw", dst, stack_map[load.src], "sp");
     } else {
-        // 否则就是栈上的局部变量，走原来的逻辑
-        int offset = stack_map[load.src];
-        cout << "\tlw t0, " << offset << "(sp)" << endl;
+        // 全局变量或者 getelemptr 算出来的指针
+        string addr = GetAddressReg(load.src, "t0");
+        Emit("lw", {dst, "0(" + addr + ")"});
     }
-    
-    // 把读取到的值保存到当前 %0, %1 对应的栈空间中
-    int val_offset = stack_map[val];
-    cout << "\tsw t0, " << val_offset << "(sp)" << endl;
+    WriteBack(val, dst);
 }
 
 void AsmGenerator::Visit(const koopa_raw_value_t &val, const koopa_raw_store_t &store){
-    load_value(store.value, "t0",0);
-    
-    // 判断目的地是不是全局变量
-    if (store.dest->kind.tag == KOOPA_RVT_GLOBAL_ALLOC) {
-        string name = store.dest->name + 1; // 去掉 '@'
-        cout << "\tla t1, " << name << endl;  // 把全局变量的地址加载到 t1 寄存器
-        cout << "\tsw t0, 0(t1)" << endl;     // 将 t0 的值存入 t1 指向的内存
-    } else {
+    string value = GetValueReg(store.value, "t0");
+
+    if (store.dest->kind.tag == KOOPA_RVT_ALLOC) {
         // 局部变量，存入对应的栈偏移
-        int offset = stack_map[store.dest];
-        cout << "\tsw t0, " << offset << "(sp)" << endl;
+        EmitMemOp("sw", value, stack_map[store.dest], "sp");
+    } else {
+        string addr = GetAddressReg(store.dest, "t1");
+        Emit("sw", {value, "0(" + addr + ")"});
     }
 }
 
+//dst = src + index * elem_size
+void AsmGenerator::EmitPtrOffset(koopa_raw_value_t val, koopa_raw_value_t src, koopa_raw_value_t index, int elem_size){
+    string base = GetAddressReg(src, "t0");
+    string dst = GetDstReg(val);
+    if(index->kind.tag == KOOPA_RVT_INTEGER){
+        int offset = index->kind.data.integer.value * elem_size;
+        if(offset == 0){
+            if(dst != base) Emit("mv", {dst, base});
+        }else if(offset >= -2048 && offset <= 2047){
+            Emit("addi", {dst, base, to_string(offset)});
+        }else{
+            Emit("li", {"t1", to_string(offset)});
+            Emit("add", {dst, base, "t1"});
+        }
+    }else{
+        string idx = GetValueReg(index, "t1");
+        if((elem_size & (elem_size - 1)) == 0){
+            int shift = 0;
+            while((1 << shift) < elem_size) shift++;
+            Emit("slli", {"t1", idx, to_string(shift)});
+        }else{
+            Emit("li", {"t2", to_string(elem_size)});
+            Emit("mul", {"t1", idx, "t2"});
+        }
+        Emit("add", {dst, base, "t1"});
+    }
+    WriteBack(val, dst);
+}
+
+void AsmGenerator::Visit(const koopa_raw_value_t &val, const koopa_raw_get_elem_ptr_t &get_elem_ptr){
+    koopa_raw_type_t array_ty = get_elem_ptr.src->ty->data.pointer.base;
+    EmitPtrOffset(val, get_elem_ptr.src, get_elem_ptr.index, GetTypeSize(array_ty->data.array.base));
+}
+
+void AsmGenerator::Visit(const koopa_raw_value_t &val, const koopa_raw_get_ptr_t &get_ptr){
+    EmitPtrOffset(val, get_ptr.src, get_ptr.index, GetTypeSize(get_ptr.src->ty->data.pointer.base));
+}
+
  void AsmGenerator::Visit(const koopa_raw_value_t &val, const koopa_raw_branch_t& branch){
-    load_value(branch.cond, "t0",0 );
+    string cond = GetValueReg(branch.cond, "t0");
     string true_label = GetBasicBlockLabel(branch.true_bb);
     string false_label = GetBasicBlockLabel(branch.false_bb);
-    cout << "\tbnez t0, " << true_label << endl;
-    cout << "\tj " << false_label << endl;
+    bool true_args = branch.true_args.len > 0;
+    bool false_args = branch.false_args.len > 0;
+    if(!true_args && !false_args){
+        Emit("bnez", {cond, true_label});
+        Emit("j", {false_label});
+    }else if(!false_args){
+        //块参数的赋值要放在对应的边上
+        Emit("beqz", {cond, false_label});
+        EmitBlockArgs(branch.true_bb, branch.true_args);
+        Emit("j", {true_label});
+    }else if(!true_args){
+        Emit("bnez", {cond, true_label});
+        EmitBlockArgs(branch.false_bb, branch.false_args);
+        Emit("j", {false_label});
+    }else{
+        string edge_label = ".L_" + current_func_name + "_edge_" + to_string(edge_label_cnt++);
+        Emit("beqz", {cond, edge_label});
+        EmitBlockArgs(branch.true_bb, branch.true_args);
+        Emit("j", {true_label});
+        EmitLabel(edge_label);
+        EmitBlockArgs(branch.false_bb, branch.false_args);
+        Emit("j", {false_label});
+    }
  }
 
  void AsmGenerator::Visit(const koopa_raw_value_t &val, const koopa_raw_jump_t& jump){
-    //cout << "test"<< endl;
+    EmitBlockArgs(jump.target, jump.args);
     string target_label = GetBasicBlockLabel(jump.target);
-    cout << "\tj " << target_label << std::endl;
+    Emit("j", {target_label});
  }
 
+//把实参并行地赋给目标块的参数：先做目标不再被读的赋值，遇到环时借 t1 打破
+void AsmGenerator::EmitBlockArgs(koopa_raw_basic_block_t target, const koopa_raw_slice_t &args){
+    //位置：寄存器、栈槽或者立即数
+    struct Loc {
+        int reg = -1;
+        int slot = -1;
+        koopa_raw_value_t imm = nullptr;
+        bool operator==(const Loc &o) const {
+            return !imm && !o.imm && reg == o.reg && slot == o.slot;
+        }
+    };
+    auto loc_of = [&](koopa_raw_value_t v){
+        Loc loc;
+        if(v->kind.tag == KOOPA_RVT_INTEGER){
+            loc.imm = v;
+        }else if(reg_alloc.GetLoc(v).InReg()){
+            loc.reg = reg_alloc.GetLoc(v).reg;
+        }else{
+            loc.slot = stack_map[v];
+        }
+        return loc;
+    };
+    auto emit_move = [&](const Loc &dst, const Loc &src){
+        string src_reg;
+        if(src.imm){
+            src_reg = GetValueReg(src.imm, dst.reg >= 0 ? RegAllocator::RegName(dst.reg) : "t0");
+        }else if(src.reg >= 0){
+            src_reg = RegAllocator::RegName(src.reg);
+        }else{
+            src_reg = dst.reg >= 0 ? RegAllocator::RegName(dst.reg) : "t0";
+            EmitMemOp("lw", src_reg, src.slot, "sp");
+        }
+        if(dst.reg >= 0){
+            string dst_reg = RegAllocator::RegName(dst.reg);
+            if(dst_reg != src_reg) Emit("mv", {dst_reg, src_reg});
+        }else{
+            EmitMemOp("sw", src_reg, dst.slot, "sp");
+        }
+    };
+
+    vector<pair<Loc, Loc>> moves;
+    for(size_t i = 0; i < args.len; i++){
+        Loc dst = loc_of((koopa_raw_value_t) target->params.buffer[i]);
+        Loc src = loc_of((koopa_raw_value_t) args.buffer[i]);
+        if(!(dst == src)) moves.push_back({dst, src});
+    }
+    while(!moves.empty()){
+        bool progress = false;
+        for(size_t i = 0; i < moves.size(); i++){
+            bool blocked = false;
+            for(size_t j = 0; j < moves.size(); j++){
+                if(j != i && moves[j].second == moves[i].first){
+                    blocked = true;
+                    break;
+                }
+            }
+            if(!blocked){
+                emit_move(moves[i].first, moves[i].second);
+                moves.erase(moves.begin() + i);
+                progress = true;
+                break;
+            }
+        }
+        if(!progress){
+            //所有赋值成环：把第一个目标的旧值暂存到 t1
+            Loc tmp;
+            tmp.reg = 6;
+            Loc blocked = moves[0].first;
+            emit_move(tmp, blocked);
+            for(auto &m : moves){
+                if(m.second == blocked) m.second = tmp;
+            }
+        }
+    }
+}
+
  void AsmGenerator::Visit(const koopa_raw_value_t &val, const koopa_raw_call_t& call){
     int stack_arg_count = (call.args.len > 8) ? (call.args.len - 8) : 0;
-    int spill_space = stack_arg_count * 4;
-    
+    int spill_space = ((stack_arg_count * 4 + 15) / 16) * 16;
+
     // 临时分配栈空间给溢出参数
     if (spill_space > 0) {
-        cout << "\taddi sp, sp, -" << spill_space << endl;
+        EmitAddSp(-spill_space);
     }
-    
+
+    // 第9个及以后：存到Caller的栈（临时空间）
+    for (size_t i = 8; i < call.args.len; i++) {
+        koopa_raw_value_t arg = (koopa_raw_value_t)call.args.buffer[i];
+        string reg = GetValueReg(arg, "t0", spill_space);
+        EmitMemOp("sw", reg, (i - 8) * 4, "sp");
+    }
+
     // 前8个参数：加载到寄存器 a0-a7
     for (size_t i = 0; i < call.args.len && i < 8; i++) {
         koopa_raw_value_t arg = (koopa_raw_value_t)call.args.buffer[i];
         load_value(arg, "a" + to_string(i),spill_space);
     }
-    
-    // 第9个及以后：存到Caller的栈（临时空间）
-    for (size_t i = 8; i < call.args.len; i++) {
-        koopa_raw_value_t arg = (koopa_raw_value_t)call.args.buffer[i];
-        load_value(arg, "t0", spill_space);
-        cout << "\tsw t0, " << (i - 8) * 4 << "(sp)" << endl;
-    }
-    
+
     // 调用
     string callee_name = call.callee->name + 1;
-    cout << "\tcall " << callee_name << endl;
-    
+    Emit("call", {callee_name});
+
     // 恢复栈
     if (spill_space > 0) {
-        cout << "\taddi sp, sp, " << spill_space << endl;
+        EmitAddSp(spill_space);
     }
-    
+
     // 保存返回值
     if (val->ty->tag != KOOPA_RTT_UNIT) {
-        int offset = stack_map[val];  // 直接查 map
-        cout << "\tsw a0, " << offset << "(sp)" << endl;
+        const ValueLoc &loc = reg_alloc.GetLoc(val);
+        if (loc.InReg()) {
+            Emit("mv", {RegAllocator::RegName(loc.reg), "a0"});
+        } else {
+            EmitMemOp("sw", "a0", stack_map[val], "sp");
+        }
+    }
+}
+
+//全局变量的初始值，数组按元素逐个展开
+static void EmitGlobalInit(AsmWriter &out, koopa_raw_value_t init, koopa_raw_type_t ty){
+    switch(init->kind.tag){
+        case KOOPA_RVT_INTEGER:
+            out << "\t.word " << init->kind.data.integer.value << '\n';
+            break;
+        case KOOPA_RVT_ZERO_INIT:
+            out << "\t.zero " << GetTypeSize(ty) << '\n';
+            break;
+        case KOOPA_RVT_AGGREGATE: {
+            const auto &elems = init->kind.data.aggregate.elems;
+            for(size_t i = 0; i < elems.len; i++){
+                EmitGlobalInit(out, (koopa_raw_value_t) elems.buffer[i], ty->data.array.base);
+            }
+            break;
+        }
+        default:
+            assert(false && "未知的全局初始值");
     }
 }
 
 void AsmGenerator::Visit(const koopa_raw_value_t &val, const koopa_raw_global_alloc_t& global_alloc){
     //全局变量的分配
     string name = val->name + 1;
-    koopa_raw_value_t init = global_alloc.init;
-    if(init->kind.tag == KOOPA_RVT_INTEGER){
-        cout << "\t.data" << endl;
-        cout << "\t.globl " << name << endl;
-        cout << name << ":" << endl;
-        cout << "\t.word " << init->kind.data.integer.value << endl;
-    }else if(init->kind.tag == KOOPA_RVT_ZERO_INIT){
-        cout << "\t.data" << endl;
-        cout << "\t.globl " << name << endl;
-        cout << name << ":" << endl;
-        cout << "\t.zero 4" << endl; // 假设全局变量占4字节
-    }
-}
\ No newline at end of file
+    out << "\t.data" << '\n';
+    out << "\t.globl " << name << '\n';
+    out << name << ":" << '\n';
+    EmitGlobalInit(out, global_alloc.init, val->ty->data.pointer.base);
+}
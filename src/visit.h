@@ -1,14 +1,23 @@
-#pragma once 
+#pragma once
 #include "koopa.h"
+#include "regalloc.h"
+#include "asmwriter.h"
+#include "peephole.h"
+#include "profile.h"
 #include <string>
 #include <unordered_map>
 using namespace std;
 class AsmGenerator {
 public:
-    AsmGenerator();
-    void Generate(const koopa_raw_program_t &program);
+    //生成的汇编写入 out，由调用者决定何时写到文件；profile 不为空时寄存器分配按实际执行次数选择溢出
+    explicit AsmGenerator(AsmWriter &out, const BlockProfile *profile = nullptr);
+    //jobs > 1 时各个函数在线程池中并行生成，再按原顺序拼接
+    void Generate(const koopa_raw_program_t &program, int jobs = 1);
 private:
+    AsmWriter &out;
+    const BlockProfile *profile;
     string current_func_name;
+    //栈上的对象：alloc 出来的变量以及被溢出的值
     std:: unordered_map<koopa_raw_value_t, int> stack_map;
     int current_stack_frame_size = 0;
     int current_stack_offset = 0;
@@ -16,12 +25,26 @@ private:
     bool cur_func_need_save_ra = false;
     int cur_func_ra_offset = 0;
 
-    bool use_fp = false;
-    int fp_offset = 0;
+    //寄存器分配结果与需要保存的 callee-saved 寄存器
+    RegAllocator reg_alloc;
+    vector<pair<int, int>> saved_regs;
+    int edge_label_cnt = 0;
+    int anon_label_cnt = 0;
+    //当前函数的指令表，窥孔优化后再写进 out
+    vector<AsmInst> body;
 
     bool HasCallINFunc(const koopa_raw_function_t &func);
     int AllocStackSpace(int size);
     void load_value(koopa_raw_value_t val,const std::string&reg,int sp_offset);
+    string GetValueReg(koopa_raw_value_t val, const string &scratch, int sp_offset = 0);
+    string GetDstReg(koopa_raw_value_t val);
+    void WriteBack(koopa_raw_value_t val, const string &reg);
+    string GetAddressReg(koopa_raw_value_t ptr, const string &scratch, int sp_offset = 0);
+    void Emit(const string &op, vector<string> args = {});
+    void EmitLabel(const string &label);
+    void EmitMemOp(const string &op, const string &reg, int offset, const string &base);
+    void EmitAddSp(int delta);
+    void EmitEpilogue();
     string GetBasicBlockLabel(koopa_raw_basic_block_t bb);
 
 
@@ -31,12 +54,17 @@ private:
     void Visit(const koopa_raw_basic_block_t &bb);
     void Visit(const koopa_raw_value_t &val);
     void Visit(const koopa_raw_return_t &ret);
-    void Visit(const koopa_raw_value_t &val, const koopa_raw_binary_t &binary);    
+    void Visit(const koopa_raw_value_t &val, const koopa_raw_binary_t &binary);
     void Visit(const koopa_raw_value_t &val, const koopa_raw_load_t &load);
     void Visit(const koopa_raw_value_t &val, const koopa_raw_store_t &store);
+    void Visit(const koopa_raw_value_t &val, const koopa_raw_get_elem_ptr_t &get_elem_ptr);
+    void Visit(const koopa_raw_value_t &val, const koopa_raw_get_ptr_t &get_ptr);
     void Visit(const koopa_raw_value_t &val, const koopa_raw_branch_t& branch);
     void Visit(const koopa_raw_value_t &val, const koopa_raw_jump_t& jump);
     void Visit(const koopa_raw_value_t &val, const koopa_raw_call_t& call);
     void Visit(const koopa_raw_value_t &val, const koopa_raw_global_alloc_t& global_alloc);
     void SaveParamToStack(const koopa_raw_function_t &func);
+    void EmitBlockArgs(koopa_raw_basic_block_t target, const koopa_raw_slice_t &args);
+    void EmitPtrOffset(koopa_raw_value_t val, koopa_raw_value_t src, koopa_raw_value_t index, int elem_size);
+    void EmitConstDiv(const string &dst, const string &lhs, int32_t d);
 };
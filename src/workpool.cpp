@@ -0,0 +1,62 @@
+#include "workpool.h"
+#include <thread>
+using namespace std;
+
+WorkStealingPool::WorkStealingPool(int num_threads) : num_threads(num_threads < 1 ? 1 : num_threads) {
+    for(int i = 0; i < this->num_threads; i++){
+        queues.push_back(make_unique<WorkQueue>());
+    }
+}
+
+const function<void()> *WorkStealingPool::PopLocal(int id){
+    WorkQueue &q = *queues[id];
+    lock_guard<mutex> guard(q.lock);
+    if(q.tasks.empty()) return nullptr;
+    const function<void()> *task = q.tasks.back();
+    q.tasks.pop_back();
+    return task;
+}
+
+const function<void()> *WorkStealingPool::Steal(int id){
+    for(int i = 1; i < num_threads; i++){
+        WorkQueue &q = *queues[(id + i) % num_threads];
+        lock_guard<mutex> guard(q.lock);
+        if(!q.tasks.empty()){
+            const function<void()> *task = q.tasks.front();
+            q.tasks.pop_front();
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+void WorkStealingPool::Worker(int id){
+    //任务在 Run 开始前就全部分发好了，所以所有队列都空时就可以退出
+    while(true){
+        const function<void()> *task = PopLocal(id);
+        if(!task) task = Steal(id);
+        if(!task) return;
+        (*task)();
+    }
+}
+
+void WorkStealingPool::Run(const vector<function<void()>> &tasks){
+    if(tasks.empty()) return;
+    //按连续的区间分给各个线程，相邻的任务大小往往相近
+    size_t per_thread = (tasks.size() + num_threads - 1) / num_threads;
+    for(size_t i = 0; i < tasks.size(); i++){
+        queues[i / per_thread]->tasks.push_back(&tasks[i]);
+    }
+    if(num_threads == 1){
+        Worker(0);
+        return;
+    }
+    vector<thread> threads;
+    for(int i = 1; i < num_threads; i++){
+        threads.emplace_back(&WorkStealingPool::Worker, this, i);
+    }
+    Worker(0);
+    for(auto &t : threads){
+        t.join();
+    }
+}
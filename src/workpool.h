@@ -0,0 +1,29 @@
+#pragma once
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+using namespace std;
+
+//简单的 work-stealing 线程池：每个工作线程有自己的任务队列，
+//从自己队列的尾部取任务，空了就从其他线程队列的头部偷
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(int num_threads);
+
+    //执行所有任务，全部完成后返回；任务之间不能有依赖
+    void Run(const vector<function<void()>> &tasks);
+
+private:
+    struct WorkQueue {
+        mutex lock;
+        deque<const function<void()> *> tasks;
+    };
+    int num_threads;
+    vector<unique_ptr<WorkQueue>> queues;
+
+    const function<void()> *PopLocal(int id);
+    const function<void()> *Steal(int id);
+    void Worker(int id);
+};
@@ -0,0 +1,581 @@
+// RV32IM 汇编模拟器：直接加载编译器输出的 .s 文件并执行
+// 用法：rvsim [-stats] [-i input] program.s
+// SysY 运行时库（getint/putint/...）在这里用 shim 实现
+// 结束时在 stderr 输出动态指令数、访存次数以及按函数统计的周期估计
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+namespace {
+
+enum Op {
+    ADD, SUB, SLL, SLT, SLTU, XOR, SRL, SRA, OR, AND,
+    MUL, MULH, DIV, DIVU, REM, REMU,
+    ADDI, SLTI, SLTIU, XORI, ORI, ANDI, SLLI, SRLI, SRAI,
+    LW, LB, LBU, SW, SB, LUI,
+    BEQ, BNE, BLT, BGE, BLTU, BGEU,
+    JAL, JALR,
+    LI, LA, CALL_LIB, ECALL,
+};
+
+struct Inst {
+    Op op;
+    int rd = 0, rs1 = 0, rs2 = 0;
+    int32_t imm = 0;
+    string sym;          //分支/跳转目标或 la 的符号，解析完成后换成 imm
+    int line = 0;
+};
+
+//每条指令的周期估计：一个简单的五级流水线
+//基础 1 周期；跳转/跳转成功的分支 +2（冲刷）；load 之后紧跟使用 +1；乘法 +2；除法 +32
+const int kTakenPenalty = 2;
+const int kLoadUsePenalty = 1;
+const int kMulPenalty = 2;
+const int kDivPenalty = 32;
+
+struct FuncStats {
+    uint64_t insts = 0;
+    uint64_t loads = 0;
+    uint64_t stores = 0;
+    uint64_t cycles = 0;
+};
+
+const uint32_t kMemSize = 64 << 20;
+const uint32_t kDataBase = 0x10000;
+
+class Simulator {
+public:
+    bool Load(const string &path);
+    int Run();
+    void SetInput(FILE *in) { input = in; }
+    void PrintStats(ostream &os) const;
+
+private:
+    vector<Inst> text;
+    vector<int> func_of;            //每条指令属于哪个函数
+    vector<string> func_names;
+    unordered_map<string, int> text_labels;
+    unordered_map<string, uint32_t> data_labels;
+    vector<uint8_t> mem = vector<uint8_t>(kMemSize);
+    uint32_t data_end = kDataBase;
+    int32_t regs[32] = {0};
+    FILE *input = stdin;
+    vector<FuncStats> stats;
+    uint64_t total_insts = 0;
+    int cur_line = 0;
+
+    [[noreturn]] void Fail(const string &msg) const {
+        cerr << "rvsim: line " << cur_line << ": " << msg << endl;
+        exit(2);
+    }
+    int ParseReg(const string &s) const;
+    int32_t ParseImm(const string &s) const;
+    void ParseMem(const string &s, int32_t &off, int &base) const;
+    void ParseInst(const string &mnemonic, const vector<string> &ops);
+    uint32_t CheckAddr(uint32_t addr, int size) const;
+    int32_t LoadWord(uint32_t addr) const;
+    void StoreWord(uint32_t addr, int32_t v);
+    int32_t ReadInt();
+    void CallLib(const string &name);
+};
+
+string Trim(const string &s) {
+    size_t b = s.find_first_not_of(" \t\r");
+    if (b == string::npos) return "";
+    size_t e = s.find_last_not_of(" \t\r");
+    return s.substr(b, e - b + 1);
+}
+
+vector<string> SplitOperands(const string &s) {
+    vector<string> res;
+    string cur;
+    for (char c : s) {
+        if (c == ',') {
+            res.push_back(Trim(cur));
+            cur.clear();
+        } else {
+            cur += c;
+        }
+    }
+    if (!Trim(cur).empty()) res.push_back(Trim(cur));
+    return res;
+}
+
+int Simulator::ParseReg(const string &s) const {
+    static const unordered_map<string, int> abi = {
+        {"zero", 0}, {"ra", 1}, {"sp", 2}, {"gp", 3}, {"tp", 4},
+        {"t0", 5}, {"t1", 6}, {"t2", 7}, {"s0", 8}, {"fp", 8}, {"s1", 9},
+        {"a0", 10}, {"a1", 11}, {"a2", 12}, {"a3", 13}, {"a4", 14}, {"a5", 15}, {"a6", 16}, {"a7", 17},
+        {"s2", 18}, {"s3", 19}, {"s4", 20}, {"s5", 21}, {"s6", 22}, {"s7", 23}, {"s8", 24}, {"s9", 25},
+        {"s10", 26}, {"s11", 27}, {"t3", 28}, {"t4", 29}, {"t5", 30}, {"t6", 31},
+    };
+    auto it = abi.find(s);
+    if (it != abi.end()) return it->second;
+    if (s.size() > 1 && s[0] == 'x') {
+        int r = atoi(s.c_str() + 1);
+        if (r >= 0 && r < 32) return r;
+    }
+    Fail("bad register '" + s + "'");
+}
+
+int32_t Simulator::ParseImm(const string &s) const {
+    char *end = nullptr;
+    long long v = strtoll(s.c_str(), &end, 0);
+    if (s.empty() || *end != '\0') Fail("bad immediate '" + s + "'");
+    return (int32_t)v;
+}
+
+void Simulator::ParseMem(const string &s, int32_t &off, int &base) const {
+    size_t l = s.find('('), r = s.find(')');
+    if (l == string::npos || r == string::npos) Fail("bad memory operand '" + s + "'");
+    string off_str = Trim(s.substr(0, l));
+    off = off_str.empty() ? 0 : ParseImm(off_str);
+    base = ParseReg(Trim(s.substr(l + 1, r - l - 1)));
+}
+
+void Simulator::ParseInst(const string &m, const vector<string> &ops) {
+    static const unordered_map<string, Op> rtype = {
+        {"add", ADD}, {"sub", SUB}, {"sll", SLL}, {"slt", SLT}, {"sltu", SLTU}, {"xor", XOR},
+        {"srl", SRL}, {"sra", SRA}, {"or", OR}, {"and", AND}, {"mul", MUL}, {"mulh", MULH},
+        {"div", DIV}, {"divu", DIVU}, {"rem", REM}, {"remu", REMU},
+    };
+    static const unordered_map<string, Op> itype = {
+        {"addi", ADDI}, {"slti", SLTI}, {"sltiu", SLTIU}, {"xori", XORI}, {"ori", ORI},
+        {"andi", ANDI}, {"slli", SLLI}, {"srli", SRLI}, {"srai", SRAI},
+    };
+    static const unordered_map<string, Op> btype = {
+        {"beq", BEQ}, {"bne", BNE}, {"blt", BLT}, {"bge", BGE}, {"bltu", BLTU}, {"bgeu", BGEU},
+    };
+    auto need = [&](size_t n) {
+        if (ops.size() != n) Fail("'" + m + "' expects " + to_string(n) + " operands");
+    };
+    Inst inst;
+    inst.line = cur_line;
+    if (rtype.count(m)) {
+        need(3);
+        inst.op = rtype.at(m);
+        inst.rd = ParseReg(ops[0]); inst.rs1 = ParseReg(ops[1]); inst.rs2 = ParseReg(ops[2]);
+    } else if (itype.count(m)) {
+        need(3);
+        inst.op = itype.at(m);
+        inst.rd = ParseReg(ops[0]); inst.rs1 = ParseReg(ops[1]); inst.imm = ParseImm(ops[2]);
+    } else if (btype.count(m)) {
+        need(3);
+        inst.op = btype.at(m);
+        inst.rs1 = ParseReg(ops[0]); inst.rs2 = ParseReg(ops[1]); inst.sym = ops[2];
+    } else if (m == "bgt" || m == "ble" || m == "bgtu" || m == "bleu") {
+        //交换操作数的伪指令
+        need(3);
+        inst.op = m == "bgt" ? BLT : m == "ble" ? BGE : m == "bgtu" ? BLTU : BGEU;
+        inst.rs1 = ParseReg(ops[1]); inst.rs2 = ParseReg(ops[0]); inst.sym = ops[2];
+    } else if (m == "beqz" || m == "bnez" || m == "bltz" || m == "bgez") {
+        need(2);
+        inst.op = m == "beqz" ? BEQ : m == "bnez" ? BNE : m == "bltz" ? BLT : BGE;
+        inst.rs1 = ParseReg(ops[0]); inst.rs2 = 0; inst.sym = ops[1];
+    } else if (m == "blez" || m == "bgtz") {
+        need(2);
+        inst.op = m == "blez" ? BGE : BLT;
+        inst.rs1 = 0; inst.rs2 = ParseReg(ops[0]); inst.sym = ops[1];
+    } else if (m == "lw" || m == "lb" || m == "lbu") {
+        need(2);
+        inst.op = m == "lw" ? LW : m == "lb" ? LB : LBU;
+        inst.rd = ParseReg(ops[0]);
+        ParseMem(ops[1], inst.imm, inst.rs1);
+    } else if (m == "sw" || m == "sb") {
+        need(2);
+        inst.op = m == "sw" ? SW : SB;
+        inst.rs2 = ParseReg(ops[0]);
+        ParseMem(ops[1], inst.imm, inst.rs1);
+    } else if (m == "lui") {
+        need(2);
+        inst.op = LUI; inst.rd = ParseReg(ops[0]); inst.imm = ParseImm(ops[1]);
+    } else if (m == "li") {
+        need(2);
+        inst.op = LI; inst.rd = ParseReg(ops[0]); inst.imm = ParseImm(ops[1]);
+    } else if (m == "la") {
+        need(2);
+        inst.op = LA; inst.rd = ParseReg(ops[0]); inst.sym = ops[1];
+    } else if (m == "mv") {
+        need(2);
+        inst.op = ADDI; inst.rd = ParseReg(ops[0]); inst.rs1 = ParseReg(ops[1]);
+    } else if (m == "not") {
+        need(2);
+        inst.op = XORI; inst.rd = ParseReg(ops[0]); inst.rs1 = ParseReg(ops[1]); inst.imm = -1;
+    } else if (m == "neg") {
+        need(2);
+        inst.op = SUB; inst.rd = ParseReg(ops[0]); inst.rs1 = 0; inst.rs2 = ParseReg(ops[1]);
+    } else if (m == "seqz") {
+        need(2);
+        inst.op = SLTIU; inst.rd = ParseReg(ops[0]); inst.rs1 = ParseReg(ops[1]); inst.imm = 1;
+    } else if (m == "snez") {
+        need(2);
+        inst.op = SLTU; inst.rd = ParseReg(ops[0]); inst.rs1 = 0; inst.rs2 = ParseReg(ops[1]);
+    } else if (m == "sltz") {
+        need(2);
+        inst.op = SLT; inst.rd = ParseReg(ops[0]); inst.rs1 = ParseReg(ops[1]); inst.rs2 = 0;
+    } else if (m == "sgtz") {
+        need(2);
+        inst.op = SLT; inst.rd = ParseReg(ops[0]); inst.rs1 = 0; inst.rs2 = ParseReg(ops[1]);
+    } else if (m == "sgt" || m == "sgtu") {
+        need(3);
+        inst.op = m == "sgt" ? SLT : SLTU;
+        inst.rd = ParseReg(ops[0]); inst.rs1 = ParseReg(ops[2]); inst.rs2 = ParseReg(ops[1]);
+    } else if (m == "j") {
+        need(1);
+        inst.op = JAL; inst.rd = 0; inst.sym = ops[0];
+    } else if (m == "jal") {
+        if (ops.size() == 1) {
+            inst.op = JAL; inst.rd = 1; inst.sym = ops[0];
+        } else {
+            need(2);
+            inst.op = JAL; inst.rd = ParseReg(ops[0]); inst.sym = ops[1];
+        }
+    } else if (m == "call" || m == "tail") {
+        need(1);
+        inst.op = JAL; inst.rd = m == "call" ? 1 : 0; inst.sym = ops[0];
+    } else if (m == "jr") {
+        need(1);
+        inst.op = JALR; inst.rd = 0; inst.rs1 = ParseReg(ops[0]);
+    } else if (m == "jalr") {
+        need(1);
+        inst.op = JALR; inst.rd = 1; inst.rs1 = ParseReg(ops[0]);
+    } else if (m == "ret") {
+        need(0);
+        inst.op = JALR; inst.rd = 0; inst.rs1 = 1;
+    } else if (m == "nop") {
+        need(0);
+        inst.op = ADDI;
+    } else if (m == "ecall") {
+        need(0);
+        inst.op = ECALL;
+    } else {
+        Fail("unsupported instruction '" + m + "'");
+    }
+    text.push_back(inst);
+}
+
+bool Simulator::Load(const string &path) {
+    ifstream in(path);
+    if (!in.is_open()) return false;
+    bool in_text = true;
+    string raw;
+    int cur_func = -1;
+    while (getline(in, raw)) {
+        ++cur_line;
+        size_t hash = raw.find('#');
+        if (hash != string::npos) raw = raw.substr(0, hash);
+        string line = Trim(raw);
+        //可能有多个标签写在同一行
+        while (true) {
+            size_t colon = line.find(':');
+            if (colon == string::npos || line.find_first_of(" \t") < colon) break;
+            string label = line.substr(0, colon);
+            if (in_text) {
+                text_labels[label] = text.size();
+                if (label.rfind(".L", 0) != 0) {
+                    cur_func = func_names.size();
+                    func_names.push_back(label);
+                }
+            } else {
+                data_labels[label] = data_end;
+            }
+            line = Trim(line.substr(colon + 1));
+        }
+        if (line.empty()) continue;
+        size_t sp = line.find_first_of(" \t");
+        string mnemonic = sp == string::npos ? line : line.substr(0, sp);
+        string rest = sp == string::npos ? "" : Trim(line.substr(sp));
+        vector<string> ops = SplitOperands(rest);
+        if (mnemonic[0] == '.') {
+            if (mnemonic == ".text") {
+                in_text = true;
+            } else if (mnemonic == ".data" || mnemonic == ".bss" || mnemonic == ".rodata" ||
+                       (mnemonic == ".section" && !ops.empty() && ops[0] != ".text")) {
+                in_text = false;
+            } else if (mnemonic == ".word") {
+                for (const auto &op : ops) {
+                    StoreWord(data_end, ParseImm(op));
+                    data_end += 4;
+                }
+            } else if (mnemonic == ".zero" || mnemonic == ".space") {
+                data_end += ParseImm(ops.at(0));
+            } else if (mnemonic == ".align" || mnemonic == ".p2align") {
+                uint32_t a = 1u << ParseImm(ops.at(0));
+                data_end = (data_end + a - 1) & ~(a - 1);
+            }
+            //.globl 等其余伪指令忽略
+            continue;
+        }
+        if (!in_text) Fail("instruction outside .text");
+        if (cur_func < 0) Fail("instruction before any function label");
+        ParseInst(mnemonic, ops);
+        func_of.push_back(cur_func);
+    }
+    //解析跳转目标
+    for (auto &inst : text) {
+        cur_line = inst.line;
+        if (inst.sym.empty()) continue;
+        if (inst.op == LA) {
+            auto it = data_labels.find(inst.sym);
+            if (it == data_labels.end()) Fail("undefined data symbol '" + inst.sym + "'");
+            inst.imm = it->second;
+            continue;
+        }
+        auto it = text_labels.find(inst.sym);
+        if (it != text_labels.end()) {
+            inst.imm = it->second;
+        } else if (inst.op == JAL && inst.rd == 1) {
+            inst.op = CALL_LIB;
+        } else {
+            Fail("undefined label '" + inst.sym + "'");
+        }
+    }
+    stats.resize(func_names.size());
+    return true;
+}
+
+uint32_t Simulator::CheckAddr(uint32_t addr, int size) const {
+    if (addr < kDataBase || addr + size > kMemSize) Fail("memory access out of range: " + to_string(addr));
+    if (addr % size != 0) Fail("misaligned memory access: " + to_string(addr));
+    return addr;
+}
+
+int32_t Simulator::LoadWord(uint32_t addr) const {
+    int32_t v;
+    memcpy(&v, &mem[CheckAddr(addr, 4)], 4);
+    return v;
+}
+
+void Simulator::StoreWord(uint32_t addr, int32_t v) {
+    memcpy(&mem[CheckAddr(addr, 4)], &v, 4);
+}
+
+int32_t Simulator::ReadInt() {
+    int v = 0;
+    if (fscanf(input, "%d", &v) != 1) return 0;
+    return v;
+}
+
+void Simulator::CallLib(const string &name) {
+    if (name == "getint") {
+        regs[10] = ReadInt();
+    } else if (name == "getch") {
+        regs[10] = fgetc(input);
+    } else if (name == "getarray") {
+        int n = ReadInt();
+        for (int i = 0; i < n; ++i) StoreWord(regs[10] + 4 * i, ReadInt());
+        regs[10] = n;
+    } else if (name == "putint") {
+        printf("%d", regs[10]);
+    } else if (name == "putch") {
+        putchar(regs[10]);
+    } else if (name == "putarray") {
+        int n = regs[10];
+        printf("%d:", n);
+        for (int i = 0; i < n; ++i) printf(" %d", LoadWord(regs[11] + 4 * i));
+        putchar('\n');
+    } else if (name == "starttime" || name == "stoptime") {
+        //计时函数在模拟器中没有意义
+    } else {
+        Fail("call to undefined function '" + name + "'");
+    }
+}
+
+int Simulator::Run() {
+    auto it = text_labels.find("main");
+    if (it == text_labels.end()) {
+        cerr << "rvsim: no main function" << endl;
+        return 2;
+    }
+    //返回到 pc = -1 表示 main 结束
+    regs[1] = -1;
+    regs[2] = kMemSize - 16;
+    int32_t pc = it->second;
+    int last_load_rd = 0;
+    while (pc != -1) {
+        if (pc < 0 || pc >= (int32_t)text.size()) {
+            cerr << "rvsim: pc out of range: " << pc << endl;
+            return 2;
+        }
+        const Inst &inst = text[pc];
+        cur_line = inst.line;
+        FuncStats &fs = stats[func_of[pc]];
+        int32_t a = regs[inst.rs1], b = regs[inst.rs2];
+        int32_t next = pc + 1;
+        int32_t res = 0;
+        bool write = true;
+        uint64_t cycles = 1;
+        //上一条是 load，且这条指令读取了它的结果
+        if (last_load_rd != 0) {
+            bool uses = false;
+            switch (inst.op) {
+            case LI: case LA: case LUI: case JAL: case CALL_LIB: case ECALL:
+                break;
+            case SW: case SB: case BEQ: case BNE: case BLT: case BGE: case BLTU: case BGEU:
+                uses = inst.rs1 == last_load_rd || inst.rs2 == last_load_rd;
+                break;
+            case ADDI: case SLTI: case SLTIU: case XORI: case ORI: case ANDI:
+            case SLLI: case SRLI: case SRAI: case LW: case LB: case LBU: case JALR:
+                uses = inst.rs1 == last_load_rd;
+                break;
+            default:
+                uses = inst.rs1 == last_load_rd || inst.rs2 == last_load_rd;
+                break;
+            }
+            if (uses) cycles += kLoadUsePenalty;
+        }
+        last_load_rd = 0;
+        switch (inst.op) {
+        case ADD: res = (uint32_t)a + (uint32_t)b; break;
+        case SUB: res = (uint32_t)a - (uint32_t)b; break;
+        case SLL: res = (uint32_t)a << (b & 31); break;
+        case SLT: res = a < b; break;
+        case SLTU: res = (uint32_t)a < (uint32_t)b; break;
+        case XOR: res = a ^ b; break;
+        case SRL: res = (uint32_t)a >> (b & 31); break;
+        case SRA: res = a >> (b & 31); break;
+        case OR: res = a | b; break;
+        case AND: res = a & b; break;
+        case MUL: res = (uint32_t)a * (uint32_t)b; cycles += kMulPenalty; break;
+        case MULH: res = ((int64_t)a * (int64_t)b) >> 32; cycles += kMulPenalty; break;
+        case DIV:
+            cycles += kDivPenalty;
+            if (b == 0) res = -1;
+            else if (a == INT32_MIN && b == -1) res = a;
+            else res = a / b;
+            break;
+        case DIVU: cycles += kDivPenalty; res = b == 0 ? -1 : (int32_t)((uint32_t)a / (uint32_t)b); break;
+        case REM:
+            cycles += kDivPenalty;
+            if (b == 0) res = a;
+            else if (a == INT32_MIN && b == -1) res = 0;
+            else res = a % b;
+            break;
+        case REMU: cycles += kDivPenalty; res = b == 0 ? a : (int32_t)((uint32_t)a % (uint32_t)b); break;
+        case ADDI: res = (uint32_t)a + (uint32_t)inst.imm; break;
+        case SLTI: res = a < inst.imm; break;
+        case SLTIU: res = (uint32_t)a < (uint32_t)inst.imm; break;
+        case XORI: res = a ^ inst.imm; break;
+        case ORI: res = a | inst.imm; break;
+        case ANDI: res = a & inst.imm; break;
+        case SLLI: res = (uint32_t)a << (inst.imm & 31); break;
+        case SRLI: res = (uint32_t)a >> (inst.imm & 31); break;
+        case SRAI: res = a >> (inst.imm & 31); break;
+        case LW:
+            res = LoadWord(a + inst.imm);
+            ++fs.loads;
+            last_load_rd = inst.rd;
+            break;
+        case LB: case LBU: {
+            uint32_t addr = CheckAddr(a + inst.imm, 1);
+            res = inst.op == LB ? (int32_t)(int8_t)mem[addr] : (int32_t)mem[addr];
+            ++fs.loads;
+            last_load_rd = inst.rd;
+            break;
+        }
+        case SW: StoreWord(a + inst.imm, b); ++fs.stores; write = false; break;
+        case SB: mem[CheckAddr(a + inst.imm, 1)] = b & 0xff; ++fs.stores; write = false; break;
+        case LUI: res = (uint32_t)inst.imm << 12; break;
+        case LI: case LA: res = inst.imm; break;
+        case BEQ: case BNE: case BLT: case BGE: case BLTU: case BGEU: {
+            bool taken = inst.op == BEQ ? a == b
+                       : inst.op == BNE ? a != b
+                       : inst.op == BLT ? a < b
+                       : inst.op == BGE ? a >= b
+                       : inst.op == BLTU ? (uint32_t)a < (uint32_t)b
+                       : (uint32_t)a >= (uint32_t)b;
+            if (taken) {
+                next = inst.imm;
+                cycles += kTakenPenalty;
+            }
+            write = false;
+            break;
+        }
+        case JAL: res = pc + 1; next = inst.imm; cycles += kTakenPenalty; break;
+        case JALR: res = pc + 1; next = a; cycles += kTakenPenalty; break;
+        case CALL_LIB: CallLib(inst.sym); write = false; break;
+        case ECALL: Fail("ecall is not supported, call the runtime functions directly");
+        }
+        if (write && inst.rd != 0) regs[inst.rd] = res;
+        ++fs.insts;
+        fs.cycles += cycles;
+        ++total_insts;
+        pc = next;
+    }
+    fflush(stdout);
+    return regs[10] & 0xff;
+}
+
+void Simulator::PrintStats(ostream &os) const {
+    FuncStats total;
+    for (const auto &fs : stats) {
+        total.insts += fs.insts;
+        total.loads += fs.loads;
+        total.stores += fs.stores;
+        total.cycles += fs.cycles;
+    }
+    os << "==== rvsim statistics ====" << endl;
+    os << "instructions: " << total.insts << endl;
+    os << "loads: " << total.loads << endl;
+    os << "stores: " << total.stores << endl;
+    os << "cycles: " << total.cycles << endl;
+    os << "per function (insts / loads / stores / cycles):" << endl;
+    for (size_t i = 0; i < stats.size(); ++i) {
+        const auto &fs = stats[i];
+        if (fs.insts == 0) continue;
+        os << "  " << func_names[i] << ": " << fs.insts << " / " << fs.loads << " / "
+           << fs.stores << " / " << fs.cycles << endl;
+    }
+}
+
+} // namespace
+
+int main(int argc, const char *argv[]) {
+    bool print_stats = false;
+    string input_file, asm_file;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "-stats") {
+            print_stats = true;
+        } else if (arg == "-i" && i + 1 < argc) {
+            input_file = argv[++i];
+        } else if (asm_file.empty()) {
+            asm_file = arg;
+        } else {
+            cerr << "usage: rvsim [-stats] [-i input] program.s" << endl;
+            return 2;
+        }
+    }
+    if (asm_file.empty()) {
+        cerr << "usage: rvsim [-stats] [-i input] program.s" << endl;
+        return 2;
+    }
+    Simulator sim;
+    if (!sim.Load(asm_file)) {
+        cerr << "rvsim: cannot open " << asm_file << endl;
+        return 2;
+    }
+    FILE *in = nullptr;
+    if (!input_file.empty()) {
+        in = fopen(input_file.c_str(), "r");
+        if (!in) {
+            cerr << "rvsim: cannot open " << input_file << endl;
+            return 2;
+        }
+        sim.SetInput(in);
+    }
+    int ret = sim.Run();
+    if (print_stats) sim.PrintStats(cerr);
+    if (in) fclose(in);
+    return ret;
+}